@@ -0,0 +1,57 @@
+from paraview import servermanager
+import paraview.simple as smp
+
+# Make sure the test driver know that process has properly started
+print ("Process started")
+
+
+def getHost(url):
+   return url.split(':')[1][2:]
+
+
+def getPort(url):
+   return int(url.split(':')[2])
+
+def runTest():
+
+    options = servermanager.vtkRemotingCoreConfiguration.GetInstance()
+    url = options.GetServerURL()
+
+    smp.Connect(getHost(url), getPort(url))
+    session = servermanager.ActiveConnection.Session
+
+    sphere = smp.Sphere(ThetaResolution=8, PhiResolution=8)
+    wavelet = smp.Wavelet()
+    sphere.UpdatePipeline()
+    wavelet.UpdatePipeline()
+
+    # queue the requests of both sources, they are sent to the server in a
+    # single GATHER_INFORMATION_BATCH message when flushed.
+    ports = [source.SMProxy.GetOutputPort(0) for source in (sphere, wavelet)]
+    for port in ports:
+        port.RequestDataInformation()
+    assert session.HasPendingInformationRequests()
+
+    session.FlushPendingInformationRequests()
+    assert not session.HasPendingInformationRequests()
+
+    # the batched replies must be dispatched to the right ports.
+    assert ports[0].GetDataInformation().GetNumberOfPoints() == 50
+    assert ports[0].GetDataInformation().GetDataSetTypeAsString() == 'vtkPolyData'
+    assert ports[1].GetDataInformation().GetNumberOfPoints() == 9261
+    assert ports[1].GetDataInformation().GetDataSetTypeAsString() == 'vtkImageData'
+
+    # requests still pending are flushed before the state is pushed, so that
+    # they describe the data at the time they were queued.
+    sphere.ThetaResolution = 16
+    sphere.UpdatePipeline()
+    ports[0].RequestDataInformation()
+    assert session.HasPendingInformationRequests()
+    sphere.Center = [1, 0, 0]
+    assert not session.HasPendingInformationRequests()
+    assert ports[0].GetDataInformation().GetNumberOfPoints() == 98
+
+    smp.Disconnect()
+
+
+runTest()
@@ -0,0 +1,78 @@
+from paraview import servermanager
+import paraview.simple as smp
+from paraview.modules.vtkRemotingServerManager import vtkSMStateLoader
+
+# Make sure the test driver know that process has properly started
+print ("Process started")
+
+
+def getHost(url):
+   return url.split(':')[1][2:]
+
+
+def getPort(url):
+   return int(url.split(':')[2])
+
+def buildPipeline():
+    sphere = smp.Sphere(ThetaResolution=16, PhiResolution=12)
+    shrink = smp.Shrink(Input=sphere, ShrinkFactor=0.3)
+    clip = smp.Clip(Input=shrink)
+    view = smp.CreateRenderView()
+    smp.Show(shrink, view)
+    smp.ColorBy(smp.Show(clip, view), ('POINTS', 'Normals', 'Magnitude'))
+    smp.Render(view)
+
+def summarize():
+    """Describes the sources, representations and views of the session."""
+    summary = {}
+    for (name, _), source in smp.GetSources().items():
+        source.UpdatePipeline()
+        info = source.GetDataInformation()
+        summary[name] = (info.GetNumberOfPoints(), info.GetNumberOfCells())
+    for (name, _), view in smp.GetViews().items():
+        summary[name] = (len(view.Representations), tuple(view.ViewSize))
+    for (name, _), rep in smp.GetRepresentations().items():
+        summary[name] = (rep.Visibility, rep.Representation, tuple(rep.ColorArrayName))
+    return summary
+
+def loadState(state, batch):
+    """Loads the state in a new session and returns its summary, along with
+    the number of messages batched while loading."""
+    smp.ResetSession()
+    session = servermanager.ActiveConnection.Session
+    batchedMessages = session.GetNumberOfBatchedMessages()
+    batches = session.GetNumberOfMessageBatches()
+
+    loader = vtkSMStateLoader()
+    loader.SetSessionProxyManager(session.GetSessionProxyManager())
+    loader.SetBatchMessages(batch)
+    session.GetSessionProxyManager().LoadXMLState(state, loader)
+
+    batchedMessages = session.GetNumberOfBatchedMessages() - batchedMessages
+    batches = session.GetNumberOfMessageBatches() - batches
+    return summarize(), batchedMessages, batches
+
+def runTest():
+
+    options = servermanager.vtkRemotingCoreConfiguration.GetInstance()
+    url = options.GetServerURL()
+
+    smp.Connect(getHost(url), getPort(url))
+
+    buildPipeline()
+    expected = summarize()
+    state = servermanager.ActiveConnection.Session.GetSessionProxyManager().SaveXMLState()
+
+    unbatched, unbatchedMessages, unbatchedBatches = loadState(state, False)
+    batched, batchedMessages, batches = loadState(state, True)
+    print("Loading the state batched %d messages in %d messages" % (batchedMessages, batches))
+
+    assert unbatchedMessages == 0 and unbatchedBatches == 0
+    assert batchedMessages > batches > 0
+    assert unbatched == expected, "%s != %s" % (unbatched, expected)
+    assert batched == expected, "%s != %s" % (batched, expected)
+
+    smp.Disconnect()
+
+
+runTest()
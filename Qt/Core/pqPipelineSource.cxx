@@ -13,6 +13,7 @@
 #include "vtkPVDataInformation.h"
 #include "vtkPVXMLElement.h"
 #include "vtkProcessModule.h"
+#include "vtkSMOutputPort.h"
 #include "vtkSMPropertyHelper.h"
 #include "vtkSMPropertyIterator.h"
 #include "vtkSMPropertyLink.h"
@@ -26,6 +27,7 @@
 // Qt
 #include <QList>
 #include <QMap>
+#include <QTimer>
 #include <QtDebug>
 
 // ParaView
@@ -50,6 +52,9 @@ public:
   QList<vtkSmartPointer<vtkSMPropertyLink>> Links;
   QList<vtkSmartPointer<vtkSMProxy>> ProxyListDomainProxies;
 
+  // Set while the dataUpdated() signal is deferred to the next event loop turn.
+  bool DataUpdatedPending = false;
+
   pqPipelineSourceInternal(QString name, vtkSMProxy* proxy)
   {
     this->Name = name;
@@ -129,7 +134,43 @@ void pqPipelineSource::updatePipeline()
 //-----------------------------------------------------------------------------
 void pqPipelineSource::dataUpdated()
 {
-  Q_EMIT this->dataUpdated(this);
+  // Request the data information of all ports now so that the requests made
+  // for all the sources updated during this event loop turn are sent to the
+  // server together instead of one blocking round trip each.
+  Q_FOREACH (pqOutputPort* port, this->Internal->OutputPorts)
+  {
+    port->getOutputPortProxy()->RequestDataInformation();
+  }
+
+  if (this->Internal->DataUpdatedPending)
+  {
+    // already notifying on the next event loop turn.
+    return;
+  }
+
+  pqServer* server = this->getServer();
+  vtkSMSession* session = server ? server->session() : nullptr;
+  if (!session || !session->HasPendingInformationRequests())
+  {
+    // the information is already available, e.g. in built-in mode.
+    Q_EMIT this->dataUpdated(this);
+    return;
+  }
+
+  // Observers of dataUpdated() typically access the data information, hence
+  // notify them on the next event loop turn, once all the requests queued
+  // meanwhile have been flushed together.
+  this->Internal->DataUpdatedPending = true;
+  QTimer::singleShot(0, this,
+    [this]()
+    {
+      this->Internal->DataUpdatedPending = false;
+      if (pqServer* pendingServer = this->getServer())
+      {
+        pendingServer->session()->FlushPendingInformationRequests();
+      }
+      Q_EMIT this->dataUpdated(this);
+    });
 }
 
 //-----------------------------------------------------------------------------
@@ -164,8 +164,11 @@ Q_SIGNALS:
   void visibilityChanged(pqPipelineSource* source, pqDataRepresentation* repr);
 
   /**
-   * Fired right after the underlying algorithm updates (executes).
+   * Fired after the underlying algorithm updates (executes).
    * This can be used to update data information and other similar tasks.
+   * When connected to a remote server, the signal is fired on the next turn of
+   * the event loop, once the data information requested for all the sources
+   * updated meanwhile has been received in a single round trip.
    */
   void dataUpdated(pqPipelineSource* source);
 
@@ -121,6 +121,10 @@ pqServer::pqServer(vtkIdType connectionID, QObject* _parent)
   this->Internals->VTKConnect->Connect(this->Session, vtkPVSessionBase::ConnectionLost, this,
     SLOT(onConnectionLost(vtkObject*, ulong, void*, void*)));
 
+  // Batch asynchronous information requests made during an event loop turn.
+  this->Internals->VTKConnect->Connect(this->Session,
+    vtkSMSession::PendingInformationRequestsEvent, this, SLOT(onPendingInformationRequests()));
+
   // In case of Multi-clients connection, the client has to listen
   // server notification so collaboration could happen
   if (this->session()->IsMultiClients())
@@ -498,6 +502,17 @@ void pqServer::onConnectionLost(vtkObject*, unsigned long, void*, void*)
 {
   Q_EMIT serverSideDisconnected();
 }
+
+//-----------------------------------------------------------------------------
+void pqServer::onPendingInformationRequests()
+{
+  QTimer::singleShot(0, this, [this]() {
+    if (this->Session)
+    {
+      this->Session->FlushPendingInformationRequests();
+    }
+  });
+}
 //-----------------------------------------------------------------------------
 void pqServer::sendToOtherClients(vtkSMMessage* msg)
 {
@@ -250,6 +250,13 @@ protected Q_SLOTS:
    */
   void onConnectionLost(vtkObject*, unsigned long, void*, void*);
 
+  /**
+   * Called by vtkSMSession when information requests are queued. The requests
+   * are flushed on the next turn of the event loop so that all the requests
+   * queued meanwhile reach the server in a single round trip.
+   */
+  void onPendingInformationRequests();
+
 private:
   Q_DISABLE_COPY(pqServer)
 
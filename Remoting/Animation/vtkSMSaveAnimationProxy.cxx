@@ -12,6 +12,7 @@
 #include "vtkObjectFactory.h"
 #include "vtkPVProgressHandler.h"
 #include "vtkPVXMLElement.h"
+#include "vtkProcessModule.h"
 #include "vtkRemoteWriterHelper.h"
 #include "vtkRenderWindow.h"
 #include "vtkSMAnimationScene.h"
@@ -28,6 +29,7 @@
 
 #include <algorithm>
 #include <sstream>
+#include <vector>
 #include <vtksys/SystemTools.hxx>
 
 namespace vtkSMSaveAnimationProxyNS
@@ -62,10 +64,11 @@ public:
   void SetHelper(vtkSMSaveAnimationProxy* helper) { this->Helper = helper; }
 
   /**
-   * Get the vtkRemoteWriterHelper proxy.
+   * Get the vtkRemoteWriterHelper proxy. When `background` is true, the frames
+   * are encoded and written in the background while the next ones render.
    */
   vtkSmartPointer<vtkSMSourceProxy> GetRemoteWriterHelper(
-    vtkSMProxy* formatProxy, vtkTypeUInt32 location)
+    vtkSMProxy* formatProxy, vtkTypeUInt32 location, bool background)
   {
     assert(formatProxy);
     const auto pxm = formatProxy->GetSessionProxyManager();
@@ -73,7 +76,7 @@ public:
       vtkSMSourceProxy::SafeDownCast(pxm->NewProxy("misc", "RemoteWriterHelper")));
     vtkSMPropertyHelper(remoteWriter, "Writer").Set(formatProxy);
     vtkSMPropertyHelper(remoteWriter, "OutputDestination").Set(static_cast<int>(location));
-    vtkSMPropertyHelper(remoteWriter, "TryWritingInBackground").Set(0);
+    vtkSMPropertyHelper(remoteWriter, "TryWritingInBackground").Set(background ? 1 : 0);
     remoteWriter->UpdateVTKObjects();
     return remoteWriter;
   }
@@ -83,6 +86,7 @@ protected:
   ~SceneImageWriter() override = default;
   bool SaveInitialize(int vtkNotUsed(startCount)) override
   {
+    this->PendingFramesFailed = false;
     // Animation scene call render on each tick. We override that render call
     // since it's a waste of rendering, the code to save the images will call
     // render regardless.
@@ -111,11 +115,28 @@ protected:
   bool SaveFinalize() override
   {
     this->AnimationScene->SetOverrideStillRender(false);
-    return true;
+    return !this->PendingFramesFailed;
   }
 
   virtual bool WriteFrameImage(double time, vtkImageData* dataLeft, vtkImageData* dataRight) = 0;
 
+  /**
+   * Wait until at most `maxPending` frames written in the background by the
+   * format proxy of `remoteWriterHelper` are left. Failures are reported by
+   * vtkRemoteWriterHelper and make `SaveFinalize` return false.
+   */
+  void WaitForPendingFrames(vtkSMSourceProxy* remoteWriterHelper, int maxPending = 0)
+  {
+    auto helper = vtkRemoteWriterHelper::SafeDownCast(remoteWriterHelper->GetClientSideObject());
+    if (helper && !vtkRemoteWriterHelper::Wait(helper->GetWriter(), maxPending))
+    {
+      this->PendingFramesFailed = true;
+    }
+  }
+
+  int MaximumPendingFrames = 0;
+  bool PendingFramesFailed = false;
+
   std::string GetStereoFileName(const std::string& filename, bool left)
   {
     return Friendship::GetStereoFileName(this->Helper, filename, left);
@@ -135,11 +156,17 @@ public:
   vtkTypeMacro(SceneImageWriterMovie, SceneImageWriter);
 
   /**
-   * Set format proxy
+   * Set format proxy. When frames are written on the client, up to
+   * `maximumPendingFrames` frames are encoded in the background, in order,
+   * while the next ones are rendered.
    */
-  void SetFormatProxy(int index, vtkSMProxy* formatProxy, vtkTypeUInt32 location)
+  void SetFormatProxy(
+    int index, vtkSMProxy* formatProxy, vtkTypeUInt32 location, int maximumPendingFrames)
   {
-    this->RemoteWriterHelpers[index] = this->GetRemoteWriterHelper(formatProxy, location);
+    this->MaximumPendingFrames =
+      location == vtkPVSession::CLIENT ? std::max(maximumPendingFrames, 0) : 0;
+    this->RemoteWriterHelpers[index] =
+      this->GetRemoteWriterHelper(formatProxy, location, this->MaximumPendingFrames > 0);
   }
 
 protected:
@@ -186,6 +213,10 @@ protected:
       if (auto remoteWriterHelper = this->RemoteWriterHelpers[cc])
       {
         assert(data[cc] != nullptr);
+        if (this->MaximumPendingFrames > 0)
+        {
+          this->WaitForPendingFrames(remoteWriterHelper, this->MaximumPendingFrames - 1);
+        }
         auto remoteWriterAlgorithm =
           vtkAlgorithm::SafeDownCast(remoteWriterHelper->GetClientSideObject());
         remoteWriterAlgorithm->SetInputDataObject(data[cc]);
@@ -205,7 +236,7 @@ protected:
       }
     }
     this->Started = true;
-    return status;
+    return status && !this->PendingFramesFailed;
   }
 
   bool SaveFinalize() override
@@ -216,6 +247,8 @@ protected:
       {
         if (auto remoteWriterHelper = this->RemoteWriterHelpers[cc])
         {
+          // the stream can only be closed once all frames have been encoded.
+          this->WaitForPendingFrames(remoteWriterHelper);
           vtkSMPropertyHelper(remoteWriterHelper, "State").Set(vtkRemoteWriterHelper::END);
           remoteWriterHelper->UpdateVTKObjects();
           remoteWriterHelper->UpdatePipeline();
@@ -235,7 +268,8 @@ vtkStandardNewMacro(SceneImageWriterMovie);
 
 class SceneImageWriterImageSeries : public SceneImageWriter
 {
-  vtkSmartPointer<vtkSMSourceProxy> RemoteWriterHelper = nullptr;
+  std::vector<vtkSmartPointer<vtkSMSourceProxy>> RemoteWriterHelpers;
+  size_t NextRemoteWriterHelper = 0;
 
 public:
   static SceneImageWriterImageSeries* New();
@@ -260,11 +294,31 @@ public:
   vtkGetStringMacro(SuffixFormat);
 
   /**
-   * Set format proxy
+   * Set format proxy. When frames are written on the client, up to
+   * `maximumPendingFrames` images are encoded and written in the background
+   * while the next frames are rendered, each using its own copy of the format
+   * proxy.
    */
-  void SetFormatProxy(vtkSMProxy* formatProxy, vtkTypeUInt32 location)
+  void SetFormatProxy(vtkSMProxy* formatProxy, vtkTypeUInt32 location, int maximumPendingFrames)
   {
-    this->RemoteWriterHelper = this->GetRemoteWriterHelper(formatProxy, location);
+    this->MaximumPendingFrames =
+      location == vtkPVSession::CLIENT ? std::max(maximumPendingFrames, 0) : 0;
+    const bool background = this->MaximumPendingFrames > 0;
+    this->RemoteWriterHelpers.clear();
+    this->NextRemoteWriterHelper = 0;
+    this->RemoteWriterHelpers.push_back(
+      this->GetRemoteWriterHelper(formatProxy, location, background));
+
+    const auto pxm = formatProxy->GetSessionProxyManager();
+    for (int cc = 1; cc < this->MaximumPendingFrames; ++cc)
+    {
+      auto copy = vtkSmartPointer<vtkSMProxy>::Take(
+        pxm->NewProxy(formatProxy->GetXMLGroup(), formatProxy->GetXMLName()));
+      copy->SetLocation(formatProxy->GetLocation());
+      copy->Copy(formatProxy);
+      copy->UpdateVTKObjects();
+      this->RemoteWriterHelpers.push_back(this->GetRemoteWriterHelper(copy, location, background));
+    }
   }
 
 protected:
@@ -289,13 +343,8 @@ protected:
     double vtkNotUsed(time), vtkImageData* dataLeft, vtkImageData* dataRight) override
   {
     bool success = true;
-
-    const auto remoteWriterHelper = this->RemoteWriterHelper;
-    auto remoteWriterAlgorithm =
-      vtkAlgorithm::SafeDownCast(remoteWriterHelper->GetClientSideObject());
     assert(dataLeft);
     assert(this->SuffixFormat);
-    assert(remoteWriterAlgorithm);
 
     char buffer[1024];
     VTK_FORMAT_IF_ERROR_RETURN(
@@ -308,45 +357,50 @@ protected:
     const std::string filename = str.str();
     if (dataRight)
     {
-      // write right image.
-      const auto rFormat = vtkSMPropertyHelper(remoteWriterHelper, "Writer").GetAsProxy();
-      vtkSMPropertyHelper(rFormat, "FileName")
-        .Set(this->GetStereoFileName(filename, /*left=*/false).c_str());
-      rFormat->UpdateVTKObjects();
-      remoteWriterAlgorithm->SetInputDataObject(dataRight);
-      vtkSMPropertyHelper(remoteWriterHelper, "State").Set(vtkRemoteWriterHelper::WRITE);
-      remoteWriterHelper->UpdateVTKObjects();
-      remoteWriterHelper->UpdatePipeline();
-      success &= (remoteWriterAlgorithm->GetErrorCode() == vtkErrorCode::NoError);
-
-      // write left image.
-      const auto lFormat = vtkSMPropertyHelper(remoteWriterHelper, "Writer").GetAsProxy();
-      vtkSMPropertyHelper(lFormat, "FileName")
-        .Set(this->GetStereoFileName(filename, /*left=*/true).c_str());
-      lFormat->UpdateVTKObjects();
-      remoteWriterAlgorithm->SetInputDataObject(dataLeft);
-      vtkSMPropertyHelper(remoteWriterHelper, "State").Set(vtkRemoteWriterHelper::WRITE);
-      remoteWriterHelper->UpdateVTKObjects();
-      remoteWriterHelper->UpdatePipeline();
-      success &= (remoteWriterAlgorithm->GetErrorCode() == vtkErrorCode::NoError);
+      success &= this->WriteImage(this->GetStereoFileName(filename, /*left=*/false), dataRight);
+      success &= this->WriteImage(this->GetStereoFileName(filename, /*left=*/true), dataLeft);
     }
     else
     {
-      // write left image.
-      const auto lFormat = vtkSMPropertyHelper(remoteWriterHelper, "Writer").GetAsProxy();
-      vtkSMPropertyHelper(lFormat, "FileName").Set(filename.c_str());
-      lFormat->UpdateVTKObjects();
-      remoteWriterAlgorithm->SetInputDataObject(dataLeft);
-      vtkSMPropertyHelper(remoteWriterHelper, "State").Set(vtkRemoteWriterHelper::WRITE);
-      remoteWriterHelper->UpdateVTKObjects();
-      remoteWriterHelper->UpdatePipeline();
-      success &= (remoteWriterAlgorithm->GetErrorCode() == vtkErrorCode::NoError);
+      success &= this->WriteImage(filename, dataLeft);
     }
-    remoteWriterAlgorithm->SetInputDataObject(nullptr);
 
-    success &= remoteWriterAlgorithm->GetErrorCode() == vtkErrorCode::NoError;
     this->Counter += success ? this->Stride : 0;
-    return success;
+    return success && !this->PendingFramesFailed;
+  }
+
+  /**
+   * Write an image using the next vtkRemoteWriterHelper proxy, once the image
+   * its format proxy may still be writing in the background is written.
+   */
+  bool WriteImage(const std::string& filename, vtkImageData* data)
+  {
+    const auto remoteWriterHelper = this->RemoteWriterHelpers[this->NextRemoteWriterHelper];
+    this->NextRemoteWriterHelper =
+      (this->NextRemoteWriterHelper + 1) % this->RemoteWriterHelpers.size();
+    auto remoteWriterAlgorithm =
+      vtkAlgorithm::SafeDownCast(remoteWriterHelper->GetClientSideObject());
+    assert(remoteWriterAlgorithm);
+    this->WaitForPendingFrames(remoteWriterHelper);
+
+    const auto format = vtkSMPropertyHelper(remoteWriterHelper, "Writer").GetAsProxy();
+    vtkSMPropertyHelper(format, "FileName").Set(filename.c_str());
+    format->UpdateVTKObjects();
+    remoteWriterAlgorithm->SetInputDataObject(data);
+    vtkSMPropertyHelper(remoteWriterHelper, "State").Set(vtkRemoteWriterHelper::WRITE);
+    remoteWriterHelper->UpdateVTKObjects();
+    remoteWriterHelper->UpdatePipeline();
+    remoteWriterAlgorithm->SetInputDataObject(nullptr);
+    return remoteWriterAlgorithm->GetErrorCode() == vtkErrorCode::NoError;
+  }
+
+  bool SaveFinalize() override
+  {
+    for (const auto& remoteWriterHelper : this->RemoteWriterHelpers)
+    {
+      this->WaitForPendingFrames(remoteWriterHelper);
+    }
+    return this->Superclass::SaveFinalize();
   }
 
 private:
@@ -488,13 +542,29 @@ bool vtkSMSaveAnimationProxy::WriteAnimationInternal(const char* filename, vtkTy
     return false;
   }
 
+  // When the ranks are split into independent groups, each group saves a
+  // disjoint subset of the frames of an image series. Movies are a single
+  // stream, and the frames of play modes other than sequence and snap to
+  // timesteps are not known in advance, hence they are saved by the first
+  // group alone.
+  vtkSMProxy* sceneProxy = this->GetAnimationScene();
+  const int playMode = sceneProxy ? vtkSMPropertyHelper(sceneProxy, "PlayMode").GetAsInt() : -1;
+  const int numberOfRankGroups = vtkProcessModule::GetNumberOfRankGroups();
+  const int rankGroupId = vtkProcessModule::GetRankGroupId();
+  const bool splitFrames = numberOfRankGroups > 1 &&
+    vtkImageWriter::SafeDownCast(formatProxy->GetClientSideObject()) &&
+    (playMode == vtkCompositeAnimationPlayer::SEQUENCE ||
+      playMode == vtkCompositeAnimationPlayer::SNAP_TO_TIMESTEPS);
+  if (numberOfRankGroups > 1 && rankGroupId != 0 && !splitFrames)
+  {
+    return true;
+  }
+
   if (!this->Prepare())
   {
     return false;
   }
 
-  vtkSMProxy* sceneProxy = this->GetAnimationScene();
-
   // ideally, frame rate is directly set on the format proxy, but due to odd
   // interactions between frame rate and window, we need frame rate on `this`.
   // until we get around to cleaning that, I am letting this be.
@@ -505,22 +575,37 @@ bool vtkSMSaveAnimationProxy::WriteAnimationInternal(const char* filename, vtkTy
   // check if we're writing 2-stereo video streams at the same time.
   vtkSmartPointer<vtkSMProxy> otherFormatProxy;
 
+  // number of frames encoded and written in the background while the next
+  // ones are rendered.
+  const int maximumPendingFrames =
+    vtkSMPropertyHelper(this, "MaximumPendingFrames", /*quiet*/ true).GetAsInt();
+
+  int frameStride = vtkSMPropertyHelper(this, "FrameStride").GetAsInt();
+  int frameOffset = 0;
+
   // based on the format, we create an appropriate SceneImageWriter.
   vtkSmartPointer<vtkSMAnimationSceneWriter> writer;
   auto formatObj = formatProxy->GetClientSideObject();
   if (vtkImageWriter::SafeDownCast(formatObj))
   {
+    if (splitFrames)
+    {
+      // frames are assigned round-robin to the groups of ranks.
+      frameOffset = rankGroupId * frameStride;
+      frameStride *= numberOfRankGroups;
+    }
+
     vtkNew<vtkSMSaveAnimationProxyNS::SceneImageWriterImageSeries> realWriter;
     realWriter->SetSuffixFormat(vtkSMPropertyHelper(formatProxy, "SuffixFormat").GetAsString());
     realWriter->SetHelper(this);
-    realWriter->SetFormatProxy(formatProxy, location);
+    realWriter->SetFormatProxy(formatProxy, location, maximumPendingFrames);
     writer = realWriter;
   }
   else if (vtkGenericMovieWriter::SafeDownCast(formatObj))
   {
     vtkNew<vtkSMSaveAnimationProxyNS::SceneImageWriterMovie> realWriter;
     realWriter->SetHelper(this);
-    realWriter->SetFormatProxy(0, formatProxy, location);
+    realWriter->SetFormatProxy(0, formatProxy, location, maximumPendingFrames);
 
     // we need two movie writers when writing stereo videos
     if (vtkSMPropertyHelper(this, "StereoMode").GetAsInt() == VTK_STEREO_EMULATE)
@@ -532,7 +617,7 @@ bool vtkSMSaveAnimationProxy::WriteAnimationInternal(const char* filename, vtkTy
       otherFormatProxy->Copy(formatProxy);
       otherFormatProxy->UpdateVTKObjects();
 
-      realWriter->SetFormatProxy(1, otherFormatProxy, location);
+      realWriter->SetFormatProxy(1, otherFormatProxy, location, maximumPendingFrames);
     }
     writer = realWriter;
   }
@@ -547,7 +632,7 @@ bool vtkSMSaveAnimationProxy::WriteAnimationInternal(const char* filename, vtkTy
 
   writer->SetAnimationScene(sceneProxy);
   writer->SetFileName(filename);
-  writer->SetStride(vtkSMPropertyHelper(this, "FrameStride").GetAsInt());
+  writer->SetStride(frameStride);
 
   // Convert frame window to PlaybackTimeWindow; FrameWindow is an integral
   // value indicating the frame number of timestep; PlaybackTimeWindow is double
@@ -562,7 +647,7 @@ bool vtkSMSaveAnimationProxy::WriteAnimationInternal(const char* filename, vtkTy
       const int numFrames = vtkSMPropertyHelper(sceneProxy, "NumberOfFrames").GetAsInt();
       const double startTime = vtkSMPropertyHelper(sceneProxy, "StartTime").GetAsDouble();
       const double endTime = vtkSMPropertyHelper(sceneProxy, "EndTime").GetAsDouble();
-      frameWindow[0] = std::max(frameWindow[0], 0);
+      frameWindow[0] = std::max(frameWindow[0], 0) + frameOffset;
       frameWindow[1] = std::min(frameWindow[1], numFrames - 1);
       const int denominator = std::max(numFrames - 1, 1);
       playbackTimeWindow[0] = startTime + ((endTime - startTime) * frameWindow[0]) / denominator;
@@ -574,13 +659,23 @@ bool vtkSMSaveAnimationProxy::WriteAnimationInternal(const char* filename, vtkTy
       vtkSMProxy* timeKeeper = vtkSMPropertyHelper(sceneProxy, "TimeKeeper").GetAsProxy();
       const vtkSMPropertyHelper tsValuesHelper(timeKeeper, "TimestepValues");
       const int numTS = tsValuesHelper.GetNumberOfElements();
-      frameWindow[0] = std::max(frameWindow[0], 0);
+      frameWindow[0] = std::max(frameWindow[0], 0) + frameOffset;
       frameWindow[1] = std::min(frameWindow[1], numTS - 1);
+      if (frameOffset > 0 && frameWindow[0] > frameWindow[1])
+      {
+        break;
+      }
       playbackTimeWindow[0] = tsValuesHelper.GetAsDouble(frameWindow[0]);
       playbackTimeWindow[1] = tsValuesHelper.GetAsDouble(frameWindow[1]);
       break;
     }
   }
+  if (frameOffset > 0 && frameWindow[0] > frameWindow[1])
+  {
+    // no frame left for this group of ranks.
+    this->Cleanup();
+    return true;
+  }
   writer->SetStartFileCount(frameWindow[0]);
   writer->SetPlaybackTimeWindow(playbackTimeWindow);
 
@@ -0,0 +1,63 @@
+from paraview.simple import *
+from paraview import smtesting
+import glob
+import os.path
+
+# Run with `--rank-groups=2`: each group of ranks runs this script and saves
+# in its own directory.
+smtesting.ProcessCommandLineArguments()
+
+tempdir = smtesting.GetUniqueTempDirectory("RankGroupsSaveAnimation-")
+print("Generating output files in `%s`" % tempdir)
+
+pm = servermanager.vtkProcessModule
+numberOfGroups = pm.GetNumberOfRankGroups()
+groupId = pm.GetRankGroupId()
+if numberOfGroups != 2:
+    raise RuntimeError("Expected 2 groups of ranks, got %d" % numberOfGroups)
+
+NumberOfFrames = 7
+
+renderView1 = CreateView('RenderView')
+renderView1.ViewSize = [200, 200]
+
+sphere = Sphere()
+Show(sphere, renderView1)
+
+endTheta = GetAnimationTrack('EndTheta', proxy=sphere)
+endTheta.KeyFrames = [CompositeKeyFrame(KeyTime=0.0, KeyValues=[60.0]),
+                      CompositeKeyFrame(KeyTime=1.0, KeyValues=[360.0])]
+
+animationScene1 = GetAnimationScene()
+animationScene1.PlayMode = 'Sequence'
+animationScene1.NumberOfFrames = NumberOfFrames
+
+def ListFiles(pattern):
+    return sorted(os.path.basename(f) for f in glob.glob(os.path.join(tempdir, pattern)))
+
+def CheckFiles(pattern, expected):
+    files = ListFiles(pattern)
+    if files != expected:
+        raise RuntimeError("Group %d saved %s, expected %s" % (groupId, files, expected))
+
+# the groups save disjoint, round-robin subsets of the frames, numbered as in a
+# regular run.
+SaveAnimation(os.path.join(tempdir, "Frames.png"), renderView1, ImageResolution=[200, 200])
+CheckFiles("Frames.*.png",
+           ["Frames.%04d.png" % f for f in range(groupId, NumberOfFrames, numberOfGroups)])
+
+# a regular run saves frames 1, 3 and 5 of this window.
+SaveAnimation(os.path.join(tempdir, "Window.png"), renderView1, ImageResolution=[200, 200],
+              FrameWindow=[1, NumberOfFrames - 1], FrameStride=2)
+CheckFiles("Window.*.png", ["Window.%04d.png" % f
+                            for f in range(1 + 2 * groupId, NumberOfFrames, 2 * numberOfGroups)])
+
+# movies, screenshots and data are saved by the first group alone.
+SaveAnimation(os.path.join(tempdir, "Movie.ogv"), renderView1, ImageResolution=[200, 200])
+SaveScreenshot(os.path.join(tempdir, "Screenshot.png"), renderView1, ImageResolution=[200, 200])
+servermanager.vtkRemoteWriterHelper.Wait()
+SaveData(os.path.join(tempdir, "Sphere.csv"), sphere)
+CheckFiles("Movie*.ogv", ["Movie.ogv"] if groupId == 0 else [])
+CheckFiles("Screenshot*.png", ["Screenshot.png"] if groupId == 0 else [])
+if bool(ListFiles("Sphere*.csv")) != (groupId == 0):
+    raise RuntimeError("Group %d saved %s" % (groupId, ListFiles("Sphere*.csv")))
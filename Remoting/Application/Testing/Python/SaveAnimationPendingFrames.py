@@ -0,0 +1,57 @@
+from __future__ import print_function
+from paraview.simple import *
+from paraview import smtesting
+import os.path
+
+# Saves the same animation with frames written before the next one renders, and
+# with frames written in the background, and checks both give the same files.
+
+smtesting.ProcessCommandLineArguments()
+
+tempdir = smtesting.GetUniqueTempDirectory("SaveAnimationPendingFrames-")
+print("Generating output files in `%s`" % tempdir)
+
+NumberOfFrames = 5
+
+def CompareImages(imageName, baselineName):
+    from paraview.vtk.vtkTestingRendering import vtkTesting
+    testing = vtkTesting()
+    testing.AddArgument("-T")
+    testing.AddArgument(tempdir)
+    testing.AddArgument("-V")
+    testing.AddArgument(os.path.join(tempdir, baselineName))
+    return testing.RegressionTest(os.path.join(tempdir, imageName), 0.05) == vtkTesting.PASSED
+
+renderView1 = CreateView('RenderView')
+renderView1.ViewSize = [300, 300]
+
+sphere = Sphere()
+Show(sphere, renderView1)
+
+# grow the sphere over the frames, so that frames written out of order are caught.
+endTheta = GetAnimationTrack('EndTheta', proxy=sphere)
+endTheta.KeyFrames = [CompositeKeyFrame(KeyTime=0.0, KeyValues=[60.0]),
+                      CompositeKeyFrame(KeyTime=1.0, KeyValues=[360.0])]
+
+animationScene1 = GetAnimationScene()
+animationScene1.PlayMode = 'Sequence'
+animationScene1.NumberOfFrames = NumberOfFrames
+
+for pending in (0, 3):
+    for name, options in (("Frames", {}), ("Stereo", {"StereoMode": "Both Eyes"})):
+        for extension in (".png", ".ogv"):
+            filename = os.path.join(tempdir, "%s%d%s" % (name, pending, extension))
+            if not SaveAnimation(filename, renderView1, ImageResolution=[300, 300],
+                                 MaximumPendingFrames=pending, **options):
+                raise RuntimeError("Failed to save '%s'" % filename)
+
+# all files are written by the time SaveAnimation returns.
+for frame in range(NumberOfFrames):
+    for image in ("Frames%d.%04d.png", "Stereo%d.%04d_left.png", "Stereo%d.%04d_right.png"):
+        if not CompareImages(image % (3, frame), image % (0, frame)):
+            raise RuntimeError("Frame %d differs when written in the background" % frame)
+
+for movie in ("Frames3.ogv", "Stereo3_left.ogv", "Stereo3_right.ogv"):
+    path = os.path.join(tempdir, movie)
+    if not os.path.exists(path) or os.path.getsize(path) == 0:
+        raise RuntimeError("Missing video file '%s'" % movie)
@@ -7,6 +7,8 @@
 #include "vtkVariantArray.h"
 
 #include <iostream>
+#include <utility>
+#include <vector>
 
 static double dblIni[] = { 904., 906., 917. };
 static const char* strIni[] = { "901", "Turbo", "Targa" };
@@ -320,6 +322,23 @@ static bool do_test()
       return false;
     }
   }
+  vtkClientServerStream css6;
+  {
+    const unsigned char* data;
+    size_t length;
+    css5.GetData(&data, &length);
+    std::vector<unsigned char> buffer(data, data + length);
+    if (!css6.SetData(std::move(buffer)))
+    {
+      std::cerr << "FAILED: SetData from buffer failed." << endl;
+      return false;
+    }
+    if (!buffer.empty())
+    {
+      std::cerr << "FAILED: SetData did not take ownership of the buffer." << endl;
+      return false;
+    }
+  }
 
   if (!do_check(css1))
   {
@@ -346,6 +365,11 @@ static bool do_test()
     std::cerr << "FAILED: (Get/Set)Data did not copy stream properly." << endl;
     return false;
   }
+  if (!do_check(css6))
+  {
+    std::cerr << "FAILED: SetData did not move buffer into stream properly." << endl;
+    return false;
+  }
   return true;
 }
 
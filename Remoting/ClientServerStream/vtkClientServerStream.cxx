@@ -288,9 +288,11 @@ vtkClientServerStream& vtkClientServerStream::Write(const void* data, size_t len
     return *this;
   }
 
-  // Copy the value into the data.
-  this->Internal->Data.resize(this->Internal->Data.size() + length);
-  memcpy(&*(this->Internal->Data.end() - length), data, length);
+  // Append the value to the data.  Inserting the range directly avoids
+  // zero-filling the new bytes before overwriting them, which matters for
+  // large array arguments.
+  const unsigned char* bytes = static_cast<const unsigned char*>(data);
+  this->Internal->Data.insert(this->Internal->Data.end(), bytes, bytes + length);
   return *this;
 }
 
@@ -1528,6 +1530,26 @@ int vtkClientServerStream::SetData(const unsigned char* data, size_t length)
     this->Internal->Data.insert(this->Internal->Data.begin(), data, data + length);
   }
 
+  return this->ParseSetData();
+}
+
+//----------------------------------------------------------------------------
+int vtkClientServerStream::SetData(std::vector<unsigned char>&& data)
+{
+  // Reset and take ownership of the given buffer without copying it.
+  this->Reset();
+  this->Internal->Data.swap(data);
+
+  // Release whatever was left in the caller's buffer (the byte order
+  // entry written by Reset).
+  std::vector<unsigned char>().swap(data);
+
+  return this->ParseSetData();
+}
+
+//----------------------------------------------------------------------------
+int vtkClientServerStream::ParseSetData()
+{
   // Parse the stream to fill in ValueOffsets and MessageIndexes and
   // to perform byte-swapping if necessary.
   if (this->ParseData())
@@ -18,6 +18,8 @@
 #include "vtkClientServerID.h" // for vtkClientServerID
 #include "vtkVariant.h"        // for vtkVariant
 
+#include <vector> // for std::vector
+
 class vtkClientServerStreamInternals;
 
 class VTKREMOTINGCLIENTSERVERSTREAM_EXPORT vtkClientServerStream
@@ -307,6 +309,14 @@ public:
    */
   int SetData(const unsigned char* data, size_t length);
 
+  /**
+   * Construct the entire stream by taking ownership of the given buffer.
+   * This behaves like the pointer/length overload but avoids copying the
+   * data, which makes it preferable when a large message was received
+   * directly into a buffer.  The given vector is left empty.
+   */
+  int SetData(std::vector<unsigned char>&& data);
+
   //--------------------------------------------------------------------------
   // Utility methods:
 
@@ -374,6 +384,7 @@ protected:
   vtkClientServerStream& Write(const void* data, size_t length);
 
   // Data parsing utilities for SetData.
+  int ParseSetData();
   int ParseData();
   unsigned char* ParseCommand(
     int order, unsigned char* data, unsigned char* begin, unsigned char* end);
@@ -0,0 +1,122 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkDoubleArray.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPVArrayInformation.h"
+#include "vtkPVDataInformation.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+
+#include <algorithm>
+#include <iostream>
+
+namespace
+{
+vtkSmartPointer<vtkPolyData> GetPolyData(double value)
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->Update();
+
+  vtkSmartPointer<vtkPolyData> pd = sphere->GetOutput();
+  vtkNew<vtkDoubleArray> array;
+  array->SetName("values");
+  array->SetNumberOfTuples(pd->GetNumberOfPoints());
+  array->FillComponent(0, value);
+  pd->GetPointData()->AddArray(array);
+  return pd;
+}
+
+bool CheckRange(vtkDataObject* dobj, double expected[2], const char* label)
+{
+  vtkNew<vtkPVDataInformation> info;
+  info->CopyFromObject(dobj);
+  auto ainfo = info->GetArrayInformation("values", vtkDataObject::POINT);
+  if (ainfo == nullptr)
+  {
+    std::cerr << "ERROR: failed to find `values` (" << label << ")." << endl;
+    return false;
+  }
+  const double* range = ainfo->GetComponentRange(0);
+  if (range[0] != expected[0] || range[1] != expected[1])
+  {
+    std::cerr << "ERROR: incorrect range (" << label << "): got [" << range[0] << ", "
+              << range[1] << "], expected [" << expected[0] << ", " << expected[1] << "]."
+              << endl;
+    return false;
+  }
+  return true;
+}
+}
+
+extern int TestPVDataInformationCache(int, char*[])
+{
+  vtkNew<vtkMultiBlockDataSet> mb;
+  const unsigned int numBlocks = 64;
+  for (unsigned int cc = 0; cc < numBlocks; ++cc)
+  {
+    mb->SetBlock(cc, GetPolyData(cc));
+  }
+  // the same dataset may appear in multiple leaves.
+  mb->SetBlock(numBlocks, mb->GetBlock(0));
+
+  double expected[2] = { 0, numBlocks - 1.0 };
+  if (!CheckRange(mb, expected, "first gather") || !CheckRange(mb, expected, "cached gather"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // Modifying an array must invalidate the cached information for its block.
+  auto pd = vtkPolyData::SafeDownCast(mb->GetBlock(3));
+  auto array = vtkDoubleArray::SafeDownCast(pd->GetPointData()->GetArray("values"));
+  array->SetValue(0, 1000.0);
+  array->Modified();
+  expected[1] = 1000.0;
+  if (!CheckRange(mb, expected, "modified array"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // Replacing a block must not reuse information for the old one.
+  mb->SetBlock(3, GetPolyData(-5.0));
+  expected[0] = -5.0;
+  expected[1] = numBlocks - 1.0;
+  if (!CheckRange(mb, expected, "replaced block"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // Leaves sharing their points and arrays with other leaves.
+  vtkNew<vtkMultiBlockDataSet> shared;
+  for (unsigned int cc = 0; cc < numBlocks; ++cc)
+  {
+    auto pd = vtkSmartPointer<vtkPolyData>::New();
+    pd->ShallowCopy(mb->GetBlock(cc % 4));
+    shared->SetBlock(cc, pd);
+  }
+  double sharedExpected[2] = { -5.0, 2.0 };
+  if (!CheckRange(shared, sharedExpected, "shared arrays"))
+  {
+    return EXIT_FAILURE;
+  }
+  vtkNew<vtkPVDataInformation> sharedInfo;
+  sharedInfo->CopyFromObject(shared);
+  const double* bounds = sharedInfo->GetBounds();
+  const double* expectedBounds = vtkPolyData::SafeDownCast(mb->GetBlock(0))->GetBounds();
+  if (!std::equal(bounds, bounds + 6, expectedBounds))
+  {
+    std::cerr << "ERROR: incorrect bounds for shared points." << endl;
+    return EXIT_FAILURE;
+  }
+
+  // Non-composite data goes through the same cache.
+  auto single = GetPolyData(2.0);
+  double singleExpected[2] = { 2.0, 2.0 };
+  if (!CheckRange(single, singleExpected, "non-composite"))
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,160 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Benchmarks and validates the strategies used by vtkPVInformationReducer to
+// merge vtkPVDataInformation from all ranks onto the root. For each
+// power-of-two subset of ranks (and all ranks), the time taken by the root
+// gather and by tree reductions with fan-in 2 and 4 is reported.
+
+#include "vtkDoubleArray.h"
+#include "vtkLogger.h"
+#include "vtkMPIController.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPVArrayInformation.h"
+#include "vtkPVDataInformation.h"
+#include "vtkPVInformationReducer.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace
+{
+vtkSmartPointer<vtkMultiBlockDataSet> CreateData(int rank)
+{
+  vtkNew<vtkMultiBlockDataSet> mb;
+  const unsigned int numBlocks = 8;
+  for (unsigned int cc = 0; cc < numBlocks; ++cc)
+  {
+    vtkNew<vtkSphereSource> sphere;
+    sphere->Update();
+    vtkSmartPointer<vtkPolyData> pd = sphere->GetOutput();
+
+    vtkNew<vtkDoubleArray> array;
+    array->SetName("rank");
+    array->SetNumberOfTuples(pd->GetNumberOfPoints());
+    array->FillComponent(0, rank);
+    pd->GetPointData()->AddArray(array);
+
+    if (rank % 2 == 1)
+    {
+      // array only present on some ranks.
+      vtkNew<vtkDoubleArray> partial;
+      partial->SetName("odd");
+      partial->SetNumberOfTuples(pd->GetNumberOfPoints());
+      partial->FillComponent(0, rank);
+      pd->GetPointData()->AddArray(partial);
+    }
+    mb->SetBlock(cc, pd);
+  }
+  return mb;
+}
+
+bool Validate(vtkPVDataInformation* info, vtkPVDataInformation* expected, const std::string& label)
+{
+  if (info->GetNumberOfPoints() != expected->GetNumberOfPoints() ||
+    info->GetNumberOfDataSets() != expected->GetNumberOfDataSets())
+  {
+    vtkLogF(ERROR, "%s: mismatched number of points or datasets.", label.c_str());
+    return false;
+  }
+  for (const char* name : { "rank", "odd" })
+  {
+    auto ainfo = info->GetArrayInformation(name, vtkDataObject::POINT);
+    auto eainfo = expected->GetArrayInformation(name, vtkDataObject::POINT);
+    if ((ainfo == nullptr) != (eainfo == nullptr))
+    {
+      vtkLogF(ERROR, "%s: mismatched presence of array '%s'.", label.c_str(), name);
+      return false;
+    }
+    if (ainfo &&
+      (ainfo->GetComponentRange(0)[0] != eainfo->GetComponentRange(0)[0] ||
+        ainfo->GetComponentRange(0)[1] != eainfo->GetComponentRange(0)[1] ||
+        ainfo->GetIsPartial() != eainfo->GetIsPartial()))
+    {
+      vtkLogF(ERROR, "%s: mismatched range or partial flag for '%s'.", label.c_str(), name);
+      return false;
+    }
+  }
+  return true;
+}
+
+double TimeReduction(vtkMultiProcessController* controller, vtkDataObject* data, int fanIn,
+  vtkPVDataInformation* result)
+{
+  vtkNew<vtkPVInformationReducer> reducer;
+  reducer->SetController(controller);
+  reducer->SetReductionFanIn(fanIn);
+
+  const int repeats = 10;
+  controller->Barrier();
+  const auto start = std::chrono::steady_clock::now();
+  for (int cc = 0; cc < repeats; ++cc)
+  {
+    result->CopyFromObject(data);
+    reducer->Reduce(result);
+  }
+  controller->Barrier();
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  return elapsed.count() / repeats;
+}
+}
+
+extern int TestPVInformationReduction(int argc, char* argv[])
+{
+  vtkMPIController* contr = vtkMPIController::New();
+  contr->Initialize(&argc, &argv);
+  vtkMultiProcessController::SetGlobalController(contr);
+
+  const int myRank = contr->GetLocalProcessId();
+  const int numRanks = contr->GetNumberOfProcesses();
+  auto data = CreateData(myRank);
+
+  std::vector<int> groupSizes;
+  for (int size = 1; size < numRanks; size *= 2)
+  {
+    groupSizes.push_back(size);
+  }
+  groupSizes.push_back(numRanks);
+
+  int success = 1;
+  for (int groupSize : groupSizes)
+  {
+    vtkSmartPointer<vtkMultiProcessController> group;
+    group.TakeReference(contr->PartitionController(myRank < groupSize ? 0 : 1, myRank));
+    if (myRank < groupSize)
+    {
+      vtkNew<vtkPVDataInformation> gathered;
+      const double gatherTime = TimeReduction(group, data, 0, gathered);
+      for (int fanIn : { 2, 4 })
+      {
+        vtkNew<vtkPVDataInformation> reduced;
+        const double treeTime = TimeReduction(group, data, fanIn, reduced);
+        const std::string label =
+          "ranks=" + std::to_string(groupSize) + ", fan-in=" + std::to_string(fanIn);
+        if (myRank == 0)
+        {
+          vtkLogF(INFO, "%s: gather %g s, tree %g s", label.c_str(), gatherTime, treeTime);
+          if (!Validate(reduced, gathered, label))
+          {
+            success = 0;
+          }
+        }
+      }
+    }
+    contr->Barrier();
+  }
+
+  int all_success;
+  contr->AllReduce(&success, &all_success, 1, vtkCommunicator::LOGICAL_AND_OP);
+
+  vtkMultiProcessController::SetGlobalController(nullptr);
+  contr->Finalize();
+  contr->Delete();
+  return all_success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
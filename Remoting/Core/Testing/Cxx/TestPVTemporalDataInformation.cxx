@@ -0,0 +1,101 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkDataObject.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPVTemporalDataInformation.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataAlgorithm.h"
+#include "vtkSphereSource.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+
+#include <iostream>
+
+namespace
+{
+// Source producing a sphere whose number of points grows with time, counting
+// how many times it executed.
+class TemporalSphereSource : public vtkPolyDataAlgorithm
+{
+public:
+  static TemporalSphereSource* New();
+  vtkTypeMacro(TemporalSphereSource, vtkPolyDataAlgorithm);
+
+  int NumberOfExecutions = 0;
+
+protected:
+  TemporalSphereSource() { this->SetNumberOfInputPorts(0); }
+
+  int RequestInformation(
+    vtkInformation*, vtkInformationVector**, vtkInformationVector* outputVector) override
+  {
+    const double timesteps[] = { 0, 1, 2, 3, 4 };
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_STEPS(), timesteps, 5);
+    const double range[] = { 0, 4 };
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_RANGE(), range, 2);
+    return 1;
+  }
+
+  int RequestData(
+    vtkInformation*, vtkInformationVector**, vtkInformationVector* outputVector) override
+  {
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    double time = 0;
+    if (outInfo->Has(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP()))
+    {
+      time = outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP());
+    }
+
+    vtkNew<vtkSphereSource> sphere;
+    sphere->SetThetaResolution(8 + static_cast<int>(time));
+    sphere->Update();
+
+    vtkPolyData* output = vtkPolyData::GetData(outInfo);
+    output->ShallowCopy(sphere->GetOutput());
+    output->GetInformation()->Set(vtkDataObject::DATA_TIME_STEP(), time);
+    ++this->NumberOfExecutions;
+    return 1;
+  }
+};
+vtkStandardNewMacro(TemporalSphereSource);
+
+vtkIdType GatherNumberOfPoints(vtkAlgorithm* source)
+{
+  vtkNew<vtkPVTemporalDataInformation> info;
+  info->CopyFromObject(source->GetOutputPort(0));
+  return info->GetNumberOfPoints();
+}
+}
+
+extern int TestPVTemporalDataInformation(int, char*[])
+{
+  vtkNew<TemporalSphereSource> source;
+  const vtkIdType expected = GatherNumberOfPoints(source);
+  if (source->NumberOfExecutions != 5)
+  {
+    std::cerr << "ERROR: expected 5 executions, got " << source->NumberOfExecutions << "."
+              << endl;
+    return EXIT_FAILURE;
+  }
+
+  // Gathering again must reuse the information for all timesteps.
+  source->NumberOfExecutions = 0;
+  if (GatherNumberOfPoints(source) != expected || source->NumberOfExecutions > 1)
+  {
+    std::cerr << "ERROR: cached information was not reused." << endl;
+    return EXIT_FAILURE;
+  }
+
+  // Modifying the source must invalidate the cached information.
+  source->Modified();
+  source->NumberOfExecutions = 0;
+  if (GatherNumberOfPoints(source) != expected || source->NumberOfExecutions != 5)
+  {
+    std::cerr << "ERROR: cached information was not invalidated." << endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,141 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkDataObject.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkLogger.h"
+#include "vtkMultiProcessController.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPVInformationReducer.h"
+#include "vtkPVTemporalDataInformation.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataAlgorithm.h"
+#include "vtkProcessModule.h"
+#include "vtkSphereSource.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+
+#define VERIFY(x, y)                                                                               \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    vtkLogF(ERROR, y);                                                                             \
+    return false;                                                                                  \
+  }
+
+namespace
+{
+constexpr int NumberOfTimeSteps = 5;
+
+// Source producing a piece of a sphere whose number of points grows with
+// time, counting how many times it executed for the whole dataset.
+class TemporalSphereSource : public vtkPolyDataAlgorithm
+{
+public:
+  static TemporalSphereSource* New();
+  vtkTypeMacro(TemporalSphereSource, vtkPolyDataAlgorithm);
+
+  int NumberOfWholeExecutions = 0;
+
+protected:
+  TemporalSphereSource() { this->SetNumberOfInputPorts(0); }
+
+  int RequestInformation(
+    vtkInformation*, vtkInformationVector**, vtkInformationVector* outputVector) override
+  {
+    const double timesteps[NumberOfTimeSteps] = { 0, 1, 2, 3, 4 };
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_STEPS(), timesteps, NumberOfTimeSteps);
+    const double range[] = { 0, 4 };
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_RANGE(), range, 2);
+    outInfo->Set(vtkAlgorithm::CAN_HANDLE_PIECE_REQUEST(), 1);
+    return 1;
+  }
+
+  int RequestData(
+    vtkInformation*, vtkInformationVector**, vtkInformationVector* outputVector) override
+  {
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    double time = 0;
+    if (outInfo->Has(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP()))
+    {
+      time = outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP());
+    }
+    const int piece = outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER());
+    const int numberOfPieces =
+      outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES());
+
+    vtkNew<vtkSphereSource> sphere;
+    sphere->SetThetaResolution(8 + 2 * static_cast<int>(time));
+    sphere->SetCenter(time, 0, 0);
+    sphere->UpdatePiece(piece, numberOfPieces, 0);
+
+    vtkPolyData* output = vtkPolyData::GetData(outInfo);
+    output->ShallowCopy(sphere->GetOutput());
+    output->GetInformation()->Set(vtkDataObject::DATA_TIME_STEP(), time);
+    if (numberOfPieces == 1)
+    {
+      ++this->NumberOfWholeExecutions;
+    }
+    return 1;
+  }
+};
+vtkStandardNewMacro(TemporalSphereSource);
+
+bool TestDistribution(vtkMultiProcessController* controller)
+{
+  const int rank = controller->GetLocalProcessId();
+  const int numRanks = controller->GetNumberOfProcesses();
+  VERIFY(numRanks > 1, "This test expects more than one rank.");
+
+  // each rank holds its own piece of the current timestep.
+  vtkNew<TemporalSphereSource> source;
+  source->UpdatePiece(rank, numRanks, 0);
+  source->NumberOfWholeExecutions = 0;
+
+  vtkNew<vtkPVTemporalDataInformation> info;
+  info->SetDistributeTimeStepsAcrossRanks(true);
+  info->CopyFromObject(source->GetOutputPort(0));
+  VERIFY(source->NumberOfWholeExecutions <= (NumberOfTimeSteps + numRanks - 1) / numRanks,
+    "Timesteps were not split across ranks.");
+
+  vtkInformation* outInfo = source->GetOutputInformation(0);
+  VERIFY(outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER()) == rank &&
+      outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES()) == numRanks,
+    "The piece requested before was not restored.");
+
+  vtkNew<vtkPVInformationReducer> reducer;
+  reducer->SetController(controller);
+  reducer->Reduce(info);
+  if (rank != 0)
+  {
+    return true;
+  }
+
+  // the reduced information must describe the whole dataset for each
+  // timestep, as when gathered by a single process.
+  vtkNew<TemporalSphereSource> wholeSource;
+  vtkNew<vtkPVTemporalDataInformation> expected;
+  expected->CopyFromObject(wholeSource->GetOutputPort(0));
+  VERIFY(info->GetNumberOfPoints() == expected->GetNumberOfPoints() &&
+      info->GetNumberOfCells() == expected->GetNumberOfCells(),
+    "Unexpected number of points or cells.");
+  for (int cc = 0; cc < 6; ++cc)
+  {
+    VERIFY(info->GetBounds()[cc] == expected->GetBounds()[cc], "Unexpected bounds.");
+  }
+  VERIFY(info->GetTimeSteps().size() == NumberOfTimeSteps, "Unexpected timesteps.");
+  return true;
+}
+}
+
+extern int TestPVTemporalDataInformationDistributed(int argc, char* argv[])
+{
+  vtkProcessModule::Initialize(vtkProcessModule::PROCESS_BATCH, argc, argv);
+  auto controller = vtkProcessModule::GetProcessModule()->GetGlobalController();
+
+  int success = ::TestDistribution(controller) ? 1 : 0;
+  int allSuccess = 0;
+  controller->AllReduce(&success, &allSuccess, 1, vtkCommunicator::LOGICAL_AND_OP);
+  vtkProcessModule::Finalize();
+  return allSuccess ? EXIT_SUCCESS : EXIT_FAILURE;
+}
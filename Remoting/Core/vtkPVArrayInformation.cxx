@@ -600,6 +600,8 @@ void vtkPVArrayInformation::AddInformation(vtkPVArrayInformation* other, int fie
   // Fixes pv.ColorOpacityTableEditorHistogram test.
   // assert(this->DataType == other->DataType);
   this->IsGlobal = this->IsGlobal || other->IsGlobal;
+  // an array missing from some blocks of `other` is still partial once merged.
+  this->IsPartial = this->IsPartial || other->IsPartial;
   if (fieldAssociation == vtkDataObject::FIELD)
   {
     this->NumberOfTuples = std::max(this->NumberOfTuples, other->NumberOfTuples);
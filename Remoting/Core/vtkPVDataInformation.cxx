@@ -21,6 +21,7 @@
 #include "vtkExecutive.h"
 #include "vtkExplicitStructuredGrid.h"
 #include "vtkExtractBlockUsingDataAssembly.h"
+#include "vtkFieldData.h"
 #include "vtkHyperTreeGrid.h"
 #include "vtkImageData.h"
 #include "vtkInformation.h"
@@ -32,42 +33,224 @@
 #include "vtkPVInformationKeys.h"
 #include "vtkPVLogger.h"
 #include "vtkPartitionedDataSetCollection.h"
+#include "vtkPointSet.h"
+#include "vtkPoints.h"
 #include "vtkProcessModule.h"
 #include "vtkRectilinearGrid.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStructuredGrid.h"
 #include "vtkUniformGridAMR.h"
+#include "vtkWeakPointer.h"
 
 #include <algorithm>
 #include <cassert>
+#include <list>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
-class vtkPVDataInformationAccumulator
+namespace
+{
+/**
+ * Process-wide cache of the information gathered for individual leaf data
+ * objects. Entries are keyed on the data object and validated against its
+ * MTime (which includes the MTime of its attribute arrays), so repeated
+ * `GatherInformation` calls on unchanged data do not recompute array ranges,
+ * bounds, etc. The cache keeps the most recently used entries only; entries
+ * for data objects that have since been released are dropped when looked up
+ * or when they become the least recently used ones.
+ *
+ * The cache is only accessed from the thread driving
+ * `vtkPVDataInformation::CopyFromObject`.
+ */
+class vtkPVDataInformationCache
 {
-  vtkNew<vtkPVDataInformation> Current;
+  static constexpr std::size_t MaximumNumberOfEntries = 4096;
+
+  struct EntryType
+  {
+    vtkWeakPointer<vtkDataObject> DataObject;
+    vtkMTimeType MTime;
+    bool InspectCells;
+    vtkSmartPointer<vtkPVDataInformation> Information;
+    std::list<vtkDataObject*>::iterator Position;
+  };
+  std::unordered_map<vtkDataObject*, EntryType> Entries;
+  // keys of `Entries`, most recently used first.
+  std::list<vtkDataObject*> Order;
 
 public:
-  std::set<int> UniqueBlockTypes;
-  vtkPVDataInformation* operator()(vtkPVDataInformation* info, vtkDataObject* dobj)
+  static vtkPVDataInformationCache& GetInstance()
+  {
+    static vtkPVDataInformationCache instance;
+    return instance;
+  }
+
+  vtkSmartPointer<vtkPVDataInformation> Find(vtkDataObject* dobj, bool inspectCells)
+  {
+    auto iter = this->Entries.find(dobj);
+    if (iter == this->Entries.end())
+    {
+      return nullptr;
+    }
+    auto& entry = iter->second;
+    if (entry.DataObject != dobj || entry.MTime != dobj->GetMTime())
+    {
+      // the data object was released, and its address reused, or modified.
+      this->Order.erase(entry.Position);
+      this->Entries.erase(iter);
+      return nullptr;
+    }
+    this->Order.splice(this->Order.begin(), this->Order, entry.Position);
+    return entry.InspectCells == inspectCells ? entry.Information : nullptr;
+  }
+
+  void Insert(vtkDataObject* dobj, bool inspectCells, vtkPVDataInformation* info)
+  {
+    auto iter = this->Entries.find(dobj);
+    if (iter != this->Entries.end())
+    {
+      this->Order.erase(iter->second.Position);
+    }
+    this->Order.push_front(dobj);
+    this->Entries[dobj] =
+      EntryType{ dobj, dobj->GetMTime(), inspectCells, info, this->Order.begin() };
+
+    while (this->Entries.size() > MaximumNumberOfEntries)
+    {
+      this->Entries.erase(this->Order.back());
+      this->Order.pop_back();
+    }
+  }
+};
+
+/**
+ * Adds the objects of `dobj` whose lazily computed state (bounds, array
+ * ranges) is cached on the object itself rather than on `dobj`, i.e. its
+ * points and arrays, to `objects`.
+ */
+void vtkGetSharableObjects(vtkDataObject* dobj, std::vector<vtkObject*>& objects)
+{
+  if (auto ps = vtkPointSet::SafeDownCast(dobj))
+  {
+    if (auto points = ps->GetPoints())
+    {
+      objects.push_back(points);
+      objects.push_back(points->GetData());
+    }
+  }
+  else if (auto rg = vtkRectilinearGrid::SafeDownCast(dobj))
+  {
+    objects.push_back(rg->GetXCoordinates());
+    objects.push_back(rg->GetYCoordinates());
+    objects.push_back(rg->GetZCoordinates());
+  }
+  for (int type = 0; type < vtkDataObject::NUMBER_OF_ATTRIBUTE_TYPES; ++type)
   {
-    if (!dobj)
+    if (auto fd = dobj->GetAttributesAsFieldData(type))
     {
-      return info;
+      for (int cc = 0, max = fd->GetNumberOfArrays(); cc < max; ++cc)
+      {
+        objects.push_back(fd->GetAbstractArray(cc));
+      }
     }
-    assert(vtkCompositeDataSet::SafeDownCast(dobj) == nullptr);
+  }
+}
+}
 
-    this->Current->Initialize();
-    this->Current->SetInspectCells(info->InspectCells);
-    this->Current->CopyFromDataObject(dobj);
-    if (this->Current->GetDataSetType() != -1)
+class vtkPVDataInformationAccumulator
+{
+public:
+  std::set<int> UniqueBlockTypes;
+
+  /**
+   * Gathers information for each of the non-composite `leaves` and
+   * accumulates it into `info`, in order. Information for leaves that is
+   * not already cached is computed concurrently using vtkSMPTools; a data
+   * object referenced by multiple leaves is only inspected once. Leaves
+   * sharing points or arrays with other leaves are inspected on the calling
+   * thread since computing bounds and ranges updates caches on these shared
+   * objects.
+   */
+  void AddLeaves(vtkPVDataInformation* info, const std::vector<vtkDataObject*>& leaves)
+  {
+    auto& cache = vtkPVDataInformationCache::GetInstance();
+
+    std::vector<vtkSmartPointer<vtkPVDataInformation>> leafInfos(leaves.size());
+    std::vector<vtkDataObject*> missing;
+    std::vector<vtkSmartPointer<vtkPVDataInformation>> missingInfos;
+    std::unordered_map<vtkDataObject*, size_t> missingIndex;
+    for (size_t cc = 0; cc < leaves.size(); ++cc)
+    {
+      vtkDataObject* dobj = leaves[cc];
+      assert(dobj != nullptr && vtkCompositeDataSet::SafeDownCast(dobj) == nullptr);
+      leafInfos[cc] = cache.Find(dobj, info->InspectCells);
+      if (leafInfos[cc] == nullptr && missingIndex.emplace(dobj, missing.size()).second)
+      {
+        missing.push_back(dobj);
+        // allocate here rather than in the worker threads.
+        auto leafInfo = vtkSmartPointer<vtkPVDataInformation>::New();
+        leafInfo->SetInspectCells(info->InspectCells);
+        missingInfos.push_back(leafInfo);
+      }
+    }
+
+    // split the missing leaves between those that can be inspected
+    // concurrently and those sharing objects with other missing leaves.
+    std::vector<std::vector<vtkObject*>> sharableObjects(missing.size());
+    std::unordered_map<vtkObject*, int> sharableObjectCounts;
+    for (size_t cc = 0; cc < missing.size(); ++cc)
     {
-      assert(this->Current->GetCompositeDataSetType() == -1);
-      this->UniqueBlockTypes.insert(this->Current->GetDataSetType());
-      info->AddInformation(this->Current);
+      ::vtkGetSharableObjects(missing[cc], sharableObjects[cc]);
+      std::sort(sharableObjects[cc].begin(), sharableObjects[cc].end());
+      sharableObjects[cc].erase(
+        std::unique(sharableObjects[cc].begin(), sharableObjects[cc].end()),
+        sharableObjects[cc].end());
+      for (vtkObject* object : sharableObjects[cc])
+      {
+        ++sharableObjectCounts[object];
+      }
+    }
+    std::vector<vtkIdType> concurrent;
+    std::vector<vtkIdType> serial;
+    for (size_t cc = 0; cc < missing.size(); ++cc)
+    {
+      const bool shared = std::any_of(sharableObjects[cc].begin(), sharableObjects[cc].end(),
+        [&](vtkObject* object) { return object && sharableObjectCounts[object] > 1; });
+      (shared ? serial : concurrent).push_back(static_cast<vtkIdType>(cc));
+    }
+
+    vtkSMPTools::For(0, static_cast<vtkIdType>(concurrent.size()),
+      [&](vtkIdType begin, vtkIdType end)
+      {
+        for (vtkIdType idx = begin; idx < end; ++idx)
+        {
+          missingInfos[concurrent[idx]]->CopyFromDataObject(missing[concurrent[idx]]);
+        }
+      });
+    for (vtkIdType idx : serial)
+    {
+      missingInfos[idx]->CopyFromDataObject(missing[idx]);
+    }
+
+    for (size_t cc = 0; cc < missing.size(); ++cc)
+    {
+      cache.Insert(missing[cc], info->InspectCells, missingInfos[cc]);
+    }
+
+    for (size_t cc = 0; cc < leaves.size(); ++cc)
+    {
+      vtkPVDataInformation* current =
+        leafInfos[cc] ? leafInfos[cc] : missingInfos[missingIndex[leaves[cc]]];
+      if (current->GetDataSetType() != -1)
+      {
+        assert(current->GetCompositeDataSetType() == -1);
+        this->UniqueBlockTypes.insert(current->GetDataSetType());
+        info->AddInformation(current);
+      }
     }
-    return info;
   }
 
   void AddGlobalData(vtkPVDataInformation* info, vtkDataObject* dobj)
@@ -139,6 +322,9 @@ vtkStandardNewMacro(vtkPVDataInformation);
 //----------------------------------------------------------------------------
 vtkPVDataInformation::vtkPVDataInformation()
 {
+  // AddInformation is associative, so reduce along a binary tree to avoid
+  // merging information from all ranks on the root.
+  this->ReductionFanIn = 2;
   this->Initialize();
 }
 
@@ -438,6 +624,7 @@ void vtkPVDataInformation::CopyFromObject(vtkObject* object)
   {
     vtkSmartPointer<vtkCompositeDataSet> simpleCD = this->SimplifyCompositeDataSet(cd);
     decltype(this->FirstLeafCompositeIndex) leaf_index = 0;
+    std::vector<vtkDataObject*> leaves;
     using Opts = vtk::CompositeDataSetOptions;
     for (const auto& item : vtk::Range(simpleCD, Opts::None))
     {
@@ -448,9 +635,10 @@ void vtkPVDataInformation::CopyFromObject(vtkObject* object)
       if (item)
       {
         assert(vtkCompositeDataSet::SafeDownCast(item) == nullptr);
-        accumulator(this, item);
+        leaves.push_back(item);
       }
     }
+    accumulator.AddLeaves(this, leaves);
 
     // The range above misses the root node; gather its field data separately
     // and mark those arrays as global (root-level composite field data).
@@ -476,7 +664,7 @@ void vtkPVDataInformation::CopyFromObject(vtkObject* object)
   }
   else if (subset)
   {
-    accumulator(this, subset);
+    accumulator.AddLeaves(this, { subset.GetPointer() });
   }
 
   this->UniqueBlockTypes.clear();
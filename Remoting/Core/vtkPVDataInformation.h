@@ -9,6 +9,11 @@
  * application in lieu of actual data to glean insight into the data e.g. data
  * type, number of points, number of cells, arrays, ranges etc.
  *
+ * Information for individual (non-composite) datasets is cached per process
+ * and reused as long as the dataset's MTime is unchanged; only the most
+ * recently used entries are kept. For composite datasets, information for the
+ * blocks that are not cached and do not share points or arrays with other
+ * blocks is collected concurrently using vtkSMPTools.
  */
 
 #ifndef vtkPVDataInformation_h
@@ -57,6 +62,7 @@ public:
   vtkGetMacro(PortNumber, int);
   ///@}
 
+  ///@{
   /**
    * Flag to ask for deeper cell inspection.
    * When true, this browses the vtkDataSet cells to generate the UniqueCellTypes list.
@@ -64,6 +70,8 @@ public:
    * Default is false.
    */
   vtkSetMacro(InspectCells, bool);
+  vtkGetMacro(InspectCells, bool);
+  ///@}
 
   ///@{
   /**
@@ -6,6 +6,7 @@
 vtkPVInformation::vtkPVInformation()
 {
   this->RootOnly = 0;
+  this->ReductionFanIn = 0;
 }
 
 //----------------------------------------------------------------------------
@@ -16,6 +17,7 @@ void vtkPVInformation::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
   os << indent << "RootOnly: " << this->RootOnly << endl;
+  os << indent << "ReductionFanIn: " << this->ReductionFanIn << endl;
 }
 
 //----------------------------------------------------------------------------
@@ -58,6 +58,19 @@ public:
   vtkGetMacro(RootOnly, int);
   ///@}
 
+  ///@{
+  /**
+   * Get the fan-in of the tree used to reduce information from all ranks in
+   * parallel runs. 0 (default) indicates that information from all ranks is
+   * gathered on the root and merged there sequentially. Values >= 2 indicate
+   * that partial results are merged on intermediate ranks along a tree with
+   * the given fan-in; this requires `AddInformation` to be associative.
+   *
+   * @sa vtkPVInformationReducer
+   */
+  vtkGetMacro(ReductionFanIn, int);
+  ///@}
+
 protected:
   vtkPVInformation();
   ~vtkPVInformation() override;
@@ -65,6 +78,9 @@ protected:
   int RootOnly;
   vtkSetMacro(RootOnly, int);
 
+  int ReductionFanIn;
+  vtkSetClampMacro(ReductionFanIn, int, 0, VTK_INT_MAX);
+
   vtkPVInformation(const vtkPVInformation&) = delete;
   void operator=(const vtkPVInformation&) = delete;
 };
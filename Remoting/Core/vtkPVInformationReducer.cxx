@@ -0,0 +1,145 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkPVInformationReducer.h"
+
+#include "vtkClientServerStream.h"
+#include "vtkMultiProcessController.h"
+#include "vtkObjectFactory.h"
+#include "vtkPVInformation.h"
+#include "vtkSmartPointer.h"
+
+#include <cassert>
+#include <utility>
+#include <vector>
+
+vtkStandardNewMacro(vtkPVInformationReducer);
+vtkCxxSetObjectMacro(vtkPVInformationReducer, Controller, vtkMultiProcessController);
+//----------------------------------------------------------------------------
+vtkPVInformationReducer::vtkPVInformationReducer()
+  : Controller(nullptr)
+  , ReductionFanIn(-1)
+{
+}
+
+//----------------------------------------------------------------------------
+vtkPVInformationReducer::~vtkPVInformationReducer()
+{
+  this->SetController(nullptr);
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVInformationReducer::Reduce(vtkPVInformation* info)
+{
+  assert("pre: nullptr PV information!" && (info != nullptr));
+  if (!this->Controller || this->Controller->GetNumberOfProcesses() == 1)
+  {
+    /* short-circuit */
+    return true;
+  }
+
+  const int fanIn = this->ReductionFanIn >= 0 ? this->ReductionFanIn : info->GetReductionFanIn();
+  return fanIn >= 2 ? this->TreeReduce(info, fanIn) : this->GatherToRoot(info);
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVInformationReducer::GatherToRoot(vtkPVInformation* info)
+{
+  const int rank = this->Controller->GetLocalProcessId();
+  const int nranks = this->Controller->GetNumberOfProcesses();
+
+  // Serialize the local information. GetData returns a pointer to the
+  // stream's own buffer, no need to delete it.
+  vtkClientServerStream stream;
+  info->CopyToStream(&stream);
+  const unsigned char* data;
+  size_t length;
+  stream.GetData(&data, &length);
+  vtkIdType local_length = static_cast<vtkIdType>(length);
+
+  // Get number of bytes that each process will send. This must be known on
+  // all ranks since GatherV needs the lengths and offsets everywhere.
+  std::vector<vtkIdType> rcvcounts(nranks);
+  this->Controller->AllGather(&local_length, rcvcounts.data(), 1);
+
+  std::vector<vtkIdType> offSet(nranks);
+  offSet[0] = 0;
+  for (int i = 1; i < nranks; ++i)
+  {
+    offSet[i] = offSet[i - 1] + rcvcounts[i - 1];
+  }
+  std::vector<unsigned char> rcvbuffer(offSet[nranks - 1] + rcvcounts[nranks - 1]);
+
+  this->Controller->GatherV(
+    data, rcvbuffer.data(), local_length, rcvcounts.data(), offSet.data(), 0);
+
+  // Deserialize data from other ranks at rank 0 and add them to the
+  // information object associated with rank 0.
+  if (rank == 0)
+  {
+    vtkClientServerStream rcvStream;
+    for (int i = 1; i < nranks; ++i)
+    {
+      rcvStream.SetData(&rcvbuffer[offSet[i]], rcvcounts[i]);
+      auto tempInfo = vtkSmartPointer<vtkPVInformation>::Take(info->NewInstance());
+      tempInfo->CopyFromStream(&rcvStream);
+      info->AddInformation(tempInfo);
+    }
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVInformationReducer::TreeReduce(vtkPVInformation* info, int fanIn)
+{
+  const int rank = this->Controller->GetLocalProcessId();
+  const int nranks = this->Controller->GetNumberOfProcesses();
+
+  // At each level, ranks that are multiples of `fanIn * stride` receive from
+  // the next `fanIn - 1` ranks that are multiples of `stride`, in increasing
+  // rank order, and all other participating ranks send their partial result
+  // to that parent and are done. Information is thus always merged in rank
+  // order.
+  for (vtkIdType stride = 1; stride < nranks; stride *= fanIn)
+  {
+    const vtkIdType group = stride * fanIn;
+    const vtkIdType offset = rank % group;
+    if (offset != 0)
+    {
+      assert(offset % stride == 0);
+      vtkClientServerStream stream;
+      info->CopyToStream(&stream);
+      const unsigned char* data;
+      size_t length;
+      stream.GetData(&data, &length);
+      vtkIdType local_length = static_cast<vtkIdType>(length);
+
+      const int parent = static_cast<int>(rank - offset);
+      this->Controller->Send(&local_length, 1, parent, TREE_REDUCTION_TAG);
+      this->Controller->Send(data, local_length, parent, TREE_REDUCTION_TAG);
+      return true;
+    }
+
+    for (vtkIdType child = rank + stride; child < rank + group && child < nranks; child += stride)
+    {
+      vtkIdType length = 0;
+      this->Controller->Receive(&length, 1, static_cast<int>(child), TREE_REDUCTION_TAG);
+      std::vector<unsigned char> buffer(static_cast<size_t>(length));
+      this->Controller->Receive(buffer.data(), length, static_cast<int>(child), TREE_REDUCTION_TAG);
+
+      vtkClientServerStream rcvStream;
+      rcvStream.SetData(std::move(buffer));
+      auto tempInfo = vtkSmartPointer<vtkPVInformation>::Take(info->NewInstance());
+      tempInfo->CopyFromStream(&rcvStream);
+      info->AddInformation(tempInfo);
+    }
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVInformationReducer::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Controller: " << this->Controller << endl;
+  os << indent << "ReductionFanIn: " << this->ReductionFanIn << endl;
+}
@@ -0,0 +1,89 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkPVInformationReducer
+ * @brief   combines vtkPVInformation gathered on all ranks onto the root.
+ *
+ * vtkPVInformationReducer merges the vtkPVInformation collected locally on
+ * each rank of a vtkMultiProcessController into the instance on the root rank
+ * (rank 0). Two strategies are supported:
+ *
+ * * **gather**: every rank serializes its information and sends it to the
+ *   root using a single `GatherV`. The root then merges all of them in rank
+ *   order. Memory use and merge time on the root grow linearly with the number
+ *   of ranks.
+ *
+ * * **tree**: information is reduced along a k-ary tree. At each level, a
+ *   rank merges information from up to `k - 1` other ranks before forwarding
+ *   the partial result to its parent. The root only ever merges `k - 1`
+ *   partial results per level, i.e. `O(log(P))` in total.
+ *
+ * Both strategies merge information in rank order, hence a tree reduction
+ * yields the same result as the gather provided `AddInformation` is
+ * associative. Information classes opt into the tree reduction using
+ * `vtkPVInformation::GetReductionFanIn`.
+ */
+
+#ifndef vtkPVInformationReducer_h
+#define vtkPVInformationReducer_h
+
+#include "vtkObject.h"
+#include "vtkRemotingCoreModule.h" //needed for exports
+
+class vtkMultiProcessController;
+class vtkPVInformation;
+
+class VTKREMOTINGCORE_EXPORT vtkPVInformationReducer : public vtkObject
+{
+public:
+  static vtkPVInformationReducer* New();
+  vtkTypeMacro(vtkPVInformationReducer, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  ///@{
+  /**
+   * Get/Set the controller to use. Must be set before calling `Reduce`.
+   */
+  void SetController(vtkMultiProcessController*);
+  vtkGetObjectMacro(Controller, vtkMultiProcessController);
+  ///@}
+
+  ///@{
+  /**
+   * Override the reduction strategy requested by the information object.
+   * -1 (default) uses `vtkPVInformation::GetReductionFanIn`, 0 forces a
+   * gather to the root and values >= 2 force a tree reduction with the given
+   * fan-in. This is mainly intended for benchmarking and testing.
+   */
+  vtkSetClampMacro(ReductionFanIn, int, -1, VTK_INT_MAX);
+  vtkGetMacro(ReductionFanIn, int);
+  ///@}
+
+  /**
+   * Merge `info` from all ranks into `info` on the root rank. Must be called
+   * on all ranks of the controller. On ranks other than the root, the
+   * contents of `info` are undefined after this call.
+   */
+  bool Reduce(vtkPVInformation* info);
+
+protected:
+  vtkPVInformationReducer();
+  ~vtkPVInformationReducer() override;
+
+  bool GatherToRoot(vtkPVInformation* info);
+  bool TreeReduce(vtkPVInformation* info, int fanIn);
+
+  vtkMultiProcessController* Controller;
+  int ReductionFanIn;
+
+  enum
+  {
+    TREE_REDUCTION_TAG = 887824
+  };
+
+private:
+  vtkPVInformationReducer(const vtkPVInformationReducer&) = delete;
+  void operator=(const vtkPVInformationReducer&) = delete;
+};
+
+#endif
@@ -6,19 +6,123 @@
 #include "vtkAlgorithmOutput.h"
 #include "vtkDataObject.h"
 #include "vtkInformation.h"
+#include "vtkMultiProcessStream.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
+#include "vtkProcessModule.h"
+#include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkWeakPointer.h"
 
+#include <algorithm>
+#include <map>
+#include <string>
+#include <utility>
 #include <vector>
 
+namespace
+{
+/**
+ * Process-wide cache of the data information gathered for each timestep of
+ * an output port. Entries are keyed on the producer, the output port and the
+ * gathering parameters, and are reset whenever the pipeline MTime of the
+ * producer changes. Entries are discarded once the producer is released.
+ */
+class vtkPVTemporalDataInformationCache
+{
+public:
+  struct EntryType
+  {
+    vtkWeakPointer<vtkAlgorithm> Producer;
+    vtkMTimeType PipelineMTime = 0;
+    std::map<double, vtkSmartPointer<vtkPVDataInformation>> TimeSteps;
+  };
+
+  static vtkPVTemporalDataInformationCache& GetInstance()
+  {
+    static vtkPVTemporalDataInformationCache instance;
+    return instance;
+  }
+
+  EntryType& GetEntry(vtkAlgorithm* producer, const std::string& parameters, vtkMTimeType mtime)
+  {
+    auto& entry = this->Entries[std::make_pair(producer, parameters)];
+    if (entry.Producer != producer || entry.PipelineMTime != mtime)
+    {
+      entry.Producer = producer;
+      entry.PipelineMTime = mtime;
+      entry.TimeSteps.clear();
+    }
+    return entry;
+  }
+
+  /**
+   * Drop entries for producers that have since been deleted.
+   */
+  void Prune()
+  {
+    for (auto iter = this->Entries.begin(); iter != this->Entries.end();)
+    {
+      if (iter->second.Producer == nullptr)
+      {
+        iter = this->Entries.erase(iter);
+      }
+      else
+      {
+        ++iter;
+      }
+    }
+  }
+
+private:
+  std::map<std::pair<vtkAlgorithm*, std::string>, EntryType> Entries;
+};
+}
+
+bool vtkPVTemporalDataInformation::DefaultDistributeTimeStepsAcrossRanks = false;
+
 vtkStandardNewMacro(vtkPVTemporalDataInformation);
 //----------------------------------------------------------------------------
-vtkPVTemporalDataInformation::vtkPVTemporalDataInformation() = default;
+vtkPVTemporalDataInformation::vtkPVTemporalDataInformation()
+  : DistributeTimeStepsAcrossRanks(
+      vtkPVTemporalDataInformation::DefaultDistributeTimeStepsAcrossRanks)
+{
+}
 
 //----------------------------------------------------------------------------
 vtkPVTemporalDataInformation::~vtkPVTemporalDataInformation() = default;
 
+//----------------------------------------------------------------------------
+void vtkPVTemporalDataInformation::SetDefaultDistributeTimeStepsAcrossRanks(bool value)
+{
+  vtkPVTemporalDataInformation::DefaultDistributeTimeStepsAcrossRanks = value;
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVTemporalDataInformation::GetDefaultDistributeTimeStepsAcrossRanks()
+{
+  return vtkPVTemporalDataInformation::DefaultDistributeTimeStepsAcrossRanks;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVTemporalDataInformation::CopyParametersToStream(vtkMultiProcessStream& str)
+{
+  this->Superclass::CopyParametersToStream(str);
+  str << 828793 << this->DistributeTimeStepsAcrossRanks;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVTemporalDataInformation::CopyParametersFromStream(vtkMultiProcessStream& str)
+{
+  this->Superclass::CopyParametersFromStream(str);
+  int magic_number;
+  str >> magic_number >> this->DistributeTimeStepsAcrossRanks;
+  if (magic_number != 828793)
+  {
+    vtkErrorMacro("Magic number mismatch.");
+  }
+}
+
 //----------------------------------------------------------------------------
 void vtkPVTemporalDataInformation::CopyFromObject(vtkObject* object)
 {
@@ -78,14 +182,106 @@ void vtkPVTemporalDataInformation::CopyFromObject(vtkObject* object)
     return;
   }
 
+  auto pm = vtkProcessModule::GetProcessModule();
+  const int numRanks = pm ? pm->GetNumberOfLocalPartitions() : 1;
+  const int rank = pm ? pm->GetPartitionId() : 0;
+  const bool distribute =
+    this->DistributeTimeStepsAcrossRanks && numRanks > 1 && this->GetRank() == -1;
+
+  // The piece each rank requests is part of the cache key since the
+  // information of a timestep only describes that piece.
+  int piece = 0;
+  int numberOfPieces = 1;
+  int ghostLevels = 0;
+  if (pipelineInfo->Has(vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER()))
+  {
+    piece = pipelineInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER());
+  }
+  if (pipelineInfo->Has(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES()))
+  {
+    numberOfPieces = pipelineInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES());
+  }
+  if (pipelineInfo->Has(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_GHOST_LEVELS()))
+  {
+    ghostLevels =
+      pipelineInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_GHOST_LEVELS());
+  }
+
+  std::string parameters = std::to_string(port->GetIndex()) + ";" +
+    (this->GetSubsetSelector() ? this->GetSubsetSelector() : "") + ";" +
+    (this->GetSubsetAssemblyName() ? this->GetSubsetAssemblyName() : "") + ";" +
+    std::to_string(this->GetInspectCells()) + ";";
+  parameters += distribute ? "whole" : std::to_string(piece) + "/" + std::to_string(numberOfPieces);
+
+  auto& cache = vtkPVTemporalDataInformationCache::GetInstance();
+  cache.Prune();
+  auto& entry = cache.GetEntry(port->GetProducer(), parameters, sddp->GetPipelineMTime());
+
   double current_time = this->GetTime();
-  for (auto time : timesteps)
+  if (!distribute && entry.TimeSteps.find(current_time) == entry.TimeSteps.end())
+  {
+    // cache the timestep already seen, in case the current time changes.
+    auto current = vtkSmartPointer<vtkPVDataInformation>::New();
+    current->DeepCopy(this);
+    entry.TimeSteps[current_time] = current;
+  }
+
+  if (distribute)
   {
+    // Each rank processes the whole dataset for its share of the timesteps.
+    pipelineInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER(), 0);
+    pipelineInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES(), 1);
+    pipelineInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_GHOST_LEVELS(), 0);
+
+    // The information collected above only describes the local piece, replace
+    // it by the whole dataset at the current time on the rank owning that
+    // timestep. Other ranks only contribute their own timesteps.
+    const auto found = std::find(timesteps.begin(), timesteps.end(), current_time);
+    const size_t currentIndex =
+      found != timesteps.end() ? static_cast<size_t>(found - timesteps.begin()) : 0;
+    auto iter = entry.TimeSteps.find(current_time);
+    if (static_cast<int>(currentIndex % numRanks) != rank)
+    {
+      this->Initialize();
+    }
+    else if (iter != entry.TimeSteps.end())
+    {
+      this->Initialize();
+      this->AddInformation(iter->second);
+    }
+    else
+    {
+      pipelineInfo->Set(sddp->UPDATE_TIME_STEP(), current_time);
+      sddp->Update(port->GetIndex());
+      this->Superclass::CopyFromObject(port);
+
+      auto current = vtkSmartPointer<vtkPVDataInformation>::New();
+      current->DeepCopy(this);
+      entry.TimeSteps[current_time] = current;
+    }
+  }
+
+  for (size_t cc = 0; cc < timesteps.size(); ++cc)
+  {
+    const double time = timesteps[cc];
     if (time == current_time)
     {
       // skip the timestep already seen.
       continue;
     }
+    if (distribute && static_cast<int>(cc % numRanks) != rank)
+    {
+      // another rank handles this timestep.
+      continue;
+    }
+
+    auto iter = entry.TimeSteps.find(time);
+    if (iter != entry.TimeSteps.end())
+    {
+      this->AddInformation(iter->second);
+      continue;
+    }
+
     pipelineInfo->Set(sddp->UPDATE_TIME_STEP(), time);
     sddp->Update(port->GetIndex());
 
@@ -94,6 +290,17 @@ void vtkPVTemporalDataInformation::CopyFromObject(vtkObject* object)
     vtkNew<vtkPVDataInformation> dinfo;
     dinfo->CopyFromObject(dobj);
     this->AddInformation(dinfo);
+    entry.TimeSteps[time] = dinfo;
+  }
+
+  if (distribute)
+  {
+    // restore the piece requested before, so the next update of the pipeline
+    // produces the same data as before.
+    pipelineInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER(), piece);
+    pipelineInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES(), numberOfPieces);
+    pipelineInfo->Set(
+      vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_GHOST_LEVELS(), ghostLevels);
   }
 }
 
@@ -101,4 +308,6 @@ void vtkPVTemporalDataInformation::CopyFromObject(vtkObject* object)
 void vtkPVTemporalDataInformation::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "DistributeTimeStepsAcrossRanks: " << this->DistributeTimeStepsAcrossRanks
+     << endl;
 }
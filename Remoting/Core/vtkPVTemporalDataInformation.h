@@ -7,6 +7,19 @@
  * vtkPVTemporalDataInformation is used to gather data information over time.
  * It simply overrides `vtkPVDataInformation::CopyFromObject` to ensure that the
  * data information is collected from all timesteps and not just 1.
+ *
+ * The information collected for each timestep is cached per process and per
+ * output port, and reused as long as the pipeline MTime of the producer is
+ * unchanged. Thus only the timesteps never visited before need the pipeline
+ * to be re-executed when gathering temporal information again.
+ *
+ * When DistributeTimeStepsAcrossRanks is enabled, each rank executes the
+ * pipeline on the whole dataset (piece 0 of 1) for a subset of the timesteps
+ * instead of executing its own piece for all timesteps. This is only valid
+ * for pipelines that do not communicate across ranks when executing, such as
+ * a reader of time-independent files followed by serial filters. The current
+ * timestep is gathered the same way, so the result always describes the whole
+ * dataset.
  */
 
 #ifndef vtkPVTemporalDataInformation_h
@@ -31,6 +44,37 @@ public:
    */
   void CopyFromObject(vtkObject* object) override;
 
+  ///@{
+  /**
+   * When true, missing timesteps are split across ranks and each rank
+   * executes the pipeline for the whole dataset on its subset of timesteps.
+   * Default is false, or the value passed to
+   * SetDefaultDistributeTimeStepsAcrossRanks().
+   */
+  vtkSetMacro(DistributeTimeStepsAcrossRanks, bool);
+  vtkGetMacro(DistributeTimeStepsAcrossRanks, bool);
+  vtkBooleanMacro(DistributeTimeStepsAcrossRanks, bool);
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get the initial value of DistributeTimeStepsAcrossRanks for instances
+   * created afterwards. vtkSMOutputPort also applies it before each gather.
+   * It is set through the `DistributeTemporalInformationAcrossRanks` general
+   * setting.
+   */
+  static void SetDefaultDistributeTimeStepsAcrossRanks(bool value);
+  static bool GetDefaultDistributeTimeStepsAcrossRanks();
+  ///@}
+
+  ///@{
+  /**
+   * vtkPVInformation API implementation.
+   */
+  void CopyParametersToStream(vtkMultiProcessStream&) override;
+  void CopyParametersFromStream(vtkMultiProcessStream&) override;
+  ///@}
+
 protected:
   vtkPVTemporalDataInformation();
   ~vtkPVTemporalDataInformation() override;
@@ -38,6 +82,9 @@ protected:
 private:
   vtkPVTemporalDataInformation(const vtkPVTemporalDataInformation&) = delete;
   void operator=(const vtkPVTemporalDataInformation&) = delete;
+
+  bool DistributeTimeStepsAcrossRanks;
+  static bool DefaultDistributeTimeStepsAcrossRanks;
 };
 
 #endif
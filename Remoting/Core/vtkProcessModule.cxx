@@ -46,6 +46,7 @@
 // destroyed before the process module singleton is cleaned up.
 #include "vtkPVPluginLoader.h"
 
+#include <algorithm>
 #include <cassert>
 #include <clocale> // needed for setlocale()
 #include <sstream>
@@ -137,6 +138,9 @@ bool vtkProcessModule::FinalizePython = false;
 vtkSmartPointer<vtkProcessModule> vtkProcessModule::Singleton;
 vtkSmartPointer<vtkMultiProcessController> vtkProcessModule::GlobalController;
 
+int vtkProcessModule::NumberOfRankGroups = 1;
+int vtkProcessModule::RankGroupId = 0;
+
 int vtkProcessModule::DefaultMinimumGhostLevelsToRequestForUnstructuredPipelines = 1;
 int vtkProcessModule::DefaultMinimumGhostLevelsToRequestForStructuredPipelines = 0;
 
@@ -238,6 +242,20 @@ bool vtkProcessModule::Initialize(ProcessTypes type, int& argc, char**& argv)
     {
       throw std::runtime_error("Client process should be run with one process!");
     }
+
+    // Split the ranks into contiguous groups that each behave as an
+    // independent batch process.
+    const int numGroups = std::min(config->GetNumberOfRankGroups(), numRanks);
+    if (type == PROCESS_BATCH && numGroups > 1)
+    {
+      const int rank = vtkProcessModule::GlobalController->GetLocalProcessId();
+      vtkProcessModule::NumberOfRankGroups = numGroups;
+      vtkProcessModule::RankGroupId =
+        static_cast<int>(static_cast<vtkTypeInt64>(rank) * numGroups / numRanks);
+      vtkProcessModule::GlobalController.TakeReference(
+        vtkProcessModule::GlobalController->PartitionController(
+          vtkProcessModule::RankGroupId, rank));
+    }
   }
 #else
   static_cast<void>(argc); // unused warning when MPI is off
@@ -357,6 +375,8 @@ bool vtkProcessModule::Finalize()
   vtkMultiProcessController::SetGlobalController(nullptr);
   vtkProcessModule::GlobalController->Finalize(/*finalizedExternally*/ 1);
   vtkProcessModule::GlobalController = nullptr;
+  vtkProcessModule::NumberOfRankGroups = 1;
+  vtkProcessModule::RankGroupId = 0;
 
 #if VTK_MODULE_ENABLE_VTK_ParallelMPI
   if (vtkProcessModule::FinalizeMPI)
@@ -229,6 +229,17 @@ public:
   static bool GetSymmetricMPIMode();
   ///@}
 
+  ///@{
+  /**
+   * When the MPI ranks are split into independent groups (see
+   * `vtkProcessModuleConfiguration::GetNumberOfRankGroups`), returns the number
+   * of groups and the index of the group this process belongs to. The global
+   * controller then only spans the ranks of the group.
+   */
+  static int GetNumberOfRankGroups() { return vtkProcessModule::NumberOfRankGroups; }
+  static int GetRankGroupId() { return vtkProcessModule::RankGroupId; }
+  ///@}
+
   /**
    * The full path to the current executable that is running (or empty if unknown).
    */
@@ -334,6 +345,9 @@ private:
   static vtkSmartPointer<vtkProcessModule> Singleton;
   static vtkSmartPointer<vtkMultiProcessController> GlobalController;
 
+  static int NumberOfRankGroups;
+  static int RankGroupId;
+
   bool MultipleSessionsSupport;
 
   vtkIdType EventCallDataSessionId;
@@ -115,6 +115,14 @@ bool vtkProcessModuleConfiguration::PopulateOptions(
   {
     app->add_flag("-s,--sym,--symmetric", this->SymmetricMPIMode,
       "When specified, the python script is processed symmetrically on all processes.");
+    group
+      ->add_option("--rank-groups", this->NumberOfRankGroups,
+        "Split the MPI ranks into this many independent groups, each running the script. "
+        "Animations saved as image series are then rendered time-parallel, with each "
+        "group saving a disjoint subset of the frames. Movies, screenshots and data "
+        "saved with SaveData are saved by the first group alone; other outputs of the "
+        "script are written by every group.")
+      ->check(CLI::PositiveNumber);
   }
 #if PARAVIEW_USE_PYTHON
   app->add_option("--venv", this->VirtualEnvironmentPath,
@@ -139,6 +147,12 @@ std::string vtkProcessModuleConfiguration::GetRankAnnotatedFileName(const std::s
   }
 
   auto controller = vtkMultiProcessController::GetGlobalController();
+  if (vtkProcessModule::GetNumberOfRankGroups() > 1)
+  {
+    // ranks of different groups share the same local process id.
+    return fname + "." + vtk::to_string(vtkProcessModule::GetRankGroupId()) + "." +
+      vtk::to_string(controller->GetLocalProcessId());
+  }
   return (controller && controller->GetNumberOfProcesses() > 1)
     ? fname + "." + vtk::to_string(controller->GetLocalProcessId())
     : fname;
@@ -151,6 +165,7 @@ void vtkProcessModuleConfiguration::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "ForceMPIInit: " << this->ForceMPIInit << endl;
   os << indent << "ForceNoMPIInit: " << this->ForceNoMPIInit << endl;
   os << indent << "SymmetricMPIMode: " << this->SymmetricMPIMode << endl;
+  os << indent << "NumberOfRankGroups: " << this->NumberOfRankGroups << endl;
   os << indent << "EnableStackTrace: " << this->EnableStackTrace << endl;
   os << indent << "LogStdErrVerbosity: " << this->LogStdErrVerbosity << endl;
   os << indent << "CSLogFileName: " << this->CSLogFileName.c_str() << endl;
@@ -63,6 +63,15 @@ public:
    */
   vtkSetMacro(SymmetricMPIMode, bool);
 
+  /**
+   * Get the number of independent groups the MPI ranks are split into. This is
+   * only supported in "batch". Each group runs the script with its own
+   * sub-communicator and, when saving an animation as an image series, renders
+   * a disjoint subset of the frames. Movies, screenshots and data saved with
+   * SaveData are saved by the first group alone. Default is 1.
+   */
+  vtkGetMacro(NumberOfRankGroups, int);
+
   /**
    * Get the virtual environment path to set up for Python.
    */
@@ -122,6 +131,7 @@ private:
   bool ForceNoMPIInit = false;
   bool UseMPISSend = false;
   bool SymmetricMPIMode = false;
+  int NumberOfRankGroups = 1;
   std::string VirtualEnvironmentPath;
   bool EnableStackTrace = false;
   vtkLogger::Verbosity LogStdErrVerbosity = vtkLogger::VERBOSITY_INVALID;
@@ -12,8 +12,10 @@
 #include "vtkMemberFunctionCommand.h"
 #include "vtkMultiProcessController.h"
 #include "vtkMultiProcessStream.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPVInformation.h"
+#include "vtkPVInformationReducer.h"
 #include "vtkPVSession.h"
 #include "vtkPVSessionCoreInterpreterHelper.h"
 #include "vtkProcessModule.h"
@@ -31,6 +33,8 @@
 #include <set>
 #include <sstream>
 #include <string>
+#include <utility>
+#include <vector>
 
 #define LOG(x)                                                                                     \
   if (this->LogStream)                                                                             \
@@ -584,13 +588,12 @@ void vtkPVSessionCore::ExecuteStreamSatelliteCallback()
 {
   int byte_size[2] = { 0, 0 };
   this->ParallelController->Broadcast(byte_size, 2, 0);
-  unsigned char* raw_data = new unsigned char[byte_size[0] + 1];
-  this->ParallelController->Broadcast(raw_data, byte_size[0], 0);
+  std::vector<unsigned char> raw_data(static_cast<size_t>(byte_size[0]));
+  this->ParallelController->Broadcast(raw_data.data(), byte_size[0], 0);
 
   vtkClientServerStream stream;
-  stream.SetData(raw_data, byte_size[0]);
+  stream.SetData(std::move(raw_data));
   this->ExecuteStreamInternal(stream, byte_size[1] != 0);
-  delete[] raw_data;
 }
 
 //----------------------------------------------------------------------------
@@ -858,91 +861,25 @@ void vtkPVSessionCore::GatherInformationStatelliteCallback()
 }
 
 //----------------------------------------------------------------------------
-#define SafeDeleteArray(array_ptr)                                                                 \
-  {                                                                                                \
-    if ((array_ptr) != nullptr)                                                                    \
-    {                                                                                              \
-      delete[] (array_ptr);                                                                        \
-      (array_ptr) = nullptr;                                                                       \
-    }                                                                                              \
-  }
-
 bool vtkPVSessionCore::CollectInformation(vtkPVInformation* info)
 {
   // Sanity checks
   assert("pre: nullptr PV information!" && (info != nullptr));
 
-  // STEP 0: temporary variables
-  int rank = this->ParallelController->GetLocalProcessId();
-  int nranks = this->ParallelController->GetNumberOfProcesses();
-
-  if (nranks == 1)
+  if (this->ParallelController->GetNumberOfProcesses() == 1)
   {
     /* short-circuit */
     return true;
   }
 
-  // STEP 1: Initialize data-structures for all ranks
-  std::vector<vtkIdType> rcvcounts(nranks);
-  std::vector<vtkIdType> offSet(nranks);
-  std::vector<unsigned char> rcvbuffer;
-  int rbufsize = 0;
-
-  // STEP 2: Serialize the vtkPVInformation object
-  vtkClientServerStream stream;
-  info->CopyToStream(&stream);
-
-  const unsigned char* data;
-  size_t length;
-
-  // Get pointer to the raw stream data. Note, this is a shallow copy, no
-  // need to delete the data.
-  stream.GetData(&data, &length);
-  vtkIdType local_length = static_cast<vtkIdType>(length);
-
-  // STEP 3: Get number of bytes that each process will send for all ranks
-  this->ParallelController->AllGather(&local_length, rcvcounts.data(), 1);
-
-  // STEP 4: Allocate temporary arrays for all ranks
-  // Note: this must be calculated for all ranks because the GatherV method
-  // needs to know the lengths and offsets information from all ranks
-  // STEP 4.1: Calculate rcvbuffer size & allocate rcvbuffer
-  rbufsize = rcvcounts[0];
-  for (int i = 1; i < nranks; ++i)
-  {
-    rbufsize += rcvcounts[i];
-  }
-  rcvbuffer.resize(rbufsize);
-
-  // STEP 4.2: populate offset array
-  offSet[0] = 0;
-  for (int i = 1; i < nranks; ++i)
-  {
-    offSet[i] = offSet[i - 1] + rcvcounts[i - 1];
-  }
-
-  // STEP 5: GatherV all data from satellites
-  this->ParallelController->GatherV(
-    data, rcvbuffer.data(), local_length, rcvcounts.data(), offSet.data(), 0);
+  // Merge information from all ranks on the root, either by gathering it
+  // directly or along a tree, as requested by the information class.
+  vtkNew<vtkPVInformationReducer> reducer;
+  reducer->SetController(this->ParallelController);
+  const bool status = reducer->Reduce(info);
 
-  // STEP 6: Deserialize data from other ranks at rank 0 and add them to
-  // the information object associated with rank 0.
-  if (rank == 0)
-  {
-    vtkClientServerStream rcvStream;
-    for (int i = 1; i < nranks; ++i)
-    {
-      rcvStream.SetData(&rcvbuffer[offSet[i]], rcvcounts[i]);
-      vtkPVInformation* tempInfo = info->NewInstance();
-      tempInfo->CopyFromStream(&rcvStream);
-      info->AddInformation(tempInfo);
-      tempInfo->Delete();
-    } // END for all remote ranks
-  } // END if rank == 0
-
-  // STEP 8: Barrier synchronization
   this->ParallelController->Barrier();
-  return true;
+  return status;
 }
 
 //----------------------------------------------------------------------------
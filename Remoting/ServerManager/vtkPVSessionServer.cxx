@@ -25,11 +25,13 @@
 #include "vtkSocketController.h"
 #include "vtkStringScanner.h"
 
+#include <algorithm>
 #include <cassert>
 #include <iostream>
 #include <map>
 #include <sstream>
 #include <string>
+#include <utility>
 #include <vector>
 #include <vtksys/RegularExpression.hxx>
 
@@ -515,6 +517,12 @@ void vtkPVSessionServer::OnClientServerMessageRMI(void* message, int messageLeng
   stream.SetRawData(reinterpret_cast<const unsigned char*>(message), messageLength);
   int type;
   stream >> type;
+  this->ProcessClientServerMessage(type, stream);
+}
+
+//----------------------------------------------------------------------------
+void vtkPVSessionServer::ProcessClientServerMessage(int type, vtkMultiProcessStream& stream)
+{
   switch (type)
   {
     case vtkPVSessionServer::PUSH:
@@ -582,11 +590,13 @@ void vtkPVSessionServer::OnClientServerMessageRMI(void* message, int messageLeng
     {
       int ignoreErrors, sendReply, size;
       stream >> ignoreErrors >> sendReply >> size;
-      unsigned char* css_data = new unsigned char[size + 1];
+      // Receive directly into the buffer the stream will own to avoid an
+      // extra copy of potentially large array arguments.
+      std::vector<unsigned char> css_data(static_cast<size_t>(size));
       this->Internal->GetActiveController()->Receive(
-        css_data, size, 1, vtkPVSessionServer::EXECUTE_STREAM_TAG);
+        css_data.data(), size, 1, vtkPVSessionServer::EXECUTE_STREAM_TAG);
       vtkClientServerStream cssStream;
-      cssStream.SetData(css_data, size);
+      cssStream.SetData(std::move(css_data));
       this->ExecuteStream(vtkPVSession::CLIENT_AND_SERVERS, cssStream, ignoreErrors != 0);
 
       if (sendReply)
@@ -595,7 +605,6 @@ void vtkPVSessionServer::OnClientServerMessageRMI(void* message, int messageLeng
         this->Internal->GetActiveController()->Send(
           &dummy, 1, 1, vtkPVSessionServer::STREAM_EXECUTED);
       }
-      delete[] css_data;
     }
     break;
 
@@ -613,6 +622,60 @@ void vtkPVSessionServer::OnClientServerMessageRMI(void* message, int messageLeng
       this->GatherInformationInternal(location, classname.c_str(), globalid, stream);
     }
     break;
+
+    case vtkPVSessionServer::GATHER_INFORMATION_BATCH:
+    {
+      this->GatherInformationBatchInternal(stream);
+    }
+    break;
+
+    case vtkPVSessionServer::MESSAGE_BATCH:
+    {
+      this->ProcessMessageBatch(stream);
+    }
+    break;
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVSessionServer::ProcessMessageBatch(vtkMultiProcessStream& stream)
+{
+  int count = 0;
+  stream >> count;
+  for (int cc = 0; cc < count; ++cc)
+  {
+    int type;
+    stream >> type;
+    switch (type)
+    {
+      case vtkPVSessionServer::PUSH:
+      case vtkPVSessionServer::REGISTER_SI:
+      case vtkPVSessionServer::UNREGISTER_SI:
+        this->ProcessClientServerMessage(type, stream);
+        break;
+
+      case vtkPVSessionServer::EXECUTE_STREAM:
+      {
+        int ignoreErrors, size;
+        stream >> ignoreErrors >> size;
+        // Pop directly into the buffer the stream will own, the size being
+        // sent first so that it can be allocated beforehand. Pop() allocates
+        // its own buffer when given nullptr, hence never pass an empty one.
+        std::vector<unsigned char> css_data(static_cast<size_t>(std::max(size, 1)));
+        unsigned char* data = css_data.data();
+        unsigned int length = static_cast<unsigned int>(size);
+        stream.Pop(data, length);
+        css_data.resize(static_cast<size_t>(size));
+        vtkClientServerStream cssStream;
+        cssStream.SetData(std::move(css_data));
+        this->ExecuteStream(vtkPVSession::CLIENT_AND_SERVERS, cssStream, ignoreErrors != 0);
+      }
+      break;
+
+      default:
+        vtkErrorMacro("Unexpected message type in batch: " << type);
+        return;
+    }
   }
 }
 
@@ -633,23 +696,36 @@ void vtkPVSessionServer::SendLastResultToClient()
 }
 
 //----------------------------------------------------------------------------
-void vtkPVSessionServer::GatherInformationInternal(vtkTypeUInt32 location, const char* classname,
-  vtkTypeUInt32 globalid, vtkMultiProcessStream& stream)
+bool vtkPVSessionServer::GatherInformationToStream(vtkTypeUInt32 location, const char* classname,
+  vtkTypeUInt32 globalid, vtkMultiProcessStream& parameters, vtkClientServerStream& reply)
 {
   vtkSmartPointer<vtkObjectBase> o;
   o.TakeReference(vtkClientServerStreamInstantiator::CreateInstance(classname));
 
   vtkPVInformation* info = vtkPVInformation::SafeDownCast(o);
-  if (info)
+  if (!info)
   {
-    // ensures that the vtkPVInformation has the same ivars locally as on the
-    // client.
-    info->CopyParametersFromStream(stream);
+    vtkErrorMacro(
+      "Could not create information object: `" << (classname ? classname : "(nullptr)") << "`.");
+    return false;
+  }
 
-    this->GatherInformation(location, info, globalid);
+  // ensures that the vtkPVInformation has the same ivars locally as on the
+  // client.
+  info->CopyParametersFromStream(parameters);
 
-    vtkClientServerStream css;
-    info->CopyToStream(&css);
+  this->GatherInformation(location, info, globalid);
+  info->CopyToStream(&reply);
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVSessionServer::GatherInformationInternal(vtkTypeUInt32 location, const char* classname,
+  vtkTypeUInt32 globalid, vtkMultiProcessStream& stream)
+{
+  vtkClientServerStream css;
+  if (this->GatherInformationToStream(location, classname, globalid, stream, css))
+  {
     size_t length;
     const unsigned char* data;
     css.GetData(&data, &length);
@@ -661,8 +737,6 @@ void vtkPVSessionServer::GatherInformationInternal(vtkTypeUInt32 location, const
   }
   else
   {
-    vtkErrorMacro(
-      "Could not create information object: `" << (classname ? classname : "(nullptr)") << "`.");
     // let client know that gather failed.
     int len = 0;
     this->Internal->GetActiveController()->Send(
@@ -670,6 +744,49 @@ void vtkPVSessionServer::GatherInformationInternal(vtkTypeUInt32 location, const
   }
 }
 
+//----------------------------------------------------------------------------
+void vtkPVSessionServer::GatherInformationBatchInternal(vtkMultiProcessStream& stream)
+{
+  int count = 0;
+  stream >> count;
+
+  // The reply holds, for each request in order, a status followed by the
+  // serialized information when the status is non-zero.
+  vtkMultiProcessStream reply;
+  reply << count;
+  for (int cc = 0; cc < count; ++cc)
+  {
+    std::string classname;
+    vtkTypeUInt32 location, globalid;
+    stream >> location >> classname >> globalid;
+
+    // parameters are nested so that a request for an unknown class does not
+    // corrupt the ones that follow.
+    unsigned char* rawParameters = nullptr;
+    unsigned int rawParametersLength = 0;
+    stream.Pop(rawParameters, rawParametersLength);
+    vtkMultiProcessStream parameters;
+    parameters.SetRawData(rawParameters, rawParametersLength);
+    delete[] rawParameters;
+
+    vtkClientServerStream css;
+    if (this->GatherInformationToStream(location, classname.c_str(), globalid, parameters, css))
+    {
+      size_t length;
+      const unsigned char* data;
+      css.GetData(&data, &length);
+      reply << 1;
+      reply.Push(const_cast<unsigned char*>(data), static_cast<unsigned int>(length));
+    }
+    else
+    {
+      reply << 0;
+    }
+  }
+  this->Internal->GetActiveController()->Send(
+    reply, 1, vtkPVSessionServer::REPLY_GATHER_INFORMATION_BATCH_TAG);
+}
+
 //----------------------------------------------------------------------------
 void vtkPVSessionServer::OnCloseSessionRMI()
 {
@@ -16,6 +16,7 @@
 #include "vtkPVSessionBase.h"
 #include "vtkRemotingServerManagerModule.h" //needed for exports
 
+class vtkClientServerStream;
 class vtkMultiProcessController;
 class vtkMultiProcessStream;
 
@@ -71,6 +72,8 @@ public:
     REGISTER_SI = 16,
     UNREGISTER_SI = 17,
     LAST_RESULT = 18,
+    GATHER_INFORMATION_BATCH = 19,
+    MESSAGE_BATCH = 20,
     SERVER_NOTIFICATION_MESSAGE_RMI = 55624,
     CLIENT_SERVER_MESSAGE_RMI = 55625,
     CLOSE_SESSION = 55626,
@@ -78,7 +81,8 @@ public:
     REPLY_PULL = 55628,
     REPLY_LAST_RESULT = 55629,
     EXECUTE_STREAM_TAG = 55630,
-    STREAM_EXECUTED = 55631
+    STREAM_EXECUTED = 55631,
+    REPLY_GATHER_INFORMATION_BATCH_TAG = 55632
   };
 
   ///@{
@@ -135,6 +139,32 @@ protected:
   void GatherInformationInternal(
     vtkTypeUInt32 location, const char* classname, vtkTypeUInt32 globalid, vtkMultiProcessStream&);
 
+  /**
+   * Called when client triggers GatherInformationBatch(). All the requested
+   * information is sent back to the client in a single reply.
+   */
+  void GatherInformationBatchInternal(vtkMultiProcessStream&);
+
+  /**
+   * Processes a single message from the client, `type` being one of the
+   * message types above and `stream` holding its arguments.
+   */
+  void ProcessClientServerMessage(int type, vtkMultiProcessStream& stream);
+
+  /**
+   * Called when the client sends a batch of messages. The messages are
+   * processed in order. Streams to execute are part of the batch instead of
+   * being sent separately.
+   */
+  void ProcessMessageBatch(vtkMultiProcessStream&);
+
+  /**
+   * Gathers the information of type `classname` and serializes it into
+   * `reply`. Returns false if the information object could not be created.
+   */
+  bool GatherInformationToStream(vtkTypeUInt32 location, const char* classname,
+    vtkTypeUInt32 globalid, vtkMultiProcessStream& parameters, vtkClientServerStream& reply);
+
   /**
    * Sends the last result to client.
    */
@@ -4,24 +4,36 @@
 #include "vtkRemoteWriterHelper.h"
 
 #include "vtkAlgorithm.h"
+#include "vtkCallbackCommand.h"
 #include "vtkClientServerInterpreter.h"
 #include "vtkClientServerInterpreterInitializer.h"
 #include "vtkClientServerStream.h"
+#include "vtkCommand.h"
 #include "vtkDataObject.h"
+#include "vtkErrorCode.h"
+#include "vtkGenericMovieWriter.h"
 #include "vtkImageWriter.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkLogger.h"
 #include "vtkMultiProcessController.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPVSession.h"
 #include "vtkProcessModule.h"
+#include "vtkProgressObserver.h"
 #include "vtkSmartPointer.h"
 #include "vtkThreadedCallbackQueue.h"
 #include "vtksys/SystemTools.hxx"
 
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <memory>
 #include <mutex>
-#include <unordered_map>
+#include <string>
+#include <utility>
+#include <vector>
 
 vtkStandardNewMacro(vtkRemoteWriterHelper);
 vtkCxxSetObjectMacro(vtkRemoteWriterHelper, Writer, vtkAlgorithm);
@@ -29,45 +41,165 @@ vtkCxxSetObjectMacro(vtkRemoteWriterHelper, Interpreter, vtkClientServerInterpre
 
 namespace
 {
-using FutureContainer = std::unordered_map<std::string,
-  std::pair<int, vtkThreadedCallbackQueue::SharedFutureBasePointer>>;
+/**
+ * Input and outcome of a write running in the background. The input is
+ * released once written. The errors and warnings the writer reports are
+ * recorded here since neither the output window nor most observers may be used
+ * off the calling thread.
+ */
+struct WriteReport
+{
+  vtkSmartPointer<vtkDataObject> Input;
+  std::atomic<bool> Done{ false };
+  bool Success = true;
+  std::vector<std::pair<unsigned long, std::string>> Messages;
+};
+
+struct PendingWrite
+{
+  vtkThreadedCallbackQueue::SharedFutureBasePointer Future;
+  vtkSmartPointer<vtkAlgorithm> Writer;
+  std::string FileName;
+  std::shared_ptr<WriteReport> Report;
+};
 
 /**
- * This queue collects shared futures produced by the asynchronous callback queue
- * used to write the files that support this feature.
- * One can know that every enqueued files are written if this queue is empty or after calling
- * `Wait()` on each shared future
- * When a file has been written, its shared future in removed from this hash map
+ * Writes pushed to the callback queue, oldest first. A write depends on the
+ * previous one using the same writer, hence writes sharing a writer run in
+ * order and never concurrently. Entries are removed, and their messages
+ * reported, when they are waited for or when a new write is pushed after they
+ * are done.
  */
-FutureContainer SharedFutures;
-std::mutex FutureMutex;
+std::deque<PendingWrite> PendingWrites;
+std::mutex PendingWritesMutex;
+
+//----------------------------------------------------------------------------
+bool CanWriteInBackground(vtkAlgorithm* writer)
+{
+  return vtkImageWriter::SafeDownCast(writer) || vtkGenericMovieWriter::SafeDownCast(writer);
+}
 
-//============================================================================
-struct FutureWorker
+//----------------------------------------------------------------------------
+const char* GetWriterFileName(vtkAlgorithm* writer)
 {
-  FutureWorker(const std::string& fileName)
-    : TimeStamp(Counter++)
-    , FileName(fileName)
+  if (auto imageWriter = vtkImageWriter::SafeDownCast(writer))
+  {
+    return imageWriter->GetFileName();
+  }
+  if (auto movieWriter = vtkGenericMovieWriter::SafeDownCast(writer))
+  {
+    return movieWriter->GetFileName();
+  }
+  return nullptr;
+}
+
+//----------------------------------------------------------------------------
+// Runs on the callback queue.
+void RunWrite(vtkAlgorithm* writer, WriteReport* report)
+{
+  // hold back the messages of the writer, and mute its progress which may be
+  // observed by the progress handler.
+  vtkNew<vtkCallbackCommand> recorder;
+  recorder->SetClientData(report);
+  recorder->SetCallback(
+    [](vtkObject*, unsigned long eventId, void* clientData, void* callData)
+    {
+      auto writeReport = static_cast<WriteReport*>(clientData);
+      writeReport->Messages.emplace_back(
+        eventId, callData ? static_cast<const char*>(callData) : "");
+    });
+  recorder->AbortFlagOnExecuteOn();
+  const unsigned long errorTag =
+    writer->AddObserver(vtkCommand::ErrorEvent, recorder, VTK_FLOAT_MAX);
+  const unsigned long warningTag =
+    writer->AddObserver(vtkCommand::WarningEvent, recorder, VTK_FLOAT_MAX);
+  vtkNew<vtkProgressObserver> progressObserver;
+  writer->SetProgressObserver(progressObserver);
+
+  bool success = true;
+  writer->SetInputDataObject(report->Input);
+  if (auto imageWriter = vtkImageWriter::SafeDownCast(writer))
+  {
+    imageWriter->Write();
+  }
+  else if (auto movieWriter = vtkGenericMovieWriter::SafeDownCast(writer))
   {
+    movieWriter->Write();
+    success = movieWriter->GetError() == 0;
   }
+  writer->SetInputDataObject(nullptr);
+  report->Input = nullptr;
+
+  writer->SetProgressObserver(nullptr);
+  writer->RemoveObserver(errorTag);
+  writer->RemoveObserver(warningTag);
+
+  report->Success = success && writer->GetErrorCode() == vtkErrorCode::NoError &&
+    std::none_of(report->Messages.begin(), report->Messages.end(),
+      [](const std::pair<unsigned long, std::string>& message)
+      { return message.first == vtkCommand::ErrorEvent; });
+  report->Done = true;
+}
 
-  void operator()(vtkImageWriter* writer)
+//----------------------------------------------------------------------------
+// Reports the messages of a write on the calling thread.
+bool ReportWrite(const PendingWrite& write)
+{
+  vtkAlgorithm* writer = write.Writer;
+  for (const auto& message : write.Report->Messages)
   {
-    writer->Write();
-    std::lock_guard<std::mutex> lock(FutureMutex);
-    auto it = SharedFutures.find(vtksys::SystemTools::CollapseFullPath(this->FileName));
-    if (it->second.first == this->TimeStamp)
+    if (message.first == vtkCommand::ErrorEvent)
+    {
+      vtkErrorWithObjectMacro(
+        writer, "Failed to write '" << write.FileName << "': " << message.second);
+    }
+    else
     {
-      SharedFutures.erase(it);
+      vtkWarningWithObjectMacro(
+        writer, "While writing '" << write.FileName << "': " << message.second);
     }
   }
+  if (!write.Report->Success && write.Report->Messages.empty())
+  {
+    vtkErrorWithObjectMacro(writer, "Failed to write '" << write.FileName << "'.");
+  }
+  return write.Report->Success;
+}
 
-  static std::atomic_int Counter;
-  int TimeStamp;
-  std::string FileName;
-};
+//----------------------------------------------------------------------------
+// Removes the pending writes matching `predicate`, in order, then waits for
+// them and reports their messages. Returns false if any of them failed.
+template <typename PredicateT>
+bool FinishWrites(PredicateT&& predicate)
+{
+  std::vector<PendingWrite> writes;
+  {
+    std::lock_guard<std::mutex> lock(PendingWritesMutex);
+    std::deque<PendingWrite> remaining;
+    for (auto& write : PendingWrites)
+    {
+      if (predicate(write))
+      {
+        writes.push_back(std::move(write));
+      }
+      else
+      {
+        remaining.push_back(std::move(write));
+      }
+    }
+    PendingWrites.swap(remaining);
+  }
 
-std::atomic_int FutureWorker::Counter{ 0 };
+  // messages are reported without holding the lock since their observers may
+  // wait for other writes.
+  bool success = true;
+  for (const auto& write : writes)
+  {
+    write.Future->Wait();
+    success &= ::ReportWrite(write);
+  }
+  return success;
+}
 }
 
 //----------------------------------------------------------------------------
@@ -109,38 +241,26 @@ int vtkRemoteWriterHelper::RequestData(
     vtkPVSession::SafeDownCast(vtkProcessModule::GetProcessModule()->GetActiveSession());
   const vtkPVSession::ServerFlags roles = session->GetProcessRoles();
 
-  vtkThreadedCallbackQueue* callbackQueue =
-    vtkProcessModule::GetProcessModule()->GetCallbackQueue();
-
-  auto writeLocally = [this, callbackQueue](vtkSmartPointer<vtkDataObject>&& input)
+  auto writeLocally = [this](vtkDataObject* input)
   {
-    if (!this->TryWritingInBackground)
+    if (this->TryWritingInBackground && ::CanWriteInBackground(this->Writer))
     {
-      this->WriteLocally(input);
-    }
-    else if (auto imageWriter =
-               vtkSmartPointer<vtkImageWriter>(vtkImageWriter::SafeDownCast(this->Writer)))
-    {
-      this->Writer->SetInputDataObject(std::move(input));
+      if (this->GetState() == vtkRemoteWriterHelper::WRITE)
       {
-        if (this->GetState() != vtkRemoteWriterHelper::WRITE)
-        {
-          return;
-        }
-        ::FutureWorker worker{ imageWriter->GetFileName() };
-        // We need to lock guard modifying SharedFutures because the function
-        // we are pushing removes its futures from it in an asynchronous way
-        std::lock_guard<std::mutex> lock(::FutureMutex);
-        auto future = callbackQueue->Push(worker, imageWriter);
-        worker.FileName = imageWriter->GetFileName();
-        ::SharedFutures.emplace(vtksys::SystemTools::CollapseFullPath(imageWriter->GetFileName()),
-          std::make_pair(worker.TimeStamp, future));
+        this->WriteInBackground(input);
+        return;
+      }
+      if (vtkImageWriter::SafeDownCast(this->Writer))
+      {
+        // image writers have nothing to start or end.
+        return;
       }
     }
-    else
-    {
-      this->WriteLocally(input);
-    }
+
+    // movie writers must be done with the frames written in the background
+    // before the stream is ended.
+    vtkRemoteWriterHelper::Wait(this->Writer);
+    this->WriteLocally(input);
   };
 
   if (this->OutputDestination != vtkPVSession::CLIENT &&
@@ -203,24 +323,34 @@ int vtkRemoteWriterHelper::RequestData(
 }
 
 //----------------------------------------------------------------------------
-void vtkRemoteWriterHelper::Wait(const std::string& fileName)
+bool vtkRemoteWriterHelper::Wait(const std::string& fileName)
 {
-  auto it = ::SharedFutures.find(vtksys::SystemTools::CollapseFullPath(fileName));
-  if (it != ::SharedFutures.end())
-  {
-    it->second.second->Wait();
-  }
+  const std::string fullPath = vtksys::SystemTools::CollapseFullPath(fileName);
+  return ::FinishWrites([&](const ::PendingWrite& write) { return write.FileName == fullPath; });
+}
+
+//----------------------------------------------------------------------------
+bool vtkRemoteWriterHelper::Wait()
+{
+  return ::FinishWrites([](const ::PendingWrite&) { return true; });
 }
 
 //----------------------------------------------------------------------------
-void vtkRemoteWriterHelper::Wait()
+bool vtkRemoteWriterHelper::Wait(vtkAlgorithm* writer, int maxPending)
 {
-  std::vector<vtkThreadedCallbackQueue::SharedFutureBasePointer> filenames;
-  for (auto& item : ::SharedFutures)
+  if (writer == nullptr)
   {
-    filenames.push_back(item.second.second);
+    return true;
   }
-  vtkProcessModule::GetProcessModule()->GetCallbackQueue()->Wait(filenames);
+
+  int numberToWait = -std::max(maxPending, 0);
+  {
+    std::lock_guard<std::mutex> lock(::PendingWritesMutex);
+    numberToWait += static_cast<int>(std::count_if(::PendingWrites.begin(),
+      ::PendingWrites.end(), [&](const ::PendingWrite& write) { return write.Writer == writer; }));
+  }
+  return ::FinishWrites([&](const ::PendingWrite& write)
+    { return write.Writer == writer && numberToWait-- > 0; });
 }
 
 //----------------------------------------------------------------------------
@@ -257,6 +387,38 @@ void vtkRemoteWriterHelper::WriteLocally(vtkDataObject* input)
   }
 }
 
+//----------------------------------------------------------------------------
+void vtkRemoteWriterHelper::WriteInBackground(vtkDataObject* input)
+{
+  // report the writes done since the last one was pushed.
+  ::FinishWrites([](const ::PendingWrite& write) { return write.Report->Done.load(); });
+
+  ::PendingWrite write;
+  write.Writer = this->Writer;
+  write.Report = std::make_shared<::WriteReport>();
+  write.Report->Input = input;
+  if (const char* fileName = ::GetWriterFileName(this->Writer))
+  {
+    write.FileName = vtksys::SystemTools::CollapseFullPath(fileName);
+  }
+
+  vtkLogF(TRACE, "Writing file in the background using writer %s", vtkLogIdentifier(this->Writer));
+  std::lock_guard<std::mutex> lock(::PendingWritesMutex);
+  std::vector<vtkThreadedCallbackQueue::SharedFutureBasePointer> previousWrites;
+  auto previous = std::find_if(::PendingWrites.rbegin(), ::PendingWrites.rend(),
+    [&](const ::PendingWrite& pending) { return pending.Writer == write.Writer; });
+  if (previous != ::PendingWrites.rend())
+  {
+    previousWrites.push_back(previous->Future);
+  }
+
+  vtkThreadedCallbackQueue* callbackQueue =
+    vtkProcessModule::GetProcessModule()->GetCallbackQueue();
+  write.Future = callbackQueue->PushDependent(std::move(previousWrites),
+    [writer = write.Writer, report = write.Report]() { ::RunWrite(writer, report.get()); });
+  ::PendingWrites.push_back(std::move(write));
+}
+
 //----------------------------------------------------------------------------
 int vtkRemoteWriterHelper::Write()
 {
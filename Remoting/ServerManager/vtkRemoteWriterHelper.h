@@ -60,8 +60,15 @@ public:
   ///@{
   /**
    * If set to true, this helper will attempt writing the file in the background in parallel.
-   * As of today, only images can go this path (.jpeg, .png, etc.). Otherwise, writing a file will
-   * happen serially in all circumstances.
+   * As of today, only image writers (vtkImageWriter subclasses) and movie writers
+   * (vtkGenericMovieWriter subclasses) can go this path, and only in the WRITE state. Writes
+   * using the same writer run one at a time, in the order they were requested, hence frames of a
+   * movie can be written in the background too. The START and END states of movie writers wait
+   * for the pending frames and are processed serially. Otherwise, writing a file will happen
+   * serially in all circumstances.
+   *
+   * Errors and warnings reported by the writer in the background are held back and reported on
+   * the calling thread by the `Wait` functions, or by the next write in the background.
    */
   vtkSetMacro(TryWritingInBackground, bool);
   vtkGetMacro(TryWritingInBackground, bool);
@@ -110,17 +117,25 @@ public:
   /**
    * Wait until `fileName` has finished being written. If the file has been written in the
    * background in parallel, this thread might hang if the file is not finished being written.
-   * Otherwise, there is no waiting.
+   * Otherwise, there is no waiting. Returns false if writing the file in the background failed.
    *
    * @param fileName File name to wait for. It can be provided with its absolute or relative path
    * regardless.
    */
-  static void Wait(const std::string& fileName);
+  static bool Wait(const std::string& fileName);
+
+  /**
+   * Wait for all files being written in the background to finish. Returns false if any of them
+   * failed.
+   */
+  static bool Wait();
 
   /**
-   * Wait for all jobs saving screenshot to finish.
+   * Wait until at most `maxPending` writes using `writer` are left in the background, oldest
+   * first. A writer must not be modified, e.g. given another file name, while it has pending
+   * writes. Returns false if any of the waited writes failed.
    */
-  static void Wait();
+  static bool Wait(vtkAlgorithm* writer, int maxPending = 0);
 
   /**
    * Write the data.
@@ -140,6 +155,12 @@ protected:
    */
   void WriteLocally(vtkDataObject* input);
 
+  /**
+   * Internal method that pushes writing `input` with this->Writer to the process module's
+   * callback queue, after the pending writes using the same writer.
+   */
+  void WriteInBackground(vtkDataObject* input);
+
   vtkTypeUInt32 OutputDestination = vtkPVSession::CLIENT;
   int State = WRITE;
   vtkAlgorithm* Writer = nullptr;
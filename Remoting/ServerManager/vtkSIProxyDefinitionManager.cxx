@@ -12,6 +12,7 @@
 #include "vtkPVProxyDefinitionIterator.h"
 #include "vtkPVServerManagerPluginInterface.h"
 #include "vtkPVSession.h"
+#include "vtkPVVersion.h"
 #include "vtkPVXMLElement.h"
 #include "vtkPVXMLParser.h"
 #include "vtkProcessModule.h"
@@ -22,14 +23,19 @@
 #include "vtkTimerLog.h"
 
 #include <cassert>
+#include <cstdio>
+#include <fstream>
 #include <iostream>
 #include <map>
+#include <random>
 #include <set>
 #include <sstream>
 #include <string>
 #include <vector>
 
+#include <vtksys/MD5.h>
 #include <vtksys/RegularExpression.hxx>
+#include <vtksys/SystemTools.hxx>
 
 //****************************************************************************/
 //                    Internal Classes and typedefs
@@ -38,6 +44,112 @@ typedef vtkSmartPointer<vtkPVXMLElement> XMLElement;
 typedef std::map<std::string, XMLElement> StrToXmlMap;
 typedef std::map<std::string, StrToXmlMap> StrToStrToXmlMap;
 
+namespace
+{
+std::string& vtkDefinitionCacheDirectory()
+{
+  static const char* env = vtksys::SystemTools::GetEnv("PARAVIEW_PROXY_DEFINITION_CACHE_DIRECTORY");
+  static std::string directory = env ? env : "";
+  return directory;
+}
+
+/**
+ * Returns a tag identifying the platform, byte order and pointer size, since
+ * the binary form of the cached definitions is not portable.
+ */
+std::string vtkDefinitionCacheABI()
+{
+  const vtkTypeUInt32 one = 1;
+  const bool littleEndian = *reinterpret_cast<const unsigned char*>(&one) == 1;
+#if defined(_WIN32)
+  std::string abi = "windows";
+#elif defined(__APPLE__)
+  std::string abi = "macos";
+#else
+  std::string abi = "unix";
+#endif
+  abi += littleEndian ? "-le" : "-be";
+  abi += std::to_string(sizeof(void*) * 8);
+  return abi;
+}
+
+/**
+ * Returns the MD5 checksum of a configuration XML, as hexadecimal.
+ */
+std::string vtkDefinitionCacheChecksum(const std::string& content)
+{
+  vtksysMD5* md5 = vtksysMD5_New();
+  vtksysMD5_Initialize(md5);
+  vtksysMD5_Append(
+    md5, reinterpret_cast<const unsigned char*>(content.c_str()), static_cast<int>(content.size()));
+  char checksum[33];
+  vtksysMD5_FinalizeHex(md5, checksum);
+  checksum[32] = '\0';
+  vtksysMD5_Delete(md5);
+  return checksum;
+}
+
+/**
+ * Parses a server-manager configuration XML. When a cache directory is set,
+ * the parsed element is restored from the binary cache if available, and saved
+ * in it otherwise.
+ */
+vtkSmartPointer<vtkPVXMLElement> vtkParseConfigurationXML(const char* xmlContent)
+{
+  const std::string& directory = vtkDefinitionCacheDirectory();
+  std::string cacheFile;
+  std::string header;
+  if (!directory.empty())
+  {
+    const std::string key =
+      vtkDefinitionCacheChecksum(xmlContent) + "-" + vtkDefinitionCacheABI();
+    cacheFile = directory + "/" + key + ".pvdefinitions";
+    header = "paraview version " PARAVIEW_VERSION_FULL " " + key;
+
+    std::ifstream input(cacheFile, std::ios::in | std::ios::binary);
+    std::string fileHeader;
+    if (input && std::getline(input, fileHeader) && fileHeader == header)
+    {
+      auto root = vtkSmartPointer<vtkPVXMLElement>::New();
+      if (root->LoadBinary(input))
+      {
+        return root;
+      }
+    }
+  }
+
+  vtkNew<vtkPVXMLParser> parser;
+  if (!parser->Parse(xmlContent))
+  {
+    return nullptr;
+  }
+  vtkSmartPointer<vtkPVXMLElement> root = parser->GetRootElement();
+
+  if (!cacheFile.empty() && root)
+  {
+    // Many processes may start at once: write to a temporary file and rename
+    // it so that readers never see a partially written file.
+    vtksys::SystemTools::MakeDirectory(directory);
+    const std::string tempFile = cacheFile + "." + std::to_string(std::random_device{}()) + ".tmp";
+    bool written = false;
+    {
+      std::ofstream output(tempFile, std::ios::out | std::ios::binary);
+      if (output)
+      {
+        output << header << "\n";
+        root->SaveBinary(output);
+        written = static_cast<bool>(output);
+      }
+    }
+    if (!written || std::rename(tempFile.c_str(), cacheFile.c_str()) != 0)
+    {
+      std::remove(tempFile.c_str());
+    }
+  }
+  return root;
+}
+}
+
 class vtkSIProxyDefinitionManager::vtkInternals
 {
 public:
@@ -802,9 +914,8 @@ bool vtkSIProxyDefinitionManager::LoadConfigurationXMLFromString(const char* xml
 bool vtkSIProxyDefinitionManager::LoadConfigurationXMLFromString(
   const char* xmlContent, bool attachHints, bool invoke, const std::string& ensurePluginLoaded)
 {
-  vtkNew<vtkPVXMLParser> parser;
-  return (parser->Parse(xmlContent) != 0) &&
-    this->LoadConfigurationXML(parser->GetRootElement(), attachHints, invoke, ensurePluginLoaded);
+  vtkSmartPointer<vtkPVXMLElement> root = vtkParseConfigurationXML(xmlContent);
+  return root && this->LoadConfigurationXML(root, attachHints, invoke, ensurePluginLoaded);
 }
 
 //---------------------------------------------------------------------------
@@ -872,6 +983,18 @@ void vtkSIProxyDefinitionManager::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
 }
+
+//---------------------------------------------------------------------------
+void vtkSIProxyDefinitionManager::SetDefinitionCacheDirectory(const std::string& directory)
+{
+  vtkDefinitionCacheDirectory() = directory;
+}
+
+//---------------------------------------------------------------------------
+std::string vtkSIProxyDefinitionManager::GetDefinitionCacheDirectory()
+{
+  return vtkDefinitionCacheDirectory();
+}
 //---------------------------------------------------------------------------
 // vtkSIProxyDefinitionManager::ALL_DEFINITIONS    = 0
 // vtkSIProxyDefinitionManager::CORE_DEFINITIONS   = 1
@@ -33,6 +33,8 @@
 #include "vtkRemotingServerManagerModule.h" //needed for exports
 #include "vtkSIObject.h"
 
+#include <string> // for std::string
+
 class vtkPVPlugin;
 class vtkPVProxyDefinitionIterator;
 class vtkPVXMLElement;
@@ -145,6 +147,23 @@ public:
   bool LoadConfigurationXMLFromString(const char* xmlContent);
   ///@}
 
+  ///@{
+  /**
+   * Directory where the server-manager configuration XMLs, i.e. the core ones
+   * and those provided by plugins, are cached in binary form once parsed.
+   * Restoring a cached configuration is much faster than parsing it, which
+   * reduces the startup time of every process sharing the directory. Cached
+   * files are keyed on the MD5 checksum of the XML content, the platform and
+   * the ParaView version, so they are never reused for another set of
+   * plugins, another platform or another build.
+   * An empty string, the default unless the
+   * `PARAVIEW_PROXY_DEFINITION_CACHE_DIRECTORY` environment variable is set,
+   * disables the cache. Must be set before creating the session.
+   */
+  static void SetDefinitionCacheDirectory(const std::string& directory);
+  static std::string GetDefinitionCacheDirectory();
+  ///@}
+
   enum Events
   {
     ProxyDefinitionsUpdated = 2000,
@@ -13,6 +13,7 @@
 #include "vtkSMCompoundSourceProxy.h"
 #include "vtkSMSession.h"
 #include "vtkTimerLog.h"
+#include "vtkWeakPointer.h"
 
 #include <sstream>
 
@@ -31,6 +32,13 @@ vtkSMOutputPort::~vtkSMOutputPort() = default;
 //----------------------------------------------------------------------------
 vtkPVDataInformation* vtkSMOutputPort::GetDataInformation()
 {
+  if (!this->DataInformationValid && this->DataInformationRequested && this->SourceProxy)
+  {
+    // completes the request queued by RequestDataInformation(), along with
+    // any other pending request.
+    this->SourceProxy->GetSession()->FlushPendingInformationRequests();
+  }
+
   if (!this->DataInformationValid)
   {
     std::ostringstream mystr;
@@ -44,6 +52,40 @@ vtkPVDataInformation* vtkSMOutputPort::GetDataInformation()
   return this->DataInformation;
 }
 
+//----------------------------------------------------------------------------
+void vtkSMOutputPort::RequestDataInformation()
+{
+  if (this->DataInformationValid || this->DataInformationRequested)
+  {
+    return;
+  }
+
+  vtkSMSourceProxy* source = this->SourceProxy;
+  if (!source || !source->GetSession() || source->GetLocation() == 0)
+  {
+    return;
+  }
+
+  // ensure that the proxy is created.
+  source->CreateVTKObjects();
+
+  this->DataInformation->SetPortNumber(this->PortIndex);
+  this->DataInformation->Initialize();
+  this->DataInformationRequested = true;
+
+  vtkWeakPointer<vtkSMOutputPort> self(this);
+  source->GetSession()->GatherInformationAsync(source->GetLocation(), this->DataInformation,
+    source->GetGlobalID(), [self](vtkPVInformation* info, bool) {
+      // ignore the reply if the information was invalidated meanwhile.
+      if (self && self->DataInformationRequested)
+      {
+        info->Modified();
+        self->DataInformationRequested = false;
+        self->DataInformationValid = true;
+      }
+    });
+}
+
 //----------------------------------------------------------------------------
 vtkPVDataInformation* vtkSMOutputPort::GetDataSetInformation()
 {
@@ -67,6 +109,9 @@ vtkPVTemporalDataInformation* vtkSMOutputPort::GetTemporalDataInformation()
   if (!this->TemporalDataInformationValid)
   {
     this->TemporalDataInformation->SetPortNumber(this->PortIndex);
+    // pick up the current value of the setting, the instance outlives it.
+    this->TemporalDataInformation->SetDistributeTimeStepsAcrossRanks(
+      vtkPVTemporalDataInformation::GetDefaultDistributeTimeStepsAcrossRanks());
     this->GatherInformation(this->TemporalDataInformation);
     this->TemporalDataInformationValid = true;
   }
@@ -240,6 +285,7 @@ const char* vtkSMOutputPort::GetDataClassName()
 void vtkSMOutputPort::InvalidateDataInformation()
 {
   this->DataInformationValid = false;
+  this->DataInformationRequested = false;
   this->ClassNameInformationValid = false;
   this->TemporalDataInformationValid = false;
   this->SubsetDataInformations.clear();
@@ -268,6 +314,8 @@ void vtkSMOutputPort::GatherInformation(vtkPVDataInformation* info)
 void vtkSMOutputPort::GatherTemporalDataInformation()
 {
   this->TemporalDataInformation->SetPortNumber(this->PortIndex);
+  this->TemporalDataInformation->SetDistributeTimeStepsAcrossRanks(
+    vtkPVTemporalDataInformation::GetDefaultDistributeTimeStepsAcrossRanks());
   this->GatherInformation(this->TemporalDataInformation);
   this->TemporalDataInformationValid = true;
 }
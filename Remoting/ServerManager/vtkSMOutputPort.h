@@ -49,6 +49,14 @@ public:
    */
   virtual vtkPVDataInformation* GetDataInformation();
 
+  /**
+   * Queues a request for the data information using
+   * vtkSMSession::GatherInformationAsync(), unless it is already valid. This
+   * lets applications batch the requests for several ports in a single round
+   * trip to the server. GetDataInformation() completes pending requests.
+   */
+  void RequestDataInformation();
+
   /**
    * Returns dataset information.
    * This is similar to GetDataInformation() but it adds more
@@ -181,6 +189,7 @@ protected:
 
   vtkNew<vtkPVDataInformation> DataInformation;
   bool DataInformationValid = false;
+  bool DataInformationRequested = false;
   bool DataSetInformationValid = false;
 
   vtkNew<vtkPVTemporalDataInformation> TemporalDataInformation;
@@ -7,6 +7,7 @@
 #include "vtkDebugLeaks.h"
 #include "vtkObjectFactory.h"
 #include "vtkPVCatalystSessionCore.h"
+#include "vtkPVInformation.h"
 #include "vtkPVServerInformation.h"
 #include "vtkPVSessionCore.h"
 #include "vtkProcessModule.h"
@@ -26,6 +27,7 @@
 
 #include <cassert>
 #include <sstream>
+#include <utility>
 #include <vtkNew.h>
 
 vtkStandardNewMacro(vtkSMSession);
@@ -198,6 +200,77 @@ bool vtkSMSession::IsMPIInitialized(vtkTypeUInt32)
   return vtkProcessModule::GetProcessModule()->IsMPIInitialized();
 }
 
+//----------------------------------------------------------------------------
+void vtkSMSession::GatherInformationAsync(vtkTypeUInt32 location, vtkPVInformation* information,
+  vtkTypeUInt32 globalid, GatherInformationCallback callback)
+{
+  if (!information)
+  {
+    vtkErrorMacro("Missing information object.");
+    return;
+  }
+
+  const bool firstRequest = this->PendingInformationRequests.empty();
+  this->PendingInformationRequests.push_back(
+    InformationRequest{ location, information, globalid, std::move(callback), false });
+  if (!this->GetDeferInformationRequests())
+  {
+    this->FlushPendingInformationRequests();
+  }
+  else if (firstRequest)
+  {
+    this->InvokeEvent(vtkSMSession::PendingInformationRequestsEvent);
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkSMSession::FlushPendingInformationRequests()
+{
+  while (!this->PendingInformationRequests.empty())
+  {
+    std::vector<InformationRequest> requests;
+    std::swap(requests, this->PendingInformationRequests);
+    this->GatherInformationBatch(requests);
+    for (auto& request : requests)
+    {
+      if (request.Callback)
+      {
+        request.Callback(request.Information, request.Status);
+      }
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkSMSession::BeginMessageBatch()
+{
+  ++this->MessageBatchDepth;
+}
+
+//----------------------------------------------------------------------------
+void vtkSMSession::EndMessageBatch()
+{
+  if (this->MessageBatchDepth <= 0)
+  {
+    vtkErrorMacro("EndMessageBatch() called without matching BeginMessageBatch().");
+    return;
+  }
+  if (--this->MessageBatchDepth == 0)
+  {
+    this->FlushMessageBatch();
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkSMSession::GatherInformationBatch(std::vector<InformationRequest>& requests)
+{
+  for (auto& request : requests)
+  {
+    request.Status =
+      this->GatherInformation(request.Location, request.Information, request.GlobalID);
+  }
+}
+
 //----------------------------------------------------------------------------
 void vtkSMSession::PrintSelf(ostream& os, vtkIndent indent)
 {
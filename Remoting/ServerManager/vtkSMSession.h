@@ -13,7 +13,12 @@
 #include "vtkNetworkAccessManager.h" // needed for vtkNetworkAccessManager::ConnectionResult.
 #include "vtkPVSessionBase.h"
 #include "vtkRemotingServerManagerModule.h" //needed for exports
+#include "vtkSmartPointer.h"                // needed for vtkSmartPointer
 
+#include <functional> // needed for std::function
+#include <vector>     // needed for std::vector
+
+class vtkPVInformation;
 class vtkSMCollaborationManager;
 class vtkSMProxyLocator;
 class vtkSMSessionProxyManager;
@@ -99,6 +104,93 @@ public:
    */
   virtual unsigned int GetRenderClientMode();
 
+  //---------------------------------------------------------------------------
+  // API for asynchronous information gathering.
+  //---------------------------------------------------------------------------
+
+  enum
+  {
+    /**
+     * Fired when a request is queued with GatherInformationAsync() while no
+     * other request is pending. Applications can observe it to call
+     * FlushPendingInformationRequests() on the next turn of their event loop.
+     */
+    PendingInformationRequestsEvent = 6790
+  };
+
+  /**
+   * Signature of the callback invoked once an information request queued with
+   * GatherInformationAsync() has been processed. `status` is false if the
+   * information could not be gathered.
+   */
+  using GatherInformationCallback = std::function<void(vtkPVInformation* information, bool status)>;
+
+  /**
+   * Queue a request to gather information about an object referred by the \c
+   * globalid, similar to GatherInformation(). The request is processed, and
+   * the callback invoked, on the next call to FlushPendingInformationRequests().
+   * Remote sessions send all the requests pending at that point to each server
+   * in a single message, instead of one round trip per request. Pending
+   * requests are also flushed before any other communication with the servers
+   * so that they reflect the state at the time they were queued.
+   * Sessions without remote servers process the request immediately.
+   *
+   * Only the requests made through this method are batched. Other information
+   * pulled from the servers, such as the array information, prominent values
+   * or timer information fetched by the Qt client, still uses one blocking
+   * GatherInformation() round trip each and flushes the pending requests
+   * first.
+   */
+  void GatherInformationAsync(vtkTypeUInt32 location, vtkPVInformation* information,
+    vtkTypeUInt32 globalid, GatherInformationCallback callback = nullptr);
+
+  /**
+   * Process all requests queued with GatherInformationAsync() and invoke their
+   * callbacks. Requests queued by the callbacks are processed as well.
+   */
+  void FlushPendingInformationRequests();
+
+  /**
+   * Returns true if requests queued with GatherInformationAsync() have not
+   * been processed yet.
+   */
+  bool HasPendingInformationRequests() const
+  {
+    return !this->PendingInformationRequests.empty();
+  }
+
+  //---------------------------------------------------------------------------
+  // API for batching messages sent to the servers.
+  //---------------------------------------------------------------------------
+
+  ///@{
+  /**
+   * Begin/end a batch of messages. Between these calls, remote sessions
+   * accumulate the state pushes, the streams executed without reply and the
+   * registration of server-side objects, and send them to each server in a
+   * single message instead of one message each. The batch is sent when the
+   * outermost EndMessageBatch() is called, and before any communication
+   * expecting a reply from the servers, so messages are always processed in
+   * the order they were issued. Requests expecting a reply, such as pulling
+   * property values or gathering information, are not deferred and still
+   * cost a round trip each. Calls can be nested. Sessions without remote
+   * servers process messages immediately.
+   */
+  void BeginMessageBatch();
+  void EndMessageBatch();
+  ///@}
+
+  /**
+   * Returns true between BeginMessageBatch() and EndMessageBatch().
+   */
+  bool GetIsBatchingMessages() const { return this->MessageBatchDepth > 0; }
+
+  /**
+   * Send the messages accumulated in the current batch, if any. Default
+   * implementation does nothing since messages are never accumulated.
+   */
+  virtual void FlushMessageBatch() {}
+
   //---------------------------------------------------------------------------
   // Undo/Redo related API.
   //---------------------------------------------------------------------------
@@ -303,6 +395,28 @@ protected:
    */
   void UpdateStateHistory(vtkSMMessage* msg);
 
+  struct InformationRequest
+  {
+    vtkTypeUInt32 Location;
+    vtkSmartPointer<vtkPVInformation> Information;
+    vtkTypeUInt32 GlobalID;
+    GatherInformationCallback Callback;
+    bool Status;
+  };
+
+  /**
+   * Returns true if GatherInformationAsync() should queue requests until the
+   * next FlushPendingInformationRequests(). Default implementation returns
+   * false, processing the requests immediately.
+   */
+  virtual bool GetDeferInformationRequests() { return false; }
+
+  /**
+   * Gathers the information for all the requests and sets their Status.
+   * Default implementation calls GatherInformation() for each request.
+   */
+  virtual void GatherInformationBatch(std::vector<InformationRequest>& requests);
+
   vtkSMSessionProxyManager* SessionProxyManager;
   vtkSMStateLocator* StateLocator;
   vtkSMProxyLocator* ProxyLocator;
@@ -310,6 +424,9 @@ protected:
 private:
   vtkSMSession(const vtkSMSession&) = delete;
   void operator=(const vtkSMSession&) = delete;
+
+  std::vector<InformationRequest> PendingInformationRequests;
+  int MessageBatchDepth = 0;
 };
 
 #endif
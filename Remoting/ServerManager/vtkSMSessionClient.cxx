@@ -39,6 +39,8 @@
 #include <cassert>
 #include <iostream>
 #include <set>
+#include <utility>
+#include <vector>
 
 //****************************************************************************/
 //                    Internal Classes and typedefs
@@ -530,6 +532,7 @@ bool vtkSMSessionClient::IsMPIInitialized(vtkTypeUInt32 servers)
 //----------------------------------------------------------------------------
 void vtkSMSessionClient::CloseSession()
 {
+  this->FlushMessageBatch();
   if (this->DataServerController)
   {
     this->DataServerController->TriggerRMIOnAllChildren(vtkPVSessionServer::CLOSE_SESSION);
@@ -580,8 +583,11 @@ void vtkSMSessionClient::PushState(vtkSMMessage* message)
     return;
   }
 
+  this->FlushPendingInformationRequests();
+
   vtkTypeUInt32 location = this->GetRealLocation(message->location());
   message->set_location(location);
+  const bool batch = this->BatchMessage(location, /*localOnlyUpdate=*/true);
   int num_controllers = 0;
   vtkMultiProcessController* controllers[2] = { nullptr, nullptr };
 
@@ -593,7 +599,16 @@ void vtkSMSessionClient::PushState(vtkSMMessage* message)
   {
     controllers[num_controllers++] = this->RenderServerController;
   }
-  if (num_controllers > 0)
+  if (num_controllers > 0 && batch)
+  {
+    const std::string serialized = message->SerializeAsString();
+    for (int cc = 0; cc < num_controllers; cc++)
+    {
+      this->AddToMessageBatch(
+        controllers[cc], BatchedMessage{ vtkPVSessionServer::PUSH, serialized, {}, false });
+    }
+  }
+  else if (num_controllers > 0)
   {
     vtkMultiProcessStream stream;
     stream << static_cast<int>(vtkPVSessionServer::PUSH);
@@ -666,6 +681,8 @@ void vtkSMSessionClient::PushState(vtkSMMessage* message)
 //----------------------------------------------------------------------------
 void vtkSMSessionClient::PullState(vtkSMMessage* message)
 {
+  this->FlushPendingInformationRequests();
+  this->FlushMessageBatch();
   this->StartBusyWork();
   vtkTypeUInt32 location = this->GetRealLocation(message->location());
   message->set_location(location);
@@ -722,7 +739,14 @@ void vtkSMSessionClient::ExecuteStream(
     return;
   }
 
+  this->FlushPendingInformationRequests();
+
   location = this->GetRealLocation(location);
+  const bool batch = !sendReply && this->BatchMessage(location);
+  if (sendReply)
+  {
+    this->FlushMessageBatch();
+  }
 
   vtkMultiProcessController* controllers[2] = { nullptr, nullptr };
   int num_controllers = 0;
@@ -735,7 +759,19 @@ void vtkSMSessionClient::ExecuteStream(
     controllers[num_controllers++] = this->RenderServerController;
   }
 
-  if (num_controllers > 0)
+  if (num_controllers > 0 && batch)
+  {
+    const unsigned char* data;
+    size_t size;
+    cssstream.GetData(&data, &size);
+    for (int cc = 0; cc < num_controllers; cc++)
+    {
+      this->AddToMessageBatch(controllers[cc],
+        BatchedMessage{ vtkPVSessionServer::EXECUTE_STREAM, std::string(),
+          std::vector<unsigned char>(data, data + size), ignoreErrors });
+    }
+  }
+  else if (num_controllers > 0)
   {
     const unsigned char* data;
     size_t size;
@@ -770,6 +806,8 @@ void vtkSMSessionClient::ExecuteStream(
 //----------------------------------------------------------------------------
 const vtkClientServerStream& vtkSMSessionClient::GetLastResult(vtkTypeUInt32 location)
 {
+  this->FlushPendingInformationRequests();
+  this->FlushMessageBatch();
   this->StartBusyWork();
   location = this->GetRealLocation(location);
 
@@ -802,10 +840,9 @@ const vtkClientServerStream& vtkSMSessionClient::GetLastResult(vtkTypeUInt32 loc
     // Get the reply
     int size = 0;
     controller->Receive(&size, 1, 1, vtkPVSessionServer::REPLY_LAST_RESULT);
-    unsigned char* raw_data = new unsigned char[size + 1];
-    controller->Receive(raw_data, size, 1, vtkPVSessionServer::REPLY_LAST_RESULT);
-    this->ServerLastInvokeResult->SetData(raw_data, size);
-    delete[] raw_data;
+    std::vector<unsigned char> raw_data(static_cast<size_t>(size));
+    controller->Receive(raw_data.data(), size, 1, vtkPVSessionServer::REPLY_LAST_RESULT);
+    this->ServerLastInvokeResult->SetData(std::move(raw_data));
     this->EndBusyWork();
     return *this->ServerLastInvokeResult;
   }
@@ -818,6 +855,8 @@ const vtkClientServerStream& vtkSMSessionClient::GetLastResult(vtkTypeUInt32 loc
 bool vtkSMSessionClient::GatherInformation(
   vtkTypeUInt32 location, vtkPVInformation* information, vtkTypeUInt32 globalid)
 {
+  this->FlushPendingInformationRequests();
+  this->FlushMessageBatch();
   this->StartBusyWork();
   if (this->RenderServerController == nullptr)
   {
@@ -909,6 +948,215 @@ bool vtkSMSessionClient::GatherInformation(
   return false;
 }
 
+//----------------------------------------------------------------------------
+void vtkSMSessionClient::GatherInformationBatch(std::vector<InformationRequest>& requests)
+{
+  this->FlushMessageBatch();
+  this->StartBusyWork();
+
+  // Requests are grouped per server so that each server receives a single
+  // message, in the order the requests were queued.
+  std::vector<std::pair<InformationRequest*, bool>> dataServerRequests;
+  std::vector<std::pair<InformationRequest*, bool>> renderServerRequests;
+  for (auto& request : requests)
+  {
+    const vtkTypeUInt32 location = this->GetRealLocation(request.Location);
+    request.Status = true;
+
+    bool add_local_info = false;
+    if ((location & vtkPVSession::CLIENT) != 0)
+    {
+      request.Status =
+        this->Superclass::GatherInformation(location, request.Information, request.GlobalID);
+      if (request.Information->GetRootOnly())
+      {
+        continue;
+      }
+      add_local_info = true;
+    }
+
+    if ((location & (vtkPVSession::DATA_SERVER | vtkPVSession::DATA_SERVER_ROOT)) != 0)
+    {
+      dataServerRequests.emplace_back(&request, add_local_info);
+    }
+    else if (this->RenderServerController != nullptr &&
+      (location & (vtkPVSession::RENDER_SERVER | vtkPVSession::RENDER_SERVER_ROOT)) != 0)
+    {
+      renderServerRequests.emplace_back(&request, add_local_info);
+    }
+  }
+
+  this->GatherServerInformationBatch(this->DataServerController, dataServerRequests);
+  this->GatherServerInformationBatch(this->RenderServerController, renderServerRequests);
+  this->EndBusyWork();
+}
+
+//----------------------------------------------------------------------------
+void vtkSMSessionClient::GatherServerInformationBatch(vtkMultiProcessController* controller,
+  const std::vector<std::pair<InformationRequest*, bool>>& requests)
+{
+  if (requests.empty())
+  {
+    return;
+  }
+  if (controller == nullptr)
+  {
+    for (const auto& item : requests)
+    {
+      item.first->Status = false;
+    }
+    return;
+  }
+
+  vtkMultiProcessStream stream;
+  stream << static_cast<int>(vtkPVSessionServer::GATHER_INFORMATION_BATCH)
+         << static_cast<int>(requests.size());
+  for (const auto& item : requests)
+  {
+    const InformationRequest* request = item.first;
+    stream << this->GetRealLocation(request->Location) << request->Information->GetClassName()
+           << request->GlobalID;
+
+    vtkMultiProcessStream parameters;
+    request->Information->CopyParametersToStream(parameters);
+    std::vector<unsigned char> raw_parameters;
+    parameters.GetRawData(raw_parameters);
+    stream.Push(raw_parameters.data(), static_cast<unsigned int>(raw_parameters.size()));
+  }
+  std::vector<unsigned char> raw_message;
+  stream.GetRawData(raw_message);
+  controller->TriggerRMIOnAllChildren(raw_message.data(), static_cast<int>(raw_message.size()),
+    vtkPVSessionServer::CLIENT_SERVER_MESSAGE_RMI);
+
+  vtkMultiProcessStream replyStream;
+  int count = 0;
+  if (!controller->Receive(replyStream, 1, vtkPVSessionServer::REPLY_GATHER_INFORMATION_BATCH_TAG))
+  {
+    vtkErrorMacro("Failed to receive information correctly.");
+  }
+  else
+  {
+    replyStream >> count;
+  }
+  if (count != static_cast<int>(requests.size()))
+  {
+    vtkErrorMacro("Server failed to gather information.");
+    for (const auto& item : requests)
+    {
+      item.first->Status = false;
+    }
+    return;
+  }
+
+  for (const auto& item : requests)
+  {
+    InformationRequest* request = item.first;
+    int status = 0;
+    replyStream >> status;
+    if (!status)
+    {
+      vtkErrorMacro("Server failed to gather information.");
+      request->Status = false;
+      continue;
+    }
+
+    unsigned char* data = nullptr;
+    unsigned int length = 0;
+    replyStream.Pop(data, length);
+    vtkClientServerStream csstream;
+    csstream.SetData(data, length);
+    delete[] data;
+    if (item.second)
+    {
+      vtkSmartPointer<vtkPVInformation> tempInfo;
+      tempInfo.TakeReference(request->Information->NewInstance());
+      tempInfo->CopyFromStream(&csstream);
+      request->Information->AddInformation(tempInfo);
+    }
+    else
+    {
+      request->Information->CopyFromStream(&csstream);
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+bool vtkSMSessionClient::BatchMessage(vtkTypeUInt32 location, bool localOnlyUpdate)
+{
+  if (!this->GetIsBatchingMessages() ||
+    ((location & vtkPVSession::CLIENT) != 0 && !localOnlyUpdate))
+  {
+    this->FlushMessageBatch();
+    return false;
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void vtkSMSessionClient::AddToMessageBatch(
+  vtkMultiProcessController* controller, BatchedMessage&& message)
+{
+  if (controller == nullptr)
+  {
+    return;
+  }
+  if (controller == this->RenderServerController && controller != this->DataServerController)
+  {
+    this->RenderServerBatch.push_back(std::move(message));
+  }
+  else
+  {
+    this->DataServerBatch.push_back(std::move(message));
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkSMSessionClient::FlushMessageBatch()
+{
+  this->SendMessageBatch(this->DataServerController, this->DataServerBatch);
+  this->SendMessageBatch(this->RenderServerController, this->RenderServerBatch);
+}
+
+//----------------------------------------------------------------------------
+void vtkSMSessionClient::SendMessageBatch(
+  vtkMultiProcessController* controller, std::vector<BatchedMessage>& batch)
+{
+  if (batch.empty())
+  {
+    return;
+  }
+  std::vector<BatchedMessage> messages;
+  std::swap(messages, batch);
+  if (controller == nullptr)
+  {
+    return;
+  }
+
+  vtkMultiProcessStream stream;
+  stream << static_cast<int>(vtkPVSessionServer::MESSAGE_BATCH)
+         << static_cast<int>(messages.size());
+  for (auto& message : messages)
+  {
+    stream << message.Type;
+    if (message.Type == vtkPVSessionServer::EXECUTE_STREAM)
+    {
+      stream << static_cast<int>(message.IgnoreErrors)
+             << static_cast<int>(message.StreamData.size());
+      stream.Push(message.StreamData.data(), static_cast<unsigned int>(message.StreamData.size()));
+    }
+    else
+    {
+      stream << message.Message;
+    }
+  }
+  std::vector<unsigned char> raw_message;
+  stream.GetRawData(raw_message);
+  controller->TriggerRMIOnAllChildren(raw_message.data(), static_cast<int>(raw_message.size()),
+    vtkPVSessionServer::CLIENT_SERVER_MESSAGE_RMI);
+  this->NumberOfBatchedMessages += static_cast<vtkIdType>(messages.size());
+  ++this->NumberOfMessageBatches;
+}
+
 //----------------------------------------------------------------------------
 void vtkSMSessionClient::UnRegisterSIObject(vtkSMMessage* message)
 {
@@ -917,9 +1165,12 @@ void vtkSMSessionClient::UnRegisterSIObject(vtkSMMessage* message)
     return;
   }
 
+  this->FlushPendingInformationRequests();
+
   vtkTypeUInt32 location = this->GetRealLocation(message->location());
   message->set_location(location);
   message->set_client_id(this->GetServerInformation()->GetClientId());
+  const bool batch = this->BatchMessage(location);
 
   vtkMultiProcessController* controllers[2] = { nullptr, nullptr };
   int num_controllers = 0;
@@ -931,7 +1182,16 @@ void vtkSMSessionClient::UnRegisterSIObject(vtkSMMessage* message)
   {
     controllers[num_controllers++] = this->RenderServerController;
   }
-  if (num_controllers > 0)
+  if (num_controllers > 0 && batch)
+  {
+    const std::string serialized = message->SerializeAsString();
+    for (int cc = 0; cc < num_controllers; cc++)
+    {
+      this->AddToMessageBatch(controllers[cc],
+        BatchedMessage{ vtkPVSessionServer::UNREGISTER_SI, serialized, {}, false });
+    }
+  }
+  else if (num_controllers > 0)
   {
     vtkMultiProcessStream stream;
     stream << static_cast<int>(vtkPVSessionServer::UNREGISTER_SI);
@@ -958,9 +1218,12 @@ void vtkSMSessionClient::RegisterSIObject(vtkSMMessage* message)
     return;
   }
 
+  this->FlushPendingInformationRequests();
+
   vtkTypeUInt32 location = this->GetRealLocation(message->location());
   message->set_location(location);
   message->set_client_id(this->GetServerInformation()->GetClientId());
+  const bool batch = this->BatchMessage(location);
 
   vtkMultiProcessController* controllers[2] = { nullptr, nullptr };
   int num_controllers = 0;
@@ -972,7 +1235,16 @@ void vtkSMSessionClient::RegisterSIObject(vtkSMMessage* message)
   {
     controllers[num_controllers++] = this->RenderServerController;
   }
-  if (num_controllers > 0)
+  if (num_controllers > 0 && batch)
+  {
+    const std::string serialized = message->SerializeAsString();
+    for (int cc = 0; cc < num_controllers; cc++)
+    {
+      this->AddToMessageBatch(
+        controllers[cc], BatchedMessage{ vtkPVSessionServer::REGISTER_SI, serialized, {}, false });
+    }
+  }
+  else if (num_controllers > 0)
   {
     vtkMultiProcessStream stream;
     stream << static_cast<int>(vtkPVSessionServer::REGISTER_SI);
@@ -14,6 +14,10 @@
 #include "vtkRemotingServerManagerModule.h" //needed for exports
 #include "vtkSMSession.h"
 
+#include <string>  // needed for std::string
+#include <utility> // needed for std::pair
+#include <vector>  // needed for std::vector
+
 class vtkMultiProcessController;
 class vtkPVServerInformation;
 class vtkSMCollaborationManager;
@@ -155,6 +159,16 @@ public:
    */
   bool IsMPIInitialized(vtkTypeUInt32 servers) override;
 
+  ///@{
+  /**
+   * Returns the number of messages sent to the servers as part of a batch,
+   * and the number of batches they were sent in, since the session was
+   * created. See vtkSMSession::BeginMessageBatch().
+   */
+  vtkGetMacro(NumberOfBatchedMessages, vtkIdType);
+  vtkGetMacro(NumberOfMessageBatches, vtkIdType);
+  ///@}
+
   //---------------------------------------------------------------------------
   // API for Collaboration management
   //---------------------------------------------------------------------------
@@ -247,6 +261,24 @@ protected:
    */
   vtkTypeUInt32 GetRealLocation(vtkTypeUInt32);
 
+  /**
+   * Overridden to queue requests made with GatherInformationAsync() until they
+   * are flushed.
+   */
+  bool GetDeferInformationRequests() override { return true; }
+
+  /**
+   * Overridden to send all the requests targeting a server in a single
+   * message, the server replying once for all of them.
+   */
+  void GatherInformationBatch(std::vector<InformationRequest>& requests) override;
+
+  /**
+   * Overridden to send the accumulated messages to each server in a single
+   * message.
+   */
+  void FlushMessageBatch() override;
+
   // Both maybe the same when connected to pvserver.
   vtkMultiProcessController* RenderServerController;
   vtkMultiProcessController* DataServerController;
@@ -285,7 +317,54 @@ private:
   vtkSMSessionClient(const vtkSMSessionClient&) = delete;
   void operator=(const vtkSMSessionClient&) = delete;
 
+  /**
+   * Sends the requests to the server using the given controller and reads
+   * back the information. The flag associated to each request tells whether
+   * the information gathered on the server must be added to the local one.
+   */
+  void GatherServerInformationBatch(vtkMultiProcessController* controller,
+    const std::vector<std::pair<InformationRequest*, bool>>& requests);
+
+  /**
+   * A message accumulated while batching messages. Type is the message type
+   * understood by vtkPVSessionServer, Message the serialized vtkSMMessage, and
+   * StreamData the content of the stream to execute for EXECUTE_STREAM.
+   */
+  struct BatchedMessage
+  {
+    int Type;
+    std::string Message;
+    std::vector<unsigned char> StreamData;
+    bool IgnoreErrors;
+  };
+
+  /**
+   * Returns true if a message targeting `location` must be added to the
+   * current batch. Messages also processed on the client are not batched,
+   * since processing them locally may require the servers to have processed
+   * them too: the current batch is sent first and they are sent immediately.
+   * `localOnlyUpdate` tells that the local processing of the message never
+   * communicates with the servers, as for state pushes, so that the part
+   * sent to the servers can be batched anyway.
+   */
+  bool BatchMessage(vtkTypeUInt32 location, bool localOnlyUpdate = false);
+
+  /**
+   * Adds a message to the batch of the given server.
+   */
+  void AddToMessageBatch(vtkMultiProcessController* controller, BatchedMessage&& message);
+
+  /**
+   * Sends the accumulated messages in a single message to the given server.
+   */
+  void SendMessageBatch(vtkMultiProcessController* controller, std::vector<BatchedMessage>& batch);
+
+  std::vector<BatchedMessage> DataServerBatch;
+  std::vector<BatchedMessage> RenderServerBatch;
+
   int NotBusy;
+  vtkIdType NumberOfBatchedMessages = 0;
+  vtkIdType NumberOfMessageBatches = 0;
   vtkTypeUInt32 LastGlobalID;
   vtkTypeUInt32 LastGlobalIDAvailable;
 };
@@ -8,6 +8,7 @@
 #include "vtkSMProperty.h"
 #include "vtkSMProxyLink.h"
 #include "vtkSMProxyLocator.h"
+#include "vtkSMSession.h"
 #include "vtkSMSessionProxyManager.h"
 #include "vtkSMSettingsProxy.h"
 #include "vtkSMSourceProxy.h"
@@ -529,9 +530,23 @@ int vtkSMStateLoader::LoadState(vtkPVXMLElement* elem, bool keepOriginalId)
     return 0;
   }
 
+  // Proxies are created and their properties pushed one at a time: batch the
+  // resulting one-way messages so that they reach remote servers in a few
+  // messages. Requests expecting a reply, e.g. pulling property values or
+  // gathering information, are not deferred: they send the pending batch and
+  // still cost a round trip each.
+  vtkSMSession* session = pxm->GetSession();
+  if (this->BatchMessages)
+  {
+    session->BeginMessageBatch();
+  }
   this->ProxyLocator->SetDeserializer(this);
   int ret = this->LoadStateInternal(elem);
   this->ProxyLocator->SetDeserializer(nullptr);
+  if (this->BatchMessages)
+  {
+    session->EndMessageBatch();
+  }
 
   // BUG #10650. When animation scene time ranges are read from the state, they
   // often override those that the timekeeper painstakingly computed. Here we
@@ -725,6 +740,7 @@ int vtkSMStateLoader::LoadStateInternal(vtkPVXMLElement* parent)
 void vtkSMStateLoader::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "BatchMessages: " << this->BatchMessages << endl;
 }
 
 //---------------------------------------------------------------------------
@@ -56,6 +56,17 @@ public:
   vtkBooleanMacro(KeepIdMapping, int);
   ///@}
 
+  ///@{
+  /**
+   * When true, the one-way messages sent to remote servers while loading the
+   * state are accumulated and sent in as few messages as possible, see
+   * vtkSMSession::BeginMessageBatch(). Default is true.
+   */
+  vtkSetMacro(BatchMessages, bool);
+  vtkGetMacro(BatchMessages, bool);
+  vtkBooleanMacro(BatchMessages, bool);
+  ///@}
+
   ///@{
   /**
    * Return an array of ids. The ids are stored in the following order
@@ -153,6 +164,7 @@ protected:
   vtkPVXMLElement* ServerManagerStateElement;
   vtkSMProxyLocator* ProxyLocator;
   int KeepIdMapping;
+  bool BatchMessages = true;
 
 private:
   vtkSMStateLoader(const vtkSMStateLoader&) = delete;
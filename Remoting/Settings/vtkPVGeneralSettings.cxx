@@ -5,6 +5,7 @@
 
 #include "vtkObjectFactory.h"
 #include "vtkPVSession.h"
+#include "vtkPVTemporalDataInformation.h"
 #include "vtkProcessModule.h"
 #include "vtkSMPTools.h"
 #include "vtkThreadedCallbackQueue.h"
@@ -107,6 +108,18 @@ void vtkPVGeneralSettings::SetNumberOfSMPThreads(int n)
   }
 }
 
+//----------------------------------------------------------------------------
+bool vtkPVGeneralSettings::GetDistributeTemporalInformationAcrossRanks()
+{
+  return vtkPVTemporalDataInformation::GetDefaultDistributeTimeStepsAcrossRanks();
+}
+
+//----------------------------------------------------------------------------
+void vtkPVGeneralSettings::SetDistributeTemporalInformationAcrossRanks(bool value)
+{
+  vtkPVTemporalDataInformation::SetDefaultDistributeTimeStepsAcrossRanks(value);
+}
+
 //----------------------------------------------------------------------------
 void vtkPVGeneralSettings::PrintSelf(ostream& os, vtkIndent indent)
 {
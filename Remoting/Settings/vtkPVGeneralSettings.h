@@ -371,6 +371,18 @@ public:
   static void SetNumberOfSMPThreads(int);
   ///@}
 
+  ///@{
+  /**
+   * When true, the information gathered over all timesteps is computed by
+   * splitting the timesteps across ranks, each rank executing the pipeline for
+   * the whole dataset. Forwards to
+   * `vtkPVTemporalDataInformation::SetDefaultDistributeTimeStepsAcrossRanks`.
+   * Default is false.
+   */
+  static bool GetDistributeTemporalInformationAcrossRanks();
+  static void SetDistributeTemporalInformationAcrossRanks(bool);
+  ///@}
+
 protected:
   vtkPVGeneralSettings() = default;
   ~vtkPVGeneralSettings() override = default;
@@ -0,0 +1,93 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkLogger.h"
+#include "vtkPVRenderView.h"
+
+#include <cstdlib>
+
+#define VERIFY(x, y)                                                                               \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    vtkLogF(ERROR, y);                                                                             \
+    return EXIT_FAILURE;                                                                           \
+  }
+
+namespace
+{
+const double TargetTime = 0.1;
+const double SlowRender = 0.2;
+const double FastRender = 0.01;
+const int NumberOfLODLevels = 3;
+const int MinimumFactor = 2;
+const int MaximumFactor = 4;
+
+void Adapt(double renderTime, bool usedLOD, bool usedRemoteRendering, int state[2])
+{
+  vtkPVRenderView::AdaptRenderingState(TargetTime, renderTime, usedLOD, usedRemoteRendering,
+    NumberOfLODLevels, MinimumFactor, MaximumFactor, state);
+}
+}
+
+extern int TestAdaptiveRenderingState(int, char*[])
+{
+  int state[2] = { 0, MinimumFactor };
+
+  // Renders within the hysteresis band keep the current state.
+  ::Adapt(TargetTime, true, true, state);
+  VERIFY(state[0] == 0 && state[1] == MinimumFactor, "State changed within the target.");
+
+  // Slow renders first use coarser LOD levels, then larger image reduction
+  // factors, until both reach their maximum.
+  for (int level = 1; level < NumberOfLODLevels; ++level)
+  {
+    ::Adapt(SlowRender, true, true, state);
+    VERIFY(state[0] == level && state[1] == MinimumFactor, "Expected a coarser LOD level.");
+  }
+  for (int factor = MinimumFactor + 1; factor <= MaximumFactor; ++factor)
+  {
+    ::Adapt(SlowRender, true, true, state);
+    VERIFY(state[0] == NumberOfLODLevels - 1 && state[1] == factor,
+      "Expected a larger image reduction factor.");
+  }
+  ::Adapt(SlowRender, true, true, state);
+  VERIFY(state[0] == NumberOfLODLevels - 1 && state[1] == MaximumFactor,
+    "State exceeded its maximum.");
+
+  // Fast renders undo these steps in reverse order.
+  for (int factor = MaximumFactor - 1; factor >= MinimumFactor; --factor)
+  {
+    ::Adapt(FastRender, true, true, state);
+    VERIFY(state[0] == NumberOfLODLevels - 1 && state[1] == factor,
+      "Expected a smaller image reduction factor.");
+  }
+  for (int level = NumberOfLODLevels - 2; level >= 0; --level)
+  {
+    ::Adapt(FastRender, true, true, state);
+    VERIFY(state[0] == level && state[1] == MinimumFactor, "Expected a finer LOD level.");
+  }
+  ::Adapt(FastRender, true, true, state);
+  VERIFY(state[0] == 0 && state[1] == MinimumFactor, "State went below its minimum.");
+
+  // Without LOD, slow renders directly use larger image reduction factors.
+  ::Adapt(SlowRender, false, true, state);
+  VERIFY(state[0] == 0 && state[1] == MinimumFactor + 1,
+    "Expected a larger image reduction factor without LOD.");
+
+  // The image reduction factor has no effect on local renders, so it is reset
+  // and never raised for them.
+  ::Adapt(SlowRender, false, false, state);
+  VERIFY(state[0] == 0 && state[1] == MinimumFactor, "Image reduction factor was not reset.");
+  ::Adapt(SlowRender, false, false, state);
+  VERIFY(state[0] == 0 && state[1] == MinimumFactor,
+    "Image reduction factor was raised for a local render.");
+  ::Adapt(SlowRender, true, false, state);
+  VERIFY(state[0] == 1 && state[1] == MinimumFactor, "Expected a coarser LOD level.");
+
+  // Out of range states, e.g. after NumberOfLODLevels was reduced, are clamped.
+  state[0] = NumberOfLODLevels + 2;
+  state[1] = MaximumFactor + 2;
+  ::Adapt(TargetTime, true, true, state);
+  VERIFY(state[0] == NumberOfLODLevels - 1 && state[1] == MaximumFactor, "State not clamped.");
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,97 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkGeometryRepresentation.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPolyData.h"
+#include "vtkSphereSource.h"
+
+#include <cstdlib>
+#include <vector>
+
+#define VERIFY(x, y)                                                                               \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    vtkLogF(ERROR, y);                                                                             \
+    return EXIT_FAILURE;                                                                           \
+  }
+
+namespace
+{
+// Exposes the LOD pyramid of vtkGeometryRepresentation.
+class TestGeometryRepresentation : public vtkGeometryRepresentation
+{
+public:
+  static TestGeometryRepresentation* New();
+  vtkTypeMacro(TestGeometryRepresentation, vtkGeometryRepresentation);
+  using vtkGeometryRepresentation::GetDecimatedLOD;
+};
+vtkStandardNewMacro(TestGeometryRepresentation);
+
+vtkIdType GetNumberOfPoints(vtkDataObject* data)
+{
+  auto polyData = vtkPolyData::SafeDownCast(data);
+  return polyData ? polyData->GetNumberOfPoints() : -1;
+}
+}
+
+extern int TestGeometryRepresentationLODLevels(int, char*[])
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(512);
+  sphere->SetPhiResolution(512);
+  sphere->Update();
+  vtkNew<vtkPolyData> data;
+  data->ShallowCopy(sphere->GetOutput());
+
+  vtkNew<TestGeometryRepresentation> repr;
+  const int numberOfLevels = 4;
+
+  // Each level must be built from the previous one and be coarser than it.
+  std::vector<vtkDataObject*> levels;
+  vtkIdType previous = data->GetNumberOfPoints();
+  for (int level = 0; level < numberOfLevels; ++level)
+  {
+    vtkDataObject* lod = repr->GetDecimatedLOD(data, 0.5, level);
+    const vtkIdType numberOfPoints = ::GetNumberOfPoints(lod);
+    VERIFY(numberOfPoints > 0, "Empty LOD level.");
+    VERIFY(numberOfPoints < previous, "LOD level is not coarser than the previous one.");
+    previous = numberOfPoints;
+    levels.push_back(lod);
+  }
+
+  // Levels are cached: asking for any level again must not decimate again.
+  for (int level = numberOfLevels - 1; level >= 0; --level)
+  {
+    VERIFY(repr->GetDecimatedLOD(data, 0.5, level) == levels[level], "LOD level was rebuilt.");
+  }
+
+  // Asking for a coarse level first builds all the finer ones too, and gives
+  // the same geometry as building them one after the other.
+  vtkNew<TestGeometryRepresentation> repr2;
+  vtkDataObject* coarsest = repr2->GetDecimatedLOD(data, 0.5, numberOfLevels - 1);
+  VERIFY(::GetNumberOfPoints(coarsest) == ::GetNumberOfPoints(levels.back()),
+    "Coarsest LOD level differs when built directly.");
+  for (int level = 0; level < numberOfLevels; ++level)
+  {
+    VERIFY(::GetNumberOfPoints(repr2->GetDecimatedLOD(data, 0.5, level)) ==
+        ::GetNumberOfPoints(levels[level]),
+      "LOD level differs when built directly.");
+  }
+
+  // Changing the factor or the data invalidates the pyramid.
+  vtkDataObject* finer = repr->GetDecimatedLOD(data, 1.0, 0);
+  VERIFY(::GetNumberOfPoints(finer) > ::GetNumberOfPoints(levels[0]),
+    "LOD level was not rebuilt with a larger factor.");
+  sphere->SetThetaResolution(8);
+  sphere->SetPhiResolution(8);
+  sphere->Update();
+  data->ShallowCopy(sphere->GetOutput());
+  VERIFY(::GetNumberOfPoints(repr->GetDecimatedLOD(data, 1.0, 0)) <= data->GetNumberOfPoints(),
+    "LOD level was not rebuilt after the data changed.");
+  VERIFY(::GetNumberOfPoints(repr->GetDecimatedLOD(data, 1.0, 0)) < ::GetNumberOfPoints(finer),
+    "LOD level was not rebuilt after the data changed.");
+
+  return EXIT_SUCCESS;
+}
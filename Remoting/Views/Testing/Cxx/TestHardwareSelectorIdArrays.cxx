@@ -0,0 +1,140 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkActor.h"
+#include "vtkCallbackCommand.h"
+#include "vtkCamera.h"
+#include "vtkCellData.h"
+#include "vtkCompositePolyDataMapper.h"
+#include "vtkIdTypeArray.h"
+#include "vtkInitializationHelper.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPVHardwareSelector.h"
+#include "vtkPlaneSource.h"
+#include "vtkPolyData.h"
+#include "vtkProcessModule.h"
+#include "vtkRenderWindow.h"
+#include "vtkRenderer.h"
+#include "vtkSelection.h"
+#include "vtkSelectionNode.h"
+#include "vtkSmartPointer.h"
+
+#include <set>
+
+#define VERIFY(x, y)                                                                               \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    vtkLogF(ERROR, y);                                                                             \
+    return false;                                                                                  \
+  }
+
+namespace
+{
+constexpr vtkIdType NumberOfCells = 16;
+
+void AddIdArray(vtkPolyData* polyData, const char* name, bool reversed)
+{
+  vtkNew<vtkIdTypeArray> ids;
+  ids->SetName(name);
+  ids->SetNumberOfTuples(NumberOfCells);
+  for (vtkIdType cc = 0; cc < NumberOfCells; ++cc)
+  {
+    ids->SetValue(cc, reversed ? NumberOfCells - 1 - cc : cc);
+  }
+  polyData->GetCellData()->AddArray(ids);
+}
+
+std::set<vtkIdType> GetSelectedIds(vtkSelection* selection)
+{
+  std::set<vtkIdType> selected;
+  for (unsigned int cc = 0; selection && cc < selection->GetNumberOfNodes(); ++cc)
+  {
+    auto list = vtkIdTypeArray::SafeDownCast(selection->GetNode(cc)->GetSelectionList());
+    for (vtkIdType idx = 0; list && idx < list->GetNumberOfTuples(); ++idx)
+    {
+      selected.insert(list->GetValue(idx));
+    }
+  }
+  return selected;
+}
+
+bool TestIdArrays()
+{
+  vtkNew<vtkPlaneSource> plane;
+  plane->SetResolution(4, 4);
+  plane->Update();
+  vtkNew<vtkPolyData> polyData;
+  polyData->ShallowCopy(plane->GetOutput());
+  ::AddIdArray(polyData, "Ids", false);
+  ::AddIdArray(polyData, "ReversedIds", true);
+
+  vtkNew<vtkCompositePolyDataMapper> mapper;
+  mapper->SetInputDataObject(polyData);
+  vtkNew<vtkActor> actor;
+  actor->SetMapper(mapper);
+  vtkNew<vtkRenderer> renderer;
+  renderer->AddActor(actor);
+  vtkNew<vtkRenderWindow> window;
+  window->SetSize(200, 200);
+  window->AddRenderer(renderer);
+  renderer->ResetCamera();
+  window->Render();
+
+  int numberOfRenders = 0;
+  vtkNew<vtkCallbackCommand> countRenders;
+  countRenders->SetClientData(&numberOfRenders);
+  countRenders->SetCallback([](vtkObject*, unsigned long, void* clientData, void*)
+    { ++*static_cast<int*>(clientData); });
+  renderer->AddObserver(vtkCommand::StartEvent, countRenders);
+
+  vtkNew<vtkPVHardwareSelector> selector;
+  selector->SetRenderer(renderer);
+  selector->SetFieldAssociation(vtkDataObject::FIELD_ASSOCIATION_CELLS);
+
+  // select the left part of the plane.
+  auto select = [&](const char* arrayName)
+  {
+    mapper->SetCellIdArrayName(arrayName);
+    selector->SetIdArrayName(arrayName);
+    int region[4] = { 0, 0, 80, 199 };
+    vtkSmartPointer<vtkSelection> selection;
+    selection.TakeReference(selector->Select(region));
+    return ::GetSelectedIds(selection);
+  };
+
+  const auto ids = select("Ids");
+  VERIFY(!ids.empty() && static_cast<vtkIdType>(ids.size()) < NumberOfCells,
+    "Unexpected selection with the first id array.");
+
+  // switching the id array must capture new buffers.
+  selector->SetIdArrayName("ReversedIds");
+  VERIFY(selector->NeedToRenderForSelection(), "Buffers reused for another id array.");
+  const auto reversedIds = select("ReversedIds");
+  std::set<vtkIdType> expected;
+  for (vtkIdType id : ids)
+  {
+    expected.insert(NumberOfCells - 1 - id);
+  }
+  VERIFY(reversedIds == expected, "Unexpected selection with the second id array.");
+
+  // switching back reuses the buffers captured for the first id array.
+  numberOfRenders = 0;
+  VERIFY(select("Ids") == ids, "Unexpected selection when switching back.");
+  VERIFY(numberOfRenders == 0, "Buffers captured for the first id array were not reused.");
+
+  // moving the camera invalidates the buffers.
+  renderer->GetActiveCamera()->Zoom(1.5);
+  VERIFY(selector->NeedToRenderForSelection(), "Buffers reused after the camera changed.");
+  return true;
+}
+}
+
+extern int TestHardwareSelectorIdArrays(int, char* argv[])
+{
+  vtkInitializationHelper::SetApplicationName("TestHardwareSelectorIdArrays");
+  vtkInitializationHelper::SetOrganizationName("Humanity");
+  vtkInitializationHelper::Initialize(argv[0], vtkProcessModule::PROCESS_CLIENT);
+  const bool success = ::TestIdArrays();
+  vtkInitializationHelper::Finalize();
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
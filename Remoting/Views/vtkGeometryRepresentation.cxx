@@ -454,20 +454,26 @@ int vtkGeometryRepresentation::ProcessViewRequest(
       }
       else
       {
-        if (inInfo->Has(vtkPVRenderView::LOD_RESOLUTION()))
+        // We handle this number differently depending on decimator
+        // implementation.
+        const double factor = inInfo->Has(vtkPVRenderView::LOD_RESOLUTION())
+          ? inInfo->Get(vtkPVRenderView::LOD_RESOLUTION())
+          : 0.5;
+        const int level =
+          inInfo->Has(vtkPVRenderView::LOD_LEVEL()) ? inInfo->Get(vtkPVRenderView::LOD_LEVEL()) : 0;
+
+        vtkDataObject* lodData = this->GetDecimatedLOD(data, factor, level);
+        if (level != this->LastLODLevel)
         {
-          // We handle this number differently depending on decimator
-          // implementation.
-          const double factor = inInfo->Get(vtkPVRenderView::LOD_RESOLUTION());
-          this->Decimator->SetLODFactor(factor);
+          // ensures that the view delivers the geometry of the new level even
+          // though the representation did not re-execute.
+          lodData->Modified();
+          this->LastLODLevel = level;
         }
 
-        this->Decimator->SetInputDataObject(data);
-        this->Decimator->Update();
-
         // Pass along the LOD geometry to the view so that it can deliver it to
         // the rendering node as and when needed.
-        vtkPVView::SetPieceLOD(inInfo, this, this->Decimator->GetOutputDataObject(0));
+        vtkPVView::SetPieceLOD(inInfo, this, lodData);
       }
     }
   }
@@ -512,6 +518,38 @@ int vtkGeometryRepresentation::ProcessViewRequest(
   return 1;
 }
 
+//----------------------------------------------------------------------------
+vtkDataObject* vtkGeometryRepresentation::GetDecimatedLOD(
+  vtkDataObject* data, double factor, int level)
+{
+  if (this->LODLevelsInput != data || this->LODLevelsFactor != factor ||
+    data->GetMTime() > this->LODLevelsTime)
+  {
+    this->LODLevels.clear();
+    this->LODLevelsInput = data;
+    this->LODLevelsFactor = factor;
+    this->LODLevelsTime.Modified();
+  }
+
+  // Coarser levels are decimated from the previous level rather than from the
+  // full resolution data, so they are cheap to build once level 0 exists.
+  while (static_cast<int>(this->LODLevels.size()) <= level)
+  {
+    const int cc = static_cast<int>(this->LODLevels.size());
+    this->Decimator->SetLODFactor(factor / (1 << cc));
+    this->Decimator->SetInputDataObject(cc == 0 ? data : this->LODLevels.back().GetPointer());
+    this->Decimator->Update();
+
+    vtkDataObject* output = this->Decimator->GetOutputDataObject(0);
+    vtkSmartPointer<vtkDataObject> levelData;
+    levelData.TakeReference(output->NewInstance());
+    levelData->ShallowCopy(output);
+    this->LODLevels.push_back(levelData);
+  }
+  this->Decimator->SetInputDataObject(nullptr);
+  return this->LODLevels[level];
+}
+
 //----------------------------------------------------------------------------
 int vtkGeometryRepresentation::RequestUpdateExtent(
   vtkInformation* request, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
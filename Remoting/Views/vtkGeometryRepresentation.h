@@ -20,6 +20,7 @@
 #include "vtkParaViewDeprecation.h" // for PV_DEPRECATED
 #include "vtkProperty.h"            // needed for VTK_POINTS etc.
 #include "vtkRemotingViewsModule.h" // needed for exports
+#include "vtkSmartPointer.h"        // needed for vtkSmartPointer
 #include "vtkVector.h"              // for vtkVector.
 
 #include <set>           // needed for std::set
@@ -525,6 +526,14 @@ protected:
    */
   void UpdateGeneralTextureTransform();
 
+  /**
+   * Returns the decimated geometry for the given LOD level. Level 0 is `data`
+   * decimated using `factor`, and each following level is decimated from the
+   * previous one with half the factor. Levels are built on demand and kept
+   * until `data` or `factor` changes.
+   */
+  vtkDataObject* GetDecimatedLOD(vtkDataObject* data, double factor, int level);
+
   vtkAlgorithm* GeometryFilter;
   vtkAlgorithm* MultiBlockMaker;
   vtkGeometryRepresentation_detail::DecimationFilterType* Decimator;
@@ -561,6 +570,13 @@ protected:
   vtkTimeStamp BlockAttributeTime;
   bool UpdateBlockAttrLOD = false;
 
+  // Decimated geometries for each LOD level, see GetDecimatedLOD().
+  std::vector<vtkSmartPointer<vtkDataObject>> LODLevels;
+  vtkDataObject* LODLevelsInput = nullptr;
+  double LODLevelsFactor = -1.0;
+  vtkTimeStamp LODLevelsTime;
+  int LastLODLevel = -1;
+
   // This is used to be able to create the correct placeHolder in RequestData for the client
   int PlaceHolderDataType = VTK_PARTITIONED_DATA_SET_COLLECTION;
 
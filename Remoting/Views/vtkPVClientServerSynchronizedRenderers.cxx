@@ -3,6 +3,8 @@
 // SPDX-License-Identifier: BSD-3-Clause
 #include "vtkPVClientServerSynchronizedRenderers.h"
 
+#include "vtkCompositeMultiProcessController.h"
+#include "vtkDeltaImageCompressor.h"
 #include "vtkLZ4Compressor.h"
 #include "vtkMultiProcessController.h"
 #include "vtkObjectFactory.h"
@@ -24,6 +26,7 @@ vtkPVClientServerSynchronizedRenderers::vtkPVClientServerSynchronizedRenderers()
   : Compressor(nullptr)
   , LossLessCompression(true)
   , NVPipeSupport(false)
+  , LastActiveControllerID(-1)
 {
   this->ConfigureCompressor("vtkLZ4Compressor 0 3");
 }
@@ -85,6 +88,18 @@ void vtkPVClientServerSynchronizedRenderers::SlaveEndRender()
   {
     if (this->Compressor)
     {
+      // With several clients connected, images go to the active one. Frames
+      // encoded against a previous frame must start over when it changes.
+      auto* composite =
+        vtkCompositeMultiProcessController::SafeDownCast(this->ParallelController);
+      const int activeID = composite ? composite->GetActiveControllerID() : -1;
+      auto* delta = vtkDeltaImageCompressor::SafeDownCast(this->Compressor);
+      if (delta && activeID != this->LastActiveControllerID)
+      {
+        delta->RequestKeyFrame();
+      }
+      this->LastActiveControllerID = activeID;
+
       this->Compressor->SetImageResolution(header[1], header[2]);
       this->ParallelController->Send(this->Compress(rawImage.GetRawPtr()), 1, 0x023430);
     }
@@ -159,6 +174,10 @@ void vtkPVClientServerSynchronizedRenderers::ConfigureCompressor(const char* str
     {
       comp = vtkLZ4Compressor::New();
     }
+    else if (className == "vtkDeltaImageCompressor")
+    {
+      comp = vtkDeltaImageCompressor::New();
+    }
     else if (className == "vtkNvPipeCompressor" && this->NVPipeSupport)
     {
 #if VTK_MODULE_ENABLE_ParaView_nvpipe
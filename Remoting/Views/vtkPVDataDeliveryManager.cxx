@@ -98,8 +98,11 @@ void vtkPVDataDeliveryManager::SetPiece(vtkPVDataRepresentation* repr, vtkDataOb
   if (item)
   {
     const auto cacheKey = this->GetCacheKey(repr);
+    // low-res data may also change without the representation re-executing,
+    // e.g. when the view switches to a different LOD level.
     if (item->GetDataObject(cacheKey) == nullptr ||
-      repr->GetPipelineDataTime() > item->GetTimeStamp())
+      repr->GetPipelineDataTime() > item->GetTimeStamp() ||
+      (low_res && data != nullptr && data->GetMTime() > item->GetTimeStamp(cacheKey)))
     {
       vtkLogF(
         TRACE, "SetDataObject %s (key=%g) : %p", repr->GetLogName().c_str(), cacheKey, (void*)data);
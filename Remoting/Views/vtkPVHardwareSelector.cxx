@@ -3,8 +3,10 @@
 #include "vtkPVHardwareSelector.h"
 
 #include "vtkCamera.h"
+#include "vtkMatrix4x4.h"
 #include "vtkMultiProcessController.h"
 #include "vtkObjectFactory.h"
+#include "vtkPVDataRepresentation.h"
 #include "vtkPVLogger.h"
 #include "vtkPVRenderView.h"
 #include "vtkPVRenderViewSettings.h"
@@ -14,7 +16,12 @@
 #include "vtkStringFormatter.h"
 #include "vtkWeakPointer.h"
 
+#include <algorithm>
+#include <array>
 #include <map>
+#include <string>
+#include <utility>
+#include <vector>
 
 // #define vtkPVHardwareSelectorDEBUG
 #ifdef vtkPVHardwareSelectorDEBUG
@@ -32,6 +39,78 @@ public:
   PropMapType PropMap;
 
   vtkWeakPointer<vtkPVRenderView> View;
+
+  // name of the id array the representations render for the current
+  // selection, empty for the default ones.
+  std::string IdArrayName;
+
+  /**
+   * State the captured buffers depend on.
+   */
+  struct CaptureState
+  {
+    int FieldAssociation = -1;
+    std::string IdArrayName;
+    vtkRenderer* Renderer = nullptr;
+    std::array<int, 4> Viewport{ { 0, 0, 0, 0 } };
+    // model view and projection matrices of the camera.
+    std::array<double, 32> Camera{};
+    vtkMTimeType RepresentationsMTime = 0;
+
+    bool operator==(const CaptureState& other) const
+    {
+      return this->FieldAssociation == other.FieldAssociation &&
+        this->IdArrayName == other.IdArrayName && this->Renderer == other.Renderer &&
+        this->Viewport == other.Viewport && this->Camera == other.Camera &&
+        this->RepresentationsMTime == other.RepresentationsMTime;
+    }
+  };
+
+  // buffers are kept for each field association and id array name.
+  using StashKey = std::pair<int, std::string>;
+
+  struct StashedBuffers
+  {
+    std::vector<unsigned char*> PixBuffer;
+    vtkIdType MaximumPointId = 0;
+    vtkIdType MaximumCellId = 0;
+    CaptureState State;
+    vtkTimeStamp CaptureTime;
+  };
+
+  // State of the buffers held by the superclass.
+  CaptureState Captured;
+  // Buffers captured for the other field associations and id arrays.
+  std::map<StashKey, StashedBuffers> Stash;
+
+  CaptureState GetCurrentState(vtkRenderer* renderer, int fieldAssociation) const
+  {
+    CaptureState state;
+    state.FieldAssociation = fieldAssociation;
+    state.IdArrayName = this->IdArrayName;
+    state.Renderer = renderer;
+    if (renderer)
+    {
+      const int* origin = renderer->GetOrigin();
+      const int* size = renderer->GetSize();
+      state.Viewport = { { origin[0], origin[1], size[0], size[1] } };
+      vtkCamera* camera = renderer->GetActiveCamera();
+      vtkMatrix4x4::DeepCopy(&state.Camera[0], camera->GetModelViewTransformMatrix());
+      vtkMatrix4x4::DeepCopy(&state.Camera[16], camera->GetProjectionTransformMatrix(renderer));
+    }
+    if (auto view = this->View.GetPointer())
+    {
+      for (int cc = 0, max = view->GetNumberOfRepresentations(); cc < max; ++cc)
+      {
+        if (auto repr = vtkPVDataRepresentation::SafeDownCast(view->GetRepresentation(cc)))
+        {
+          state.RepresentationsMTime = std::max(
+            { state.RepresentationsMTime, repr->GetMTime(), repr->GetPipelineDataTime() });
+        }
+      }
+    }
+    return state;
+  }
 };
 
 //----------------------------------------------------------------------------
@@ -49,6 +128,7 @@ vtkPVHardwareSelector::vtkPVHardwareSelector()
 //----------------------------------------------------------------------------
 vtkPVHardwareSelector::~vtkPVHardwareSelector()
 {
+  this->ReleaseStashedBuffers();
   delete this->Internals;
   this->Internals = nullptr;
 }
@@ -83,14 +163,99 @@ bool vtkPVHardwareSelector::PassRequired(int pass)
   return this->Superclass::PassRequired(pass);
 }
 
+//----------------------------------------------------------------------------
+void vtkPVHardwareSelector::SetIdArrayName(const char* name)
+{
+  this->Internals->IdArrayName = name ? name : "";
+}
+
+//----------------------------------------------------------------------------
+const char* vtkPVHardwareSelector::GetIdArrayName() const
+{
+  return this->Internals->IdArrayName.c_str();
+}
+
+//----------------------------------------------------------------------------
+void vtkPVHardwareSelector::InvalidateCachedSelection()
+{
+  this->InvalidationTime.Modified();
+  this->ReleaseStashedBuffers();
+}
+
+//----------------------------------------------------------------------------
+void vtkPVHardwareSelector::ReleaseStashedBuffers()
+{
+  for (auto& item : this->Internals->Stash)
+  {
+    for (auto buffer : item.second.PixBuffer)
+    {
+      delete[] buffer;
+    }
+  }
+  this->Internals->Stash.clear();
+}
+
+//----------------------------------------------------------------------------
+void vtkPVHardwareSelector::SwapCapturedBuffers()
+{
+  auto& internals = *this->Internals;
+  const vtkInternals::StashKey key{ this->FieldAssociation, internals.IdArrayName };
+  if (internals.Captured.FieldAssociation == key.first &&
+    internals.Captured.IdArrayName == key.second)
+  {
+    return;
+  }
+
+  constexpr size_t numberOfBuffers = sizeof(this->PixBuffer) / sizeof(this->PixBuffer[0]);
+  if (internals.Captured.FieldAssociation != -1 && this->InvalidationTime < this->CaptureTime)
+  {
+    auto& stashed =
+      internals.Stash[{ internals.Captured.FieldAssociation, internals.Captured.IdArrayName }];
+    for (auto buffer : stashed.PixBuffer)
+    {
+      delete[] buffer;
+    }
+    stashed.PixBuffer.assign(this->PixBuffer, this->PixBuffer + numberOfBuffers);
+    std::fill(this->PixBuffer, this->PixBuffer + numberOfBuffers, nullptr);
+    stashed.MaximumPointId = this->MaximumPointId;
+    stashed.MaximumCellId = this->MaximumCellId;
+    stashed.State = internals.Captured;
+    stashed.CaptureTime = this->CaptureTime;
+  }
+  internals.Captured = vtkInternals::CaptureState();
+
+  auto iter = internals.Stash.find(key);
+  if (iter != internals.Stash.end())
+  {
+    this->ReleasePixBuffers();
+    std::copy(iter->second.PixBuffer.begin(), iter->second.PixBuffer.end(), this->PixBuffer);
+    this->MaximumPointId = iter->second.MaximumPointId;
+    this->MaximumCellId = iter->second.MaximumCellId;
+    internals.Captured = iter->second.State;
+    this->CaptureTime = iter->second.CaptureTime;
+    internals.Stash.erase(iter);
+  }
+}
+
 //----------------------------------------------------------------------------
 bool vtkPVHardwareSelector::PrepareSelect()
 {
-  if (this->NeedToRenderForSelection())
+  this->SwapCapturedBuffers();
+
+  bool needToRender = this->NeedToRenderForSelection();
+  if (auto view = this->Internals->View)
+  {
+    // rendering the selection passes is collective, all ranks must agree.
+    needToRender = view->SynchronizeNeedToRenderForSelection(needToRender);
+  }
+
+  if (needToRender)
   {
     int* size = this->Renderer->GetSize();
     int* origin = this->Renderer->GetOrigin();
     this->SetArea(origin[0], origin[1], origin[0] + size[0] - 1, origin[1] + size[1] - 1);
+    this->Internals->Captured =
+      this->Internals->GetCurrentState(this->Renderer, this->FieldAssociation);
     if (this->CaptureBuffers() == false)
     {
       this->CaptureTime.Modified();
@@ -143,10 +308,13 @@ vtkSelection* vtkPVHardwareSelector::PolygonSelect(int* polygonPoints, vtkIdType
 //----------------------------------------------------------------------------
 bool vtkPVHardwareSelector::NeedToRenderForSelection()
 {
-  // We rely on external logic to ensure that the MTime for the
-  // vtkPVHardwareSelector is explicitly modified when some action happens that
-  // would result in invalidation of captured buffers.
-  return this->CaptureTime < this->GetMTime();
+  // We rely on external logic to call InvalidateCachedSelection() when some
+  // action happens that would change the rendered data. Changes to the
+  // renderer, its viewport, the camera, the id arrays or the representations
+  // of the view are detected here.
+  return this->CaptureTime < this->InvalidationTime ||
+    !(this->Internals->Captured ==
+      this->Internals->GetCurrentState(this->Renderer, this->FieldAssociation));
 }
 
 //----------------------------------------------------------------------------
@@ -8,9 +8,16 @@
  * vtkHardwareSelector is subclass of vtkHardwareSelector that adds logic to
  * reuse the captured buffers as much as possible. Thus avoiding repeated
  * selection-rendering of repeated selections or picking.
- * This class does not know, however, when the cached buffers are invalid.
- * External logic must explicitly calls InvalidateCachedSelection() to ensure
- * that the cache is not reused.
+ *
+ * The captured buffers are kept for each field association and id array name,
+ * since points and cells, and different id arrays, are rendered differently in
+ * the selection passes. Switching between point and cell selection, e.g.
+ * between hovering over points and selecting cells, reuses the buffers
+ * captured for that association as long as they are still valid. Buffers are
+ * valid until the renderer, its size, the camera or the representations of
+ * the view change, or until InvalidateCachedSelection() is called. Since this
+ * class cannot tell when the rendered data changes, external logic must
+ * explicitly call InvalidateCachedSelection() in that case.
  */
 
 #ifndef vtkPVHardwareSelector_h
@@ -52,10 +59,21 @@ public:
    */
   virtual bool NeedToRenderForSelection();
 
+  ///@{
   /**
-   * Called to invalidate the cache.
+   * Set the name of the array the representations render as ids for the next
+   * selection, i.e. the array passed to `SetArrayIdNames`. nullptr or an empty
+   * name stands for the default id arrays.
    */
-  void InvalidateCachedSelection() { this->Modified(); }
+  void SetIdArrayName(const char* name);
+  const char* GetIdArrayName() const;
+  ///@}
+
+  /**
+   * Called to invalidate the cache. This releases the buffers captured for all
+   * field associations and id arrays.
+   */
+  void InvalidateCachedSelection();
 
   int AssignUniqueId(vtkProp*);
 
@@ -91,7 +109,21 @@ protected:
 
   void SavePixelBuffer(int passNo) override;
 
+  /**
+   * Makes the buffers captured for the current field association and id
+   * array, if any, the ones used to generate the selection, stashing the
+   * buffers captured for the previous ones.
+   */
+  void SwapCapturedBuffers();
+
+  /**
+   * Releases the buffers stashed for the field associations and id arrays not
+   * in use.
+   */
+  void ReleaseStashedBuffers();
+
   vtkTimeStamp CaptureTime;
+  vtkTimeStamp InvalidationTime;
   int UniqueId;
 
 private:
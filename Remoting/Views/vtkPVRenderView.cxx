@@ -119,6 +119,7 @@
 #include <anari/frontend/anari_enums.h>
 #endif
 
+#include <algorithm>
 #include <cassert>
 #include <map>
 #include <set>
@@ -379,6 +380,7 @@ vtkObjectFactoryNewMacro(vtkPVRenderView);
 vtkInformationKeyMacro(vtkPVRenderView, USE_LOD, Integer);
 vtkInformationKeyMacro(vtkPVRenderView, USE_OUTLINE_FOR_LOD, Integer);
 vtkInformationKeyMacro(vtkPVRenderView, LOD_RESOLUTION, Double);
+vtkInformationKeyMacro(vtkPVRenderView, LOD_LEVEL, Integer);
 vtkInformationKeyMacro(vtkPVRenderView, NEED_ORDERED_COMPOSITING, Integer);
 vtkInformationKeyMacro(vtkPVRenderView, RENDER_EMPTY_IMAGES, Integer);
 vtkInformationKeyMacro(vtkPVRenderView, REQUEST_STREAMING_UPDATE, Request);
@@ -420,6 +422,14 @@ vtkPVRenderView::vtkPVRenderView()
   this->LODRenderingThreshold = 0;
   this->LODResolution = 0.5;
   this->UseOutlineForLODRendering = false;
+  this->TargetFrameRate = 0.0;
+  this->NumberOfLODLevels = 4;
+  this->MaximumAdaptiveImageReductionFactor = 8;
+  this->LODLevel = 0;
+  this->AdaptiveImageReductionFactor = 1;
+  this->LastInteractiveRenderTime = -1.0;
+  this->LastInteractiveRenderUsedLOD = false;
+  this->LastInteractiveRenderUsedRemoteRendering = false;
   this->UseLightKit = false;
   this->Interactor = nullptr;
   this->InteractorStyle = nullptr;
@@ -1005,6 +1015,7 @@ bool vtkPVRenderView::PrepareSelect(int fieldAssociation, const char* array)
 
   this->Selector->SetRenderer(this->GetRenderer());
   this->Selector->SetFieldAssociation(fieldAssociation);
+  this->Selector->SetIdArrayName(array);
 
   if (array)
   {
@@ -1621,6 +1632,116 @@ void vtkPVRenderView::CopyViewUpdateOptions(vtkPVRenderView* otherView)
   this->StillRenderProcesses = otherView->StillRenderProcesses;
   this->InteractiveRenderProcesses = otherView->InteractiveRenderProcesses;
   this->UseDistributedRenderingForLODRender = otherView->UseDistributedRenderingForLODRender;
+  this->TargetFrameRate = otherView->TargetFrameRate;
+  this->NumberOfLODLevels = otherView->NumberOfLODLevels;
+  this->MaximumAdaptiveImageReductionFactor = otherView->MaximumAdaptiveImageReductionFactor;
+  this->LODLevel = otherView->LODLevel;
+  this->AdaptiveImageReductionFactor = otherView->AdaptiveImageReductionFactor;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVRenderView::SetLODLevel(int level)
+{
+  level = std::max(0, std::min(level, this->NumberOfLODLevels - 1));
+  if (this->LODLevel != level)
+  {
+    this->LODLevel = level;
+    // the time of the last render no longer reflects the current state.
+    this->LastInteractiveRenderTime = -1.0;
+    this->Modified();
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVRenderView::SetAdaptiveImageReductionFactor(int factor)
+{
+  factor = std::max(1, std::min(factor, 20));
+  if (this->AdaptiveImageReductionFactor != factor)
+  {
+    this->AdaptiveImageReductionFactor = factor;
+    // the time of the last render no longer reflects the current state.
+    this->LastInteractiveRenderTime = -1.0;
+    this->Modified();
+  }
+}
+
+//----------------------------------------------------------------------------
+const char* vtkPVRenderView::AdaptRenderingState(double targetTime, double renderTime,
+  bool usedLOD, bool usedRemoteRendering, int numberOfLODLevels, int minimumImageReductionFactor,
+  int maximumImageReductionFactor, int state[2])
+{
+  int& lodLevel = state[0];
+  int& factor = state[1];
+  lodLevel = std::max(0, std::min(lodLevel, numberOfLODLevels - 1));
+  factor = std::max(minimumImageReductionFactor, std::min(factor, maximumImageReductionFactor));
+  if (!usedRemoteRendering && factor > minimumImageReductionFactor)
+  {
+    // the image reduction factor only applies to remote and parallel renders.
+    factor = minimumImageReductionFactor;
+    return "reset image reduction factor";
+  }
+
+  // Use some hysteresis to avoid alternating between two states.
+  if (renderTime > 1.25 * targetTime)
+  {
+    if (usedLOD && lodLevel < numberOfLODLevels - 1)
+    {
+      ++lodLevel;
+      return "use coarser LOD";
+    }
+    if (usedRemoteRendering && factor < maximumImageReductionFactor)
+    {
+      ++factor;
+      return "increase image reduction factor";
+    }
+  }
+  else if (renderTime < 0.5 * targetTime)
+  {
+    if (factor > minimumImageReductionFactor)
+    {
+      --factor;
+      return "decrease image reduction factor";
+    }
+    if (lodLevel > 0)
+    {
+      --lodLevel;
+      return "use finer LOD";
+    }
+  }
+  return "keep current state";
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVRenderView::ComputeAdaptiveRenderingState(int state[2])
+{
+  state[0] = std::max(0, std::min(this->LODLevel, this->NumberOfLODLevels - 1));
+  // the image reduction factor actually used for interactive renders.
+  state[1] =
+    std::max(this->AdaptiveImageReductionFactor, this->InteractiveRenderImageReductionFactor);
+  if (this->TargetFrameRate <= 0.0)
+  {
+    state[0] = 0;
+    state[1] = this->InteractiveRenderImageReductionFactor;
+  }
+  else if (this->LastInteractiveRenderTime >= 0.0)
+  {
+    const double targetTime = 1.0 / this->TargetFrameRate;
+    const char* decision = vtkPVRenderView::AdaptRenderingState(targetTime,
+      this->LastInteractiveRenderTime, this->LastInteractiveRenderUsedLOD,
+      this->LastInteractiveRenderUsedRemoteRendering, this->NumberOfLODLevels,
+      this->InteractiveRenderImageReductionFactor,
+      std::max(this->InteractiveRenderImageReductionFactor,
+        this->MaximumAdaptiveImageReductionFactor),
+      state);
+    vtkVLogF(PARAVIEW_LOG_RENDERING_VERBOSITY(),
+      "%s: frame time %gs (target %gs): %s (LOD level=%d, image reduction factor=%d)",
+      this->GetLogName().c_str(), this->LastInteractiveRenderTime, targetTime, decision, state[0],
+      state[1]);
+  }
+
+  // 1 implies InteractiveRenderImageReductionFactor is used as is.
+  state[1] = state[1] > this->InteractiveRenderImageReductionFactor ? state[1] : 1;
+  return state[0] != this->LODLevel || state[1] != this->AdaptiveImageReductionFactor;
 }
 
 //----------------------------------------------------------------------------
@@ -1633,6 +1754,9 @@ void vtkPVRenderView::UpdateLOD()
   // Update LOD geometry.
 
   this->RequestInformation->Set(LOD_RESOLUTION(), this->LODResolution);
+  // NumberOfLODLevels may have been reduced since LODLevel was set.
+  this->RequestInformation->Set(
+    LOD_LEVEL(), std::max(0, std::min(this->LODLevel, this->NumberOfLODLevels - 1)));
   if (this->UseOutlineForLODRendering)
   {
     this->RequestInformation->Set(USE_OUTLINE_FOR_LOD(), 1);
@@ -1829,9 +1953,10 @@ void vtkPVRenderView::Render(bool interactive, bool skip_rendering)
     vtkPVView::REQUEST_RENDER(), this->RequestInformation, this->ReplyInformationVector);
 
   // set the image reduction factor.
+  const int interactiveImageReductionFactor =
+    std::max(this->InteractiveRenderImageReductionFactor, this->AdaptiveImageReductionFactor);
   this->SynchronizedRenderers->SetImageReductionFactor(
-    (interactive ? this->InteractiveRenderImageReductionFactor
-                 : this->StillRenderImageReductionFactor));
+    (interactive ? interactiveImageReductionFactor : this->StillRenderImageReductionFactor));
 
   this->UsedLODForLastRender = use_lod_rendering;
 
@@ -1931,6 +2056,14 @@ void vtkPVRenderView::Render(bool interactive, bool skip_rendering)
   if (!this->MakingSelection)
   {
     this->Timer->StopTimer();
+    if (interactive)
+    {
+      // on the client, this includes the time to composite and deliver the
+      // image from the server.
+      this->LastInteractiveRenderTime = this->Timer->GetElapsedTime();
+      this->LastInteractiveRenderUsedLOD = use_lod_rendering;
+      this->LastInteractiveRenderUsedRemoteRendering = use_distributed_rendering;
+    }
   }
 
   if (!this->MakingSelection)
@@ -4415,6 +4548,18 @@ void vtkPVRenderView::SynchronizeMaximumIds(vtkIdType* maxPointId, vtkIdType* ma
   }
 }
 
+//----------------------------------------------------------------------------
+bool vtkPVRenderView::SynchronizeNeedToRenderForSelection(bool needToRender)
+{
+  if (this->SynchronizedRenderers->GetEnabled())
+  {
+    vtkTypeUInt64 value = needToRender ? 1 : 0;
+    this->AllReduce(value, value, vtkCommunicator::MAX_OP, /*skip_data_server=*/true);
+    needToRender = value != 0;
+  }
+  return needToRender;
+}
+
 //----------------------------------------------------------------------------
 void vtkPVRenderView::SetHardwareSelector(vtkPVHardwareSelector* selector)
 {
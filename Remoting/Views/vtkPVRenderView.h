@@ -281,6 +281,86 @@ public:
   vtkGetMacro(UseOutlineForLODRendering, bool);
   ///@}
 
+  ///@{
+  /**
+   * Get/Set the frame rate targeted for interactive renders. When positive,
+   * the time taken by each interactive render, including compositing and image
+   * delivery to the client, is used to pick the LOD level and the image
+   * reduction factor of the next one. Renders that are too slow first use
+   * coarser LOD levels, then larger image reduction factors when rendering
+   * remotely or in parallel, and renders that are fast enough undo these in
+   * reverse order. 0 (default) disables this and uses the LODResolution and
+   * InteractiveRenderImageReductionFactor as is.
+   * Decisions are logged using PARAVIEW_LOG_RENDERING_VERBOSITY().
+   * \note CallOnAllProcesses
+   */
+  vtkSetClampMacro(TargetFrameRate, double, 0.0, VTK_DOUBLE_MAX);
+  vtkGetMacro(TargetFrameRate, double);
+  ///@}
+
+  ///@{
+  /**
+   * Get/Set the number of LOD levels available when `TargetFrameRate` is
+   * positive. Each level is decimated at half the resolution of the previous
+   * one. Default is 4.
+   * \note CallOnAllProcesses
+   */
+  vtkSetClampMacro(NumberOfLODLevels, int, 1, 8);
+  vtkGetMacro(NumberOfLODLevels, int);
+  ///@}
+
+  ///@{
+  /**
+   * Get/Set the largest image reduction factor used for interactive renders
+   * when `TargetFrameRate` is positive. Default is 8.
+   * \note CallOnAllProcesses
+   */
+  vtkSetClampMacro(MaximumAdaptiveImageReductionFactor, int, 1, 20);
+  vtkGetMacro(MaximumAdaptiveImageReductionFactor, int);
+  ///@}
+
+  ///@{
+  /**
+   * Get/Set the LOD level used for the next update of the LOD geometry. 0 is
+   * the finest level. This is typically set using the level returned by
+   * ComputeAdaptiveRenderingState().
+   * \note CallOnAllProcesses
+   */
+  void SetLODLevel(int level);
+  vtkGetMacro(LODLevel, int);
+  ///@}
+
+  ///@{
+  /**
+   * Get/Set the image reduction factor used for the next interactive renders
+   * when larger than InteractiveRenderImageReductionFactor. This is typically
+   * set using the factor returned by ComputeAdaptiveRenderingState().
+   * \note CallOnAllProcesses
+   */
+  void SetAdaptiveImageReductionFactor(int factor);
+  vtkGetMacro(AdaptiveImageReductionFactor, int);
+  ///@}
+
+  /**
+   * Computes the LOD level and image reduction factor that best match the
+   * `TargetFrameRate` given the time taken by the last interactive render, see
+   * AdaptRenderingState(). Returns true if `state` differs from the current
+   * LODLevel and AdaptiveImageReductionFactor.
+   */
+  bool ComputeAdaptiveRenderingState(int state[2]);
+
+  /**
+   * Adapts `state`, i.e. the LOD level and the image reduction factor used by
+   * an interactive render that took `renderTime` seconds, to get closer to
+   * `targetTime`. Renders that are too slow first use a coarser LOD level, if
+   * `usedLOD`, then a larger image reduction factor, if `usedRemoteRendering`
+   * since the factor has no effect otherwise. Renders that are fast enough
+   * undo these steps in reverse order. Returns a description of the decision.
+   */
+  static const char* AdaptRenderingState(double targetTime, double renderTime, bool usedLOD,
+    bool usedRemoteRendering, int numberOfLODLevels, int minimumImageReductionFactor,
+    int maximumImageReductionFactor, int state[2]);
+
   /**
    * Passes the compressor configuration to the client-server synchronizer, if
    * any. This affects the image compression used to relay images back to the
@@ -322,6 +402,11 @@ public:
    */
   static vtkInformationDoubleKey* LOD_RESOLUTION();
 
+  /**
+   * Indicates the LOD level, 0 being the finest, in REQUEST_UPDATE_LOD() pass.
+   */
+  static vtkInformationIntegerKey* LOD_LEVEL();
+
   /**
    * Indicates the LOD must use outline if possible in REQUEST_UPDATE_LOD()
    * pass.
@@ -1197,6 +1282,13 @@ public:
    */
   void SynchronizeMaximumIds(vtkIdType* maxPointId, vtkIdType* maxCellId);
 
+  /**
+   * This is used by vtkPVHardwareSelector to ensure all ranks involved in
+   * selection agree on whether the selection buffers need to be captured
+   * again. Returns true if any rank needs to.
+   */
+  bool SynchronizeNeedToRenderForSelection(bool needToRender);
+
   /**
    *
    */
@@ -1403,6 +1495,14 @@ protected:
   bool UsedLODForLastRender;
   bool UseLODForInteractiveRender;
   bool UseOutlineForLODRendering;
+  double TargetFrameRate;
+  int NumberOfLODLevels;
+  int MaximumAdaptiveImageReductionFactor;
+  int LODLevel;
+  int AdaptiveImageReductionFactor;
+  double LastInteractiveRenderTime;
+  bool LastInteractiveRenderUsedLOD;
+  bool LastInteractiveRenderUsedRemoteRendering;
   bool UseDistributedRenderingForRender;
   bool UseDistributedRenderingForLODRender;
 
@@ -538,6 +538,21 @@ void vtkSMRenderViewProxy::PostRender(bool interactive)
   cameraProxy->UpdatePropertyInformation();
   this->SynchronizeCameraProperties();
   this->Superclass::PostRender(interactive);
+
+  vtkPVRenderView* rv = vtkPVRenderView::SafeDownCast(this->GetClientSideObject());
+  int state[2];
+  if (interactive && rv && rv->ComputeAdaptiveRenderingState(state))
+  {
+    // adjust the LOD level and image reduction factor for the next interactive
+    // render based on the time taken by this one.
+    this->NeedsUpdateLOD |= (state[0] != rv->GetLODLevel());
+    vtkClientServerStream stream;
+    stream << vtkClientServerStream::Invoke << VTKOBJECT(this) << "SetLODLevel" << state[0]
+           << vtkClientServerStream::End;
+    stream << vtkClientServerStream::Invoke << VTKOBJECT(this) << "SetAdaptiveImageReductionFactor"
+           << state[1] << vtkClientServerStream::End;
+    this->ExecuteStream(stream);
+  }
   vtkSMTrace* tracer = nullptr;
   if (!interactive && (tracer = vtkSMTrace::GetActiveTracer()) &&
     tracer->GetFullyTraceCameraAdjustments())
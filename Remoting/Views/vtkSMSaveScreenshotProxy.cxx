@@ -14,6 +14,7 @@
 #include "vtkPVXMLElement.h"
 #include "vtkPointData.h"
 #include "vtkProcessModule.h"
+#include "vtkRemoteWriterHelper.h"
 #include "vtkRenderWindow.h"
 #include "vtkSMParaViewPipelineControllerWithRendering.h"
 #include "vtkSMProperty.h"
@@ -508,6 +509,14 @@ bool vtkSMSaveScreenshotProxy::WriteImage(
     return false;
   }
 
+  // When the ranks are split into independent groups running the same
+  // script, every group would save the same screenshot. Let the first group
+  // alone save it.
+  if (vtkProcessModule::GetRankGroupId() != 0)
+  {
+    return true;
+  }
+
   auto session = this->GetSession();
   if (session->GetProcessRoles() != vtkPVSession::CLIENT)
   {
@@ -601,6 +610,10 @@ bool vtkSMSaveScreenshotProxy::WriteImage(
   vtkTimerLog::MarkStartEvent("Write image to disk");
   auto remoteWriterAlgorithm = vtkAlgorithm::SafeDownCast(remoteWriter->GetClientSideObject());
 
+  // the format may still be writing a previous screenshot in the background.
+  auto formatWriter = vtkAlgorithm::SafeDownCast(format->GetClientSideObject());
+  vtkRemoteWriterHelper::Wait(formatWriter);
+
   // save paraview state as metadata
   const bool embedState = stateXMLRoot && strcmp(format->GetXMLName(), "PNG") == 0;
   if (embedState)
@@ -621,7 +634,8 @@ bool vtkSMSaveScreenshotProxy::WriteImage(
     remoteWriterAlgorithm->SetInputDataObject(image_pair.second);
     remoteWriter->UpdatePipeline();
 
-    // write left-eye.
+    // write left-eye, once the right-eye is written.
+    vtkRemoteWriterHelper::Wait(formatWriter);
     vtkSMPropertyHelper(format, "FileName")
       .Set(this->GetStereoFileName(filename, /*left=*/true).c_str());
     format->UpdateVTKObjects();
@@ -0,0 +1,84 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkNew.h"
+#include "vtkPVXMLElement.h"
+#include "vtkPVXMLParser.h"
+
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+namespace
+{
+const char* XMLContent = R"(
+<ServerManagerConfiguration>
+  <ProxyGroup name="filters">
+    <SourceProxy name="Calculator" class="vtkPVArrayCalculator" label="Calculator">
+      <Documentation long_help="Compute &quot;new&quot; arrays." short_help="">
+        Computes new arrays &amp; attributes.
+      </Documentation>
+      <StringVectorProperty name="Function" command="SetFunction" id="function"
+        number_of_elements="1" default_values="" />
+      <Hints>
+        <ShowInMenu category="Common" />
+      </Hints>
+    </SourceProxy>
+  </ProxyGroup>
+</ServerManagerConfiguration>
+)";
+}
+
+extern int TestPVXMLElementBinary(int, char*[])
+{
+  vtkNew<vtkPVXMLParser> parser;
+  if (!parser->Parse(XMLContent))
+  {
+    std::cerr << "ERROR: failed to parse the XML." << endl;
+    return EXIT_FAILURE;
+  }
+  vtkPVXMLElement* root = parser->GetRootElement();
+
+  std::ostringstream output;
+  root->SaveBinary(output);
+  const std::string binary = output.str();
+
+  std::istringstream input(binary);
+  vtkNew<vtkPVXMLElement> restored;
+  if (!restored->LoadBinary(input) || !restored->Equals(root))
+  {
+    std::cerr << "ERROR: restored element does not match the parsed one." << endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkPVXMLElement* group = restored->FindNestedElementByName("ProxyGroup");
+  vtkPVXMLElement* proxy = group ? group->FindNestedElementByName("SourceProxy") : nullptr;
+  vtkPVXMLElement* property = proxy ? proxy->FindNestedElement("function") : nullptr;
+  if (!property || strcmp(property->GetAttribute("command"), "SetFunction") != 0 ||
+    property->GetParent() != proxy)
+  {
+    std::cerr << "ERROR: nested elements were not restored." << endl;
+    return EXIT_FAILURE;
+  }
+
+  std::istringstream truncated(binary.substr(0, binary.size() / 2));
+  vtkNew<vtkPVXMLElement> partial;
+  if (partial->LoadBinary(truncated))
+  {
+    std::cerr << "ERROR: truncated binary form was not detected." << endl;
+    return EXIT_FAILURE;
+  }
+
+  // A corrupted length must be rejected before anything is allocated for it.
+  std::string corrupted = binary;
+  const vtkTypeUInt32 hugeLength = 0x7fffffff;
+  std::memcpy(&corrupted[0], &hugeLength, sizeof(hugeLength));
+  std::istringstream corruptedInput(corrupted);
+  vtkNew<vtkPVXMLElement> invalid;
+  if (invalid->LoadBinary(corruptedInput))
+  {
+    std::cerr << "ERROR: corrupted binary form was not detected." << endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,124 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkPVMemoryMappedFile.h"
+
+#include "vtksys/Encoding.hxx"
+
+#include <cstdint>
+
+#if defined(_WIN32)
+#include <windows.h> // CreateFileW, CreateFileMappingW, MapViewOfFile, ...
+#else
+#include <fcntl.h>    // open
+#include <sys/mman.h> // mmap, munmap
+#include <sys/stat.h> // fstat
+#include <unistd.h>   // close
+#endif
+
+//----------------------------------------------------------------------------
+vtkPVMemoryMappedFile::~vtkPVMemoryMappedFile()
+{
+  this->Close();
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVMemoryMappedFile::Open(const char* filename)
+{
+  this->Close();
+  void* data = nullptr;
+  size_t size = 0;
+#if defined(_WIN32)
+  HANDLE file = CreateFileW(vtksys::Encoding::ToWindowsExtendedPath(filename).c_str(), GENERIC_READ,
+    FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE)
+  {
+    return false;
+  }
+  LARGE_INTEGER fileSize;
+  if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0 &&
+    static_cast<unsigned long long>(fileSize.QuadPart) <= SIZE_MAX)
+  {
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping)
+    {
+      // the view keeps the mapping alive.
+      data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+      size = static_cast<size_t>(fileSize.QuadPart);
+      CloseHandle(mapping);
+    }
+  }
+  CloseHandle(file);
+#else
+  int fd = open(filename, O_RDONLY);
+  if (fd < 0)
+  {
+    return false;
+  }
+  struct stat fileStat;
+  if (fstat(fd, &fileStat) == 0 && fileStat.st_size > 0 &&
+    static_cast<unsigned long long>(fileStat.st_size) <= SIZE_MAX)
+  {
+    size = static_cast<size_t>(fileStat.st_size);
+    data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED)
+    {
+      data = nullptr;
+    }
+  }
+  close(fd);
+#endif
+  if (!data)
+  {
+    return false;
+  }
+  this->Data = static_cast<char*>(data);
+  this->Size = size;
+  this->setg(this->Data, this->Data, this->Data + this->Size);
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVMemoryMappedFile::Close()
+{
+  if (this->Data)
+  {
+#if defined(_WIN32)
+    UnmapViewOfFile(this->Data);
+#else
+    munmap(this->Data, this->Size);
+#endif
+  }
+  this->Data = nullptr;
+  this->Size = 0;
+  this->setg(nullptr, nullptr, nullptr);
+}
+
+//----------------------------------------------------------------------------
+vtkPVMemoryMappedFile::pos_type vtkPVMemoryMappedFile::seekoff(
+  off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which)
+{
+  off_type base = 0;
+  if (dir == std::ios_base::cur)
+  {
+    base = this->gptr() - this->eback();
+  }
+  else if (dir == std::ios_base::end)
+  {
+    base = static_cast<off_type>(this->Size);
+  }
+  return this->seekpos(pos_type(base + off), which);
+}
+
+//----------------------------------------------------------------------------
+vtkPVMemoryMappedFile::pos_type vtkPVMemoryMappedFile::seekpos(
+  pos_type pos, std::ios_base::openmode which)
+{
+  const off_type offset = pos;
+  if (!this->Data || !(which & std::ios_base::in) || offset < 0 ||
+    offset > static_cast<off_type>(this->Size))
+  {
+    return pos_type(off_type(-1));
+  }
+  this->setg(this->Data, this->Data + offset, this->Data + this->Size);
+  return pos;
+}
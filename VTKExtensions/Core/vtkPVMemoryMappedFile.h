@@ -0,0 +1,63 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class vtkPVMemoryMappedFile
+ * @brief read-only memory mapping of a file, exposed as a stream buffer
+ *
+ * vtkPVMemoryMappedFile maps a whole file in memory, read-only, and exposes it
+ * as a `std::streambuf`. Readers can hence keep their stream based parsing,
+ * using a `std::istream` on top of this buffer, while decoding bulk data
+ * directly from the mapped memory returned by GetData().
+ *
+ * Open() fails for empty files or when the file cannot be mapped, in which
+ * case readers are expected to fall back to regular file streams.
+ */
+
+#ifndef vtkPVMemoryMappedFile_h
+#define vtkPVMemoryMappedFile_h
+
+#include "vtkPVVTKExtensionsCoreModule.h" // Needed for export macro
+
+#include <cstddef>   // for size_t
+#include <streambuf> // for std::streambuf
+
+class VTKPVVTKEXTENSIONSCORE_EXPORT vtkPVMemoryMappedFile : public std::streambuf
+{
+public:
+  vtkPVMemoryMappedFile() = default;
+  ~vtkPVMemoryMappedFile() override;
+
+  /**
+   * Maps `filename`, closing the file currently mapped, if any. Returns false
+   * if the file could not be mapped.
+   */
+  bool Open(const char* filename);
+
+  /**
+   * Unmaps the file currently mapped, if any.
+   */
+  void Close();
+
+  ///@{
+  /**
+   * Returns the mapped memory and its size, or nullptr and 0 when no file is
+   * mapped.
+   */
+  const char* GetData() const { return this->Data; }
+  size_t GetSize() const { return this->Size; }
+  ///@}
+
+protected:
+  pos_type seekoff(
+    off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override;
+  pos_type seekpos(pos_type pos, std::ios_base::openmode which) override;
+
+private:
+  vtkPVMemoryMappedFile(const vtkPVMemoryMappedFile&) = delete;
+  void operator=(const vtkPVMemoryMappedFile&) = delete;
+
+  char* Data = nullptr;
+  size_t Size = 0;
+};
+
+#endif
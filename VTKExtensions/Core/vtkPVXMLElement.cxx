@@ -3,6 +3,7 @@
 #include "vtkPVXMLElement.h"
 
 #include "vtkCollection.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkSmartPointer.h"
 #include "vtkStringFormatter.h"
@@ -24,6 +25,71 @@ struct vtkPVXMLElementInternals
   std::string CharacterData;
 };
 
+namespace
+{
+// Marks a null string in the binary form.
+constexpr vtkTypeUInt32 vtkNullStringLength = 0xffffffff;
+
+void vtkWriteBinary(ostream& os, vtkTypeUInt32 value)
+{
+  os.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void vtkWriteBinary(ostream& os, const char* str, size_t length)
+{
+  vtkWriteBinary(os, str ? static_cast<vtkTypeUInt32>(length) : vtkNullStringLength);
+  if (str)
+  {
+    os.write(str, length);
+  }
+}
+
+void vtkWriteBinary(ostream& os, const std::string& str)
+{
+  vtkWriteBinary(os, str.c_str(), str.size());
+}
+
+// The readers below fail rather than read past `remaining` bytes, so that a
+// corrupted length cannot trigger a huge allocation.
+bool vtkReadBinary(istream& is, vtkTypeUInt32& value, vtkTypeUInt64& remaining)
+{
+  if (remaining < sizeof(value))
+  {
+    return false;
+  }
+  remaining -= sizeof(value);
+  return static_cast<bool>(is.read(reinterpret_cast<char*>(&value), sizeof(value)));
+}
+
+bool vtkReadBinary(istream& is, std::string& str, bool& isNull, vtkTypeUInt64& remaining)
+{
+  vtkTypeUInt32 length;
+  if (!vtkReadBinary(is, length, remaining))
+  {
+    return false;
+  }
+  isNull = length == vtkNullStringLength;
+  if (isNull || length == 0)
+  {
+    str.clear();
+    return true;
+  }
+  if (remaining < length)
+  {
+    return false;
+  }
+  remaining -= length;
+  str.resize(length);
+  return static_cast<bool>(is.read(&str[0], length));
+}
+
+bool vtkReadBinary(istream& is, std::string& str, vtkTypeUInt64& remaining)
+{
+  bool isNull;
+  return vtkReadBinary(is, str, isNull, remaining);
+}
+}
+
 // Function to check if a string is full of whitespace characters.
 static bool vtkIsSpace(const std::string& str)
 {
@@ -776,3 +842,85 @@ void vtkPVXMLElement::RemoveAttribute(const char* name)
 }
 
 //----------------------------------------------------------------------------
+void vtkPVXMLElement::SaveBinary(ostream& os)
+{
+  vtkWriteBinary(os, this->Name, this->Name ? strlen(this->Name) : 0);
+  vtkWriteBinary(os, this->Id, this->Id ? strlen(this->Id) : 0);
+  vtkWriteBinary(os, static_cast<vtkTypeUInt32>(this->Internal->AttributeNames.size()));
+  for (size_t cc = 0; cc < this->Internal->AttributeNames.size(); ++cc)
+  {
+    vtkWriteBinary(os, this->Internal->AttributeNames[cc]);
+    vtkWriteBinary(os, this->Internal->AttributeValues[cc]);
+  }
+  vtkWriteBinary(os, this->Internal->CharacterData);
+  vtkWriteBinary(os, static_cast<vtkTypeUInt32>(this->Internal->NestedElements.size()));
+  for (const auto& nested : this->Internal->NestedElements)
+  {
+    nested->SaveBinary(os);
+  }
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVXMLElement::LoadBinary(istream& is)
+{
+  const std::streampos start = is.tellg();
+  if (start < 0 || !is.seekg(0, std::ios::end))
+  {
+    return false;
+  }
+  const std::streampos end = is.tellg();
+  if (end < start || !is.seekg(start))
+  {
+    return false;
+  }
+  vtkTypeUInt64 remaining = static_cast<vtkTypeUInt64>(end - start);
+  return this->LoadBinary(is, remaining);
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVXMLElement::LoadBinary(istream& is, vtkTypeUInt64& remaining)
+{
+  std::string buffer;
+  bool isNull;
+  if (!vtkReadBinary(is, buffer, isNull, remaining))
+  {
+    return false;
+  }
+  this->SetName(isNull ? nullptr : buffer.c_str());
+  if (!vtkReadBinary(is, buffer, isNull, remaining))
+  {
+    return false;
+  }
+  this->SetId(isNull ? nullptr : buffer.c_str());
+
+  vtkTypeUInt32 count;
+  if (!vtkReadBinary(is, count, remaining))
+  {
+    return false;
+  }
+  std::string value;
+  for (vtkTypeUInt32 cc = 0; cc < count; ++cc)
+  {
+    if (!vtkReadBinary(is, buffer, remaining) || !vtkReadBinary(is, value, remaining))
+    {
+      return false;
+    }
+    this->Internal->AttributeNames.push_back(buffer);
+    this->Internal->AttributeValues.push_back(value);
+  }
+  if (!vtkReadBinary(is, this->Internal->CharacterData, remaining) ||
+    !vtkReadBinary(is, count, remaining))
+  {
+    return false;
+  }
+  for (vtkTypeUInt32 cc = 0; cc < count; ++cc)
+  {
+    vtkNew<vtkPVXMLElement> nested;
+    if (!nested->LoadBinary(is, remaining))
+    {
+      return false;
+    }
+    this->AddNestedElement(nested);
+  }
+  return true;
+}
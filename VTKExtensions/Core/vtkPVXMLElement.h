@@ -207,6 +207,20 @@ public:
   void PrintXML();
   ///@}
 
+  ///@{
+  /**
+   * Serialize this element and its nested elements in a compact binary form,
+   * or restore them from it. Restoring is much faster than parsing the
+   * equivalent XML. The binary form is not portable across platforms and is
+   * only meant to be read back by the same build, e.g. for caching.
+   * LoadBinary() must be called on an empty element, on a seekable stream,
+   * and returns false if the stream is truncated or corrupted. Lengths read
+   * from the stream are checked against its size before allocating anything.
+   */
+  void SaveBinary(ostream& os);
+  bool LoadBinary(istream& is);
+  ///@}
+
   /**
    * Merges another element with this one, both having the same name.
    * If any attribute, character data or nested element exists in both,
@@ -273,6 +287,9 @@ protected:
   vtkPVXMLElement* LookupElementUpScope(const char* id);
   void SetParent(vtkPVXMLElement* parent);
 
+  // Restores the binary form, reading at most `remaining` bytes.
+  bool LoadBinary(istream& is, vtkTypeUInt64& remaining);
+
   friend class vtkPVXMLParser;
 
 private:
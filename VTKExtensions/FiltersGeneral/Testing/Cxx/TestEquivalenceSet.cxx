@@ -0,0 +1,94 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "vtkEquivalenceSet.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+
+#include <algorithm>
+#include <iostream>
+#include <map>
+#include <vector>
+
+#define vtk_assert(x)                                                                              \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    std::cerr << "On line " << __LINE__ << " ERROR: Condition FAILED!! : " << #x << endl;          \
+    return EXIT_FAILURE;                                                                           \
+  }
+
+namespace
+{
+// Reference implementation: plain union-find with the smallest id as root.
+int FindRoot(std::vector<int>& parents, int id)
+{
+  while (parents[id] != id)
+  {
+    id = parents[id];
+  }
+  return id;
+}
+}
+
+int TestEquivalenceSet(int, char*[])
+{
+  constexpr int numberOfMembers = 2000;
+  constexpr int numberOfEquivalences = 1500;
+
+  vtkNew<vtkEquivalenceSet> set;
+  std::vector<int> parents(numberOfMembers);
+  for (int ii = 0; ii < numberOfMembers; ++ii)
+  {
+    parents[ii] = ii;
+  }
+
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(8775070);
+  set->AddEquivalence(numberOfMembers - 1, numberOfMembers - 1);
+  for (int ii = 0; ii < numberOfEquivalences; ++ii)
+  {
+    int id1 = static_cast<int>(random->GetNextRangeValue(0, numberOfMembers));
+    int id2 = static_cast<int>(random->GetNextRangeValue(0, numberOfMembers));
+    id1 = std::min(id1, numberOfMembers - 1);
+    id2 = std::min(id2, numberOfMembers - 1);
+    set->AddEquivalence(id1, id2);
+
+    int root1 = ::FindRoot(parents, id1);
+    int root2 = ::FindRoot(parents, id2);
+    parents[std::max(root1, root2)] = std::min(root1, root2);
+
+    // Lookups before resolution must agree with the reference.
+    vtk_assert(set->GetEquivalentSetId(id2) == ::FindRoot(parents, id2));
+  }
+
+  vtk_assert(set->GetNumberOfMembers() == numberOfMembers);
+  int numberOfSets = set->ResolveEquivalences();
+
+  // Resolved set ids are sequential, in the order of the smallest member.
+  std::map<int, int> rootToSet;
+  for (int ii = 0; ii < numberOfMembers; ++ii)
+  {
+    int root = ::FindRoot(parents, ii);
+    auto iter = rootToSet.find(root);
+    if (iter == rootToSet.end())
+    {
+      iter = rootToSet.emplace(root, static_cast<int>(rootToSet.size())).first;
+    }
+    vtk_assert(set->GetEquivalentSetId(ii) == iter->second);
+  }
+  vtk_assert(numberOfSets == static_cast<int>(rootToSet.size()));
+
+  // A long chain of equivalences, built from the largest id down, is collapsed
+  // by the first lookup of its last member.
+  constexpr int chainLength = 1000000;
+  vtkNew<vtkEquivalenceSet> chain;
+  for (int ii = chainLength - 1; ii > 0; --ii)
+  {
+    chain->AddEquivalence(ii, ii - 1);
+  }
+  chain->AddEquivalence(chainLength - 1, 0);
+  vtk_assert(chain->ResolveEquivalences() == 1);
+  vtk_assert(chain->GetEquivalentSetId(chainLength - 1) == 0);
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,183 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkDataSet.h"
+#include "vtkDoubleArray.h"
+#include "vtkImageData.h"
+#include "vtkLogger.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPVArrayCalculator.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <string>
+
+#define VERIFY(x, y)                                                                               \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    vtkLogF(ERROR, y);                                                                             \
+    return false;                                                                                  \
+  }
+
+namespace
+{
+constexpr unsigned int NumberOfBlocks = 36;
+
+void AddArray(vtkDataSetAttributes* attributes, const char* name, int numberOfComponents,
+  vtkIdType numberOfTuples, double offset)
+{
+  vtkNew<vtkDoubleArray> array;
+  array->SetName(name);
+  array->SetNumberOfComponents(numberOfComponents);
+  array->SetNumberOfTuples(numberOfTuples);
+  for (vtkIdType cc = 0; cc < numberOfTuples * numberOfComponents; ++cc)
+  {
+    array->SetValue(cc, offset + 0.5 * cc);
+  }
+  attributes->AddArray(array);
+}
+
+// Leaves cycle through images with all arrays, empty leaves, polydata with
+// some arrays, datasets without points, images with some arrays and leaves
+// sharing the data object of an earlier leaf.
+vtkSmartPointer<vtkDataObject> CreateBlock(vtkMultiBlockDataSet* input, unsigned int index)
+{
+  switch (index % 6)
+  {
+    case 0:
+    {
+      auto image = vtkSmartPointer<vtkImageData>::New();
+      const int size = 2 + static_cast<int>(index % 5);
+      image->SetDimensions(size, size + 1, size);
+      image->SetOrigin(index, 0, 0);
+      ::AddArray(image->GetPointData(), "Scalars", 1, image->GetNumberOfPoints(), index);
+      ::AddArray(image->GetPointData(), "Vectors", 3, image->GetNumberOfPoints(), -1.0 * index);
+      ::AddArray(image->GetCellData(), "CellScalars", 1, image->GetNumberOfCells(), index);
+      return image;
+    }
+    case 1:
+      return nullptr;
+    case 2:
+    {
+      auto polyData = vtkSmartPointer<vtkPolyData>::New();
+      vtkNew<vtkPoints> points;
+      vtkNew<vtkCellArray> vertices;
+      for (vtkIdType cc = 0; cc < static_cast<vtkIdType>(5 + index); ++cc)
+      {
+        points->InsertNextPoint(index + 0.25 * cc, cc, -1.0 * cc);
+        vertices->InsertNextCell(1, &cc);
+      }
+      polyData->SetPoints(points);
+      polyData->SetVerts(vertices);
+      ::AddArray(polyData->GetPointData(), "Scalars", 1, polyData->GetNumberOfPoints(), index);
+      return polyData;
+    }
+    case 3:
+      return vtkSmartPointer<vtkUnstructuredGrid>::New();
+    case 4:
+    {
+      auto image = vtkSmartPointer<vtkImageData>::New();
+      image->SetDimensions(3, 2, 2);
+      image->SetOrigin(0, index, 0);
+      ::AddArray(image->GetPointData(), "Vectors", 3, image->GetNumberOfPoints(), index);
+      ::AddArray(image->GetCellData(), "CellScalars", 1, image->GetNumberOfCells(), -1.0 * index);
+      return image;
+    }
+    default:
+      return input->GetBlock(index - 5);
+  }
+}
+
+vtkSmartPointer<vtkMultiBlockDataSet> Evaluate(vtkMultiBlockDataSet* input,
+  const char* expression, int attributeType, int numberOfThreads)
+{
+  vtkNew<vtkPVArrayCalculator> calculator;
+  calculator->SetInputData(input);
+  calculator->SetAttributeType(attributeType);
+  calculator->SetFunction(expression);
+  calculator->SetResultArrayName("Result");
+  vtkSMPTools::LocalScope(vtkSMPTools::Config(numberOfThreads), [&]() { calculator->Update(); });
+  return vtkMultiBlockDataSet::SafeDownCast(calculator->GetOutputDataObject(0));
+}
+
+// Evaluating the leaves concurrently must give the same result as evaluating
+// them one after the other.
+bool TestExpression(vtkMultiBlockDataSet* input, const char* expression, int attributeType)
+{
+  vtkLogF(INFO, "Expression: %s", expression);
+  auto serial = ::Evaluate(input, expression, attributeType, 1);
+  auto threaded = ::Evaluate(input, expression, attributeType, 4);
+  VERIFY(serial && threaded, "vtkMultiBlockDataSet output expected.");
+  VERIFY(threaded->GetNumberOfBlocks() == NumberOfBlocks, "Unexpected number of blocks.");
+
+  bool foundResult = false;
+  for (unsigned int cc = 0; cc < NumberOfBlocks; ++cc)
+  {
+    auto serialLeaf = vtkDataSet::SafeDownCast(serial->GetBlock(cc));
+    auto threadedLeaf = vtkDataSet::SafeDownCast(threaded->GetBlock(cc));
+    VERIFY((serialLeaf == nullptr) == (threadedLeaf == nullptr), "Unexpected empty leaf.");
+    if (!serialLeaf)
+    {
+      continue;
+    }
+    VERIFY(cc % 6 != 5 || threadedLeaf != threaded->GetBlock(cc - 5),
+      "Shared input leaves must have distinct output leaves.");
+    VERIFY(threadedLeaf->GetClassName() == std::string(serialLeaf->GetClassName()),
+      "Unexpected leaf type.");
+    VERIFY(threadedLeaf->GetNumberOfPoints() == serialLeaf->GetNumberOfPoints(),
+      "Leaves were not assigned in order.");
+
+    vtkDataArray* serialResult = serialLeaf->GetAttributes(attributeType)->GetArray("Result");
+    vtkDataArray* threadedResult = threadedLeaf->GetAttributes(attributeType)->GetArray("Result");
+    VERIFY((serialResult == nullptr) == (threadedResult == nullptr), "Unexpected result array.");
+    if (!serialResult)
+    {
+      continue;
+    }
+    foundResult = true;
+    VERIFY(threadedResult->GetDataType() == serialResult->GetDataType(),
+      "Unexpected result type.");
+    VERIFY(threadedResult->GetNumberOfComponents() == serialResult->GetNumberOfComponents(),
+      "Unexpected number of components.");
+    VERIFY(threadedResult->GetNumberOfTuples() == serialResult->GetNumberOfTuples(),
+      "Unexpected result size.");
+    for (vtkIdType id = 0; id < serialResult->GetNumberOfTuples(); ++id)
+    {
+      for (int comp = 0; comp < serialResult->GetNumberOfComponents(); ++comp)
+      {
+        VERIFY(threadedResult->GetComponent(id, comp) == serialResult->GetComponent(id, comp),
+          "Unexpected result value.");
+      }
+    }
+  }
+  VERIFY(foundResult, "The expression was not evaluated on any leaf.");
+  return true;
+}
+}
+
+int TestPVArrayCalculatorComposite(int, char*[])
+{
+  vtkNew<vtkMultiBlockDataSet> input;
+  input->SetNumberOfBlocks(NumberOfBlocks);
+  for (unsigned int cc = 0; cc < NumberOfBlocks; ++cc)
+  {
+    input->SetBlock(cc, ::CreateBlock(input, cc));
+  }
+
+  // Arrays missing from some leaves, coordinates, vector results and cell
+  // data.
+  bool success = ::TestExpression(input, "Scalars * 2 + coordsX", vtkDataObject::POINT);
+  success = ::TestExpression(input, "mag(Vectors)", vtkDataObject::POINT) && success;
+  success = ::TestExpression(input, "Vectors * Scalars + coords", vtkDataObject::POINT) && success;
+  success = ::TestExpression(input, "Vectors_Y - Vectors_Z", vtkDataObject::POINT) && success;
+  success = ::TestExpression(input, "CellScalars / 2", vtkDataObject::CELL) && success;
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -65,16 +65,30 @@ void vtkEquivalenceSet::PrintSelf(ostream& os, vtkIndent indent)
 // Return the id of the equivalent set.
 int vtkEquivalenceSet::GetEquivalentSetId(int memberId)
 {
-  int ref;
+  int ref = this->GetReference(memberId);
+  if (this->Resolved)
+  {
+    return ref;
+  }
 
-  ref = this->GetReference(memberId);
-  while (!this->Resolved && ref != memberId)
+  int setId = memberId;
+  while (ref != setId)
   {
+    setId = ref;
+    ref = this->GetReference(setId);
+  }
+
+  // Compress the path: make every member of the chain point directly to the
+  // set id. The set id is the smallest id of the chain, so members still point
+  // to an id smaller than themselves and later lookups are constant time.
+  while (memberId != setId)
+  {
+    ref = this->EquivalenceArray->GetValue(memberId);
+    this->EquivalenceArray->SetValue(memberId, setId);
     memberId = ref;
-    ref = this->GetReference(memberId);
   }
 
-  return ref;
+  return setId;
 }
 
 //----------------------------------------------------------------------------
@@ -160,29 +174,36 @@ vtkIdType vtkEquivalenceSet::Capacity()
 // id1 must be less than or equal to id2.
 void vtkEquivalenceSet::EquateInternal(int id1, int id2)
 {
-  // This is the reference that might be orphaned in this process.
-  int oldRef = this->GetEquivalentSetId(id2);
-
-  // The two ids are already equal (not the only way they might be equal).
-  if (oldRef == id1)
+  // This used to be recursive, which could overflow the stack with long
+  // chains of equivalences. Each iteration handles one former recursion.
+  while (true)
   {
-    return;
-  }
+    // This is the reference that might be orphaned in this process.
+    int oldRef = this->GetEquivalentSetId(id2);
 
-  // The only problem we could encounter is changing a reference.
-  // we do not want to orphan anything previously referenced.
-  if (oldRef == id2)
-  {
-    this->EquivalenceArray->SetValue(id2, id1);
-  }
-  else if (oldRef > id1)
-  {
-    this->EquivalenceArray->SetValue(id2, id1);
-    this->EquateInternal(id1, oldRef);
-  }
-  else
-  { // oldRef < id1
-    this->EquateInternal(oldRef, id1);
+    // The two ids are already equal (not the only way they might be equal).
+    if (oldRef == id1)
+    {
+      return;
+    }
+
+    // The only problem we could encounter is changing a reference.
+    // we do not want to orphan anything previously referenced.
+    if (oldRef == id2)
+    {
+      this->EquivalenceArray->SetValue(id2, id1);
+      return;
+    }
+    else if (oldRef > id1)
+    {
+      this->EquivalenceArray->SetValue(id2, id1);
+      id2 = oldRef;
+    }
+    else
+    { // oldRef < id1
+      id2 = id1;
+      id1 = oldRef;
+    }
   }
 }
 
@@ -8,19 +8,24 @@
 #include "vtkCompositeDataSet.h"
 #include "vtkDataObject.h"
 #include "vtkDataSet.h"
+#include "vtkFieldData.h"
 #include "vtkGraph.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
 #include "vtkPVPostFilter.h"
 #include "vtkPointData.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkTable.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <set>
 #include <sstream>
 #include <string>
+#include <vector>
 
 namespace
 {
@@ -64,9 +69,22 @@ public:
 };
 }
 
+class vtkPVArrayCalculator::vtkInternals
+{
+public:
+  // Arrays registered as variables since the last reset, one per signature.
+  std::vector<vtkSmartPointer<vtkAbstractArray>> VariableArrays;
+  std::set<std::string> VariableArraySignatures;
+
+  // Set on the calculators evaluating leaves on behalf of another one: their
+  // variables are registered once, before any leaf is evaluated.
+  bool IsLeafWorker = false;
+};
+
 vtkStandardNewMacro(vtkPVArrayCalculator);
 // ----------------------------------------------------------------------------
 vtkPVArrayCalculator::vtkPVArrayCalculator()
+  : Internals(new vtkInternals())
 {
   // We'll tell the superclass about all arrays (partial and full) and have it
   // ignore missing arrays when evaluating the calculator.
@@ -84,6 +102,8 @@ void vtkPVArrayCalculator::ResetArrayAndVariableNames()
   // It's safe to call these methods in RequestData() since they don't call
   // this->Modified().
   this->RemoveAllVariables();
+  this->Internals->VariableArrays.clear();
+  this->Internals->VariableArraySignatures.clear();
 }
 
 // ----------------------------------------------------------------------------
@@ -105,83 +125,149 @@ void vtkPVArrayCalculator::AddArrayAndVariableNames(
   for (int j = 0; j < numberOfArrays; j++)
   {
     vtkAbstractArray* array = inDataAttrs->GetAbstractArray(j);
-    const char* arrayName = array->GetName();
-    if (!arrayName)
+    if (!array->GetName())
     {
       vtkWarningMacro("Skipping unnamed array at index " << j);
       continue;
     }
+    this->AddArrayVariableNames(array);
+  }
+}
 
-    int numberComps = array->GetNumberOfComponents();
+// ----------------------------------------------------------------------------
+void vtkPVArrayCalculator::AddArrayVariableNames(vtkAbstractArray* array)
+{
+  const char* arrayName = array->GetName();
+  int numberComps = array->GetNumberOfComponents();
 
-    if (numberComps == 1)
+  // Blocks of a composite dataset usually share their arrays: register the
+  // variables of each distinct array only once.
+  std::ostringstream signature;
+  signature << arrayName << '\n' << numberComps;
+  for (int i = 0; i < numberComps; i++)
+  {
+    const char* componentName = array->GetComponentName(i);
+    signature << '\n' << (componentName ? componentName : "");
+  }
+  if (!this->Internals->VariableArraySignatures.insert(signature.str()).second)
+  {
+    return;
+  }
+  this->Internals->VariableArrays.emplace_back(array);
+
+  if (numberComps == 1)
+  {
+    std::string validVariableName = vtkArrayCalculator::CheckValidVariableName(arrayName);
+    this->AddScalarVariable(validVariableName.c_str(), arrayName);
+    if (validVariableName == arrayName && !vtkInQuotes(arrayName))
     {
-      std::string validVariableName = vtkArrayCalculator::CheckValidVariableName(arrayName);
-      this->AddScalarVariable(validVariableName.c_str(), arrayName);
-      if (validVariableName == arrayName && !vtkInQuotes(arrayName))
-      {
-        this->AddScalarVariable(vtkQuoteString(arrayName).c_str(), arrayName);
-      }
+      this->AddScalarVariable(vtkQuoteString(arrayName).c_str(), arrayName);
     }
-    else
+  }
+  else
+  {
+    for (int i = 0; i < numberComps; i++)
     {
-      for (int i = 0; i < numberComps; i++)
-      {
-        std::set<std::string> possibleNames;
+      std::set<std::string> possibleNames;
 
-        if (array->GetComponentName(i))
-        {
-          std::string name = vtkJoinToString(arrayName, array->GetComponentName(i));
-          std::string validVariableName = vtkArrayCalculator::CheckValidVariableName(name.c_str());
-          possibleNames.insert(validVariableName);
-          if (validVariableName == name && !vtkInQuotes(name.c_str()))
-          {
-            possibleNames.insert(vtkQuoteString(name));
-          }
-        }
-        std::string name =
-          vtkJoinToString(arrayName, vtkPVPostFilter::DefaultComponentName(i, numberComps));
+      if (array->GetComponentName(i))
+      {
+        std::string name = vtkJoinToString(arrayName, array->GetComponentName(i));
         std::string validVariableName = vtkArrayCalculator::CheckValidVariableName(name.c_str());
         possibleNames.insert(validVariableName);
         if (validVariableName == name && !vtkInQuotes(name.c_str()))
         {
           possibleNames.insert(vtkQuoteString(name));
         }
+      }
+      std::string name =
+        vtkJoinToString(arrayName, vtkPVPostFilter::DefaultComponentName(i, numberComps));
+      std::string validVariableName = vtkArrayCalculator::CheckValidVariableName(name.c_str());
+      possibleNames.insert(validVariableName);
+      if (validVariableName == name && !vtkInQuotes(name.c_str()))
+      {
+        possibleNames.insert(vtkQuoteString(name));
+      }
 
-        // also put a <ArrayName>_<ComponentNumber> to handle past versions of
-        // vtkPVArrayCalculator when component names were not used and index was
-        // used e.g. state files prior to fixing of BUG #12951.
-        std::string defaultName = vtkJoinToString(arrayName, i);
-
-        std::string defaultValidVariableName =
-          vtkArrayCalculator::CheckValidVariableName(defaultName.c_str());
-        possibleNames.insert(defaultValidVariableName);
-        if (defaultValidVariableName == defaultName && !vtkInQuotes(defaultName.c_str()))
-        {
-          possibleNames.insert(vtkQuoteString(defaultName));
-        }
+      // also put a <ArrayName>_<ComponentNumber> to handle past versions of
+      // vtkPVArrayCalculator when component names were not used and index was
+      // used e.g. state files prior to fixing of BUG #12951.
+      std::string defaultName = vtkJoinToString(arrayName, i);
 
-        std::for_each(
-          possibleNames.begin(), possibleNames.end(), add_scalar_variables(this, arrayName, i));
+      std::string defaultValidVariableName =
+        vtkArrayCalculator::CheckValidVariableName(defaultName.c_str());
+      possibleNames.insert(defaultValidVariableName);
+      if (defaultValidVariableName == defaultName && !vtkInQuotes(defaultName.c_str()))
+      {
+        possibleNames.insert(vtkQuoteString(defaultName));
       }
 
-      if (numberComps > 1)
+      std::for_each(
+        possibleNames.begin(), possibleNames.end(), add_scalar_variables(this, arrayName, i));
+    }
+
+    if (numberComps > 1)
+    {
+      std::string validVariableName = vtkArrayCalculator::CheckValidVariableName(arrayName);
+      this->AddVectorVariable(validVariableName.c_str(), arrayName);
+      if (validVariableName == arrayName && !vtkInQuotes(arrayName))
       {
-        std::string validVariableName = vtkArrayCalculator::CheckValidVariableName(arrayName);
-        this->AddVectorVariable(validVariableName.c_str(), arrayName);
-        if (validVariableName == arrayName && !vtkInQuotes(arrayName))
-        {
-          this->AddVectorVariable(vtkQuoteString(arrayName).c_str(), arrayName);
-        }
+        this->AddVectorVariable(vtkQuoteString(arrayName).c_str(), arrayName);
       }
     }
   }
 }
 
+// ----------------------------------------------------------------------------
+void vtkPVArrayCalculator::InitializeLeafCalculator(vtkPVArrayCalculator* calculator)
+{
+  calculator->Internals->IsLeafWorker = true;
+  calculator->SetFunction(this->GetFunction());
+  calculator->SetResultArrayName(this->GetResultArrayName());
+  calculator->SetResultArrayType(this->GetResultArrayType());
+  calculator->SetAttributeType(this->GetAttributeType());
+  calculator->SetResultNormals(this->GetResultNormals());
+  calculator->SetResultTCoords(this->GetResultTCoords());
+  calculator->SetCoordinateResults(this->GetCoordinateResults());
+  calculator->SetReplaceInvalidValues(this->GetReplaceInvalidValues());
+  calculator->SetReplacementValue(this->GetReplacementValue());
+  calculator->SetIgnoreMissingArrays(this->GetIgnoreMissingArrays());
+  calculator->SetFunctionParserType(this->GetFunctionParserType());
+
+  calculator->ResetArrayAndVariableNames();
+  calculator->AddCoordinateVariableNames();
+  for (const auto& array : this->Internals->VariableArrays)
+  {
+    calculator->AddArrayVariableNames(array);
+  }
+}
+
+// ----------------------------------------------------------------------------
+vtkSmartPointer<vtkDataObject> vtkPVArrayCalculator::ExecuteLeafBlock(vtkDataObject* block)
+{
+  this->SetInputData(block);
+  this->Update();
+  vtkDataObject* result = this->GetOutputDataObject(0);
+  vtkSmartPointer<vtkDataObject> output;
+  if (result)
+  {
+    output.TakeReference(result->NewInstance());
+    output->ShallowCopy(result);
+  }
+  this->SetInputData(nullptr);
+  return output;
+}
+
 // ----------------------------------------------------------------------------
 int vtkPVArrayCalculator::RequestData(
   vtkInformation* request, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
 {
+  if (this->Internals->IsLeafWorker)
+  {
+    // The variables were registered before evaluating any leaf.
+    return this->Superclass::RequestData(request, inputVector, outputVector);
+  }
+
   vtkDataObject* input = vtkDataObject::GetData(inputVector[0], 0);
 
   // Ensure the mtime is not modified in RequestData.
@@ -195,6 +281,7 @@ int vtkPVArrayCalculator::RequestData(
 
   // Add arrays to the calculator
   auto inputCD = vtkCompositeDataSet::GetData(inputVector[0], 0);
+  std::vector<vtkDataObject*> blocks;
   if (inputCD)
   {
     vtkSmartPointer<vtkCompositeDataIterator> cdIter;
@@ -206,6 +293,7 @@ int vtkPVArrayCalculator::RequestData(
       vtkDataObject* dataObject = cdIter->GetCurrentDataObject();
       if (dataObject)
       {
+        blocks.push_back(dataObject);
         int attributeType = this->GetAttributeTypeFromInput(dataObject);
         vtkDataSetAttributes* dataAttrs = dataObject->GetAttributes(attributeType);
         if (dataAttrs)
@@ -242,7 +330,79 @@ int vtkPVArrayCalculator::RequestData(
   assert(this->GetMTime() == mtime && "post: mtime cannot be changed in RequestData()");
   (void)mtime;
 
-  return this->Superclass::RequestData(request, inputVector, outputVector);
+  auto outputCD = vtkCompositeDataSet::GetData(outputVector, 0);
+  const vtkIdType numberOfBlocks = static_cast<vtkIdType>(blocks.size());
+  if (!outputCD || numberOfBlocks < 2 || vtkSMPTools::GetEstimatedNumberOfThreads() < 2 ||
+    this->GetAttributeType() == vtkDataObject::FIELD)
+  {
+    int result = this->Superclass::RequestData(request, inputVector, outputVector);
+    this->Internals->VariableArrays.clear();
+    return result;
+  }
+
+  // Leaves are independent of each other: evaluate them concurrently, each
+  // thread using its own calculator sharing the variables registered above.
+  // A data object appearing as several leaves is evaluated once, so that no
+  // two threads update the same input. Only the calling thread checks for
+  // abort requests and reports progress.
+  std::vector<vtkDataObject*> distinctBlocks(blocks);
+  std::sort(distinctBlocks.begin(), distinctBlocks.end());
+  distinctBlocks.erase(
+    std::unique(distinctBlocks.begin(), distinctBlocks.end()), distinctBlocks.end());
+  const vtkIdType numberOfDistinctBlocks = static_cast<vtkIdType>(distinctBlocks.size());
+  std::vector<vtkSmartPointer<vtkDataObject>> distinctOutputs(numberOfDistinctBlocks);
+  vtkSMPThreadLocalObject<vtkPVArrayCalculator> calculators;
+  std::atomic<vtkIdType> numberOfEvaluatedBlocks(0);
+  vtkSMPTools::For(0, numberOfDistinctBlocks, 1,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      vtkPVArrayCalculator* calculator = calculators.Local();
+      if (!calculator->Internals->IsLeafWorker)
+      {
+        this->InitializeLeafCalculator(calculator);
+      }
+      const bool isFirst = vtkSMPTools::GetSingleThread();
+      for (vtkIdType cc = begin; cc < end; ++cc)
+      {
+        if (isFirst)
+        {
+          this->CheckAbort();
+          this->UpdateProgress(
+            static_cast<double>(numberOfEvaluatedBlocks) / numberOfDistinctBlocks);
+        }
+        if (this->GetAbortExecute())
+        {
+          break;
+        }
+        distinctOutputs[cc] = calculator->ExecuteLeafBlock(distinctBlocks[cc]);
+        ++numberOfEvaluatedBlocks;
+      }
+    });
+  this->Internals->VariableArrays.clear();
+
+  outputCD->CopyStructure(inputCD);
+  outputCD->GetFieldData()->ShallowCopy(inputCD->GetFieldData());
+  vtkSmartPointer<vtkCompositeDataIterator> outIter;
+  outIter.TakeReference(inputCD->NewIterator());
+  outIter->SkipEmptyNodesOn();
+  std::vector<bool> assigned(numberOfDistinctBlocks, false);
+  vtkIdType blockIndex = 0;
+  for (outIter->InitTraversal(); !outIter->IsDoneWithTraversal(); outIter->GoToNextItem())
+  {
+    const auto distinct =
+      std::lower_bound(distinctBlocks.begin(), distinctBlocks.end(), blocks[blockIndex++]) -
+      distinctBlocks.begin();
+    vtkSmartPointer<vtkDataObject> blockOutput = distinctOutputs[distinct];
+    if (blockOutput && assigned[distinct])
+    {
+      // Every occurrence of a shared leaf gets its own output.
+      blockOutput.TakeReference(distinctOutputs[distinct]->NewInstance());
+      blockOutput->ShallowCopy(distinctOutputs[distinct]);
+    }
+    assigned[distinct] = true;
+    outputCD->SetDataSet(outIter, blockOutput);
+  }
+  return 1;
 }
 
 // ----------------------------------------------------------------------------
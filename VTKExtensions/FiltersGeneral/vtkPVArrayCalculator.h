@@ -13,6 +13,10 @@
  *  their mapping with the input fields. We extend vtkArrayCalculator to
  *  automatically add scalar/vector fields mapping using the array available in
  *  the input.
+ *
+ *  For composite datasets, the variables are registered once for the union of
+ *  the arrays in all leaves, and independent leaves are evaluated
+ *  concurrently using vtkSMPTools.
  * @sa
  *  vtkArrayCalculator vtkFunctionParser
  */
@@ -22,7 +26,11 @@
 
 #include "vtkArrayCalculator.h"
 #include "vtkPVVTKExtensionsFiltersGeneralModule.h" //needed for exports
+#include "vtkSmartPointer.h"                        // for vtkSmartPointer
+
+#include <memory> // for std::unique_ptr
 
+class vtkAbstractArray;
 class vtkDataObject;
 class vtkDataSetAttributes;
 
@@ -75,6 +83,29 @@ protected:
 private:
   vtkPVArrayCalculator(const vtkPVArrayCalculator&) = delete;
   void operator=(const vtkPVArrayCalculator&) = delete;
+
+  /**
+   * Adds the variables for a single array, unless an array with the same name
+   * and components was already added since the last call to
+   * ResetArrayAndVariableNames().
+   */
+  void AddArrayVariableNames(vtkAbstractArray* array);
+
+  /**
+   * Configures a calculator evaluating leaves on behalf of this one: same
+   * settings and the variables registered by this calculator.
+   */
+  void InitializeLeafCalculator(vtkPVArrayCalculator* calculator);
+
+  /**
+   * Evaluates the expression on a single leaf of a composite dataset and
+   * returns a copy of the result. Used by the threads evaluating leaves
+   * concurrently.
+   */
+  vtkSmartPointer<vtkDataObject> ExecuteLeafBlock(vtkDataObject* block);
+
+  class vtkInternals;
+  std::unique_ptr<vtkInternals> Internals;
 };
 //@}
 
@@ -13,6 +13,8 @@
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkRectilinearGrid.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
 
 #include "vtkCompositeDataIterator.h"
 #include "vtkCompositeDataPipeline.h"
@@ -84,6 +86,25 @@ public:
     return allExist;
   }
 
+  // Records the number of components of the integrable arrays the first time
+  // a block providing all of them is found.
+  void ObtainComponentNumbers(vtkRectilinearGrid* rectGrid)
+  {
+    if (this->ComponentNumbersObtained || !this->IntegrablePointDataArraysAvailable(rectGrid))
+    {
+      return;
+    }
+
+    this->ComponentNumbersObtained = 1;
+    this->NumberIntegralComponents = 0;
+    for (const std::string& arayName : this->IntegrableAttributeNames)
+    {
+      int numComps = rectGrid->GetPointData()->GetArray(arayName.c_str())->GetNumberOfComponents();
+      this->NumberIntegralComponents += numComps;
+      this->ComponentNumbersPerArray.push_back(numComps);
+    }
+  }
+
   int IntegrableCellDataArraysAvailable(vtkPolyData* polyData)
   {
     int numArays = static_cast<int>(this->IntegrableAttributeNames.size());
@@ -1167,7 +1188,6 @@ void vtkRectilinearGridConnectivity::ExtractFragments(vtkRectilinearGrid** dualG
   int i;
   int* maxFsize = nullptr;
   vtkPolyData** surfaces = nullptr;
-  vtkPolyData* plyHedra = nullptr;
   vtkPoints* mbPoints = nullptr;
   vtkIncrementalOctreePointLocator* mbPntLoc = nullptr;
 
@@ -1182,36 +1202,64 @@ void vtkRectilinearGridConnectivity::ExtractFragments(vtkRectilinearGrid** dualG
 
   maxFsize = new int[numBlcks];
   surfaces = new vtkPolyData*[numBlcks];
+
+  // The number of components of the integrable arrays is shared by all the
+  // blocks. Record it before the blocks are processed concurrently below.
   for (i = 0; i < numBlcks; i++)
   {
-    plyHedra = vtkPolyData::New();
-    surfaces[i] = vtkPolyData::New();
+    this->Internal->ObtainComponentNumbers(dualGrds[i]);
+  }
+
+  // The polyhedra of the blocks are independent of each other and are
+  // extracted concurrently, whereas the fragment polygons share the multi-
+  // block point locator and are extracted serially, in block order. Blocks
+  // are processed in batches of one per thread to bound the number of
+  // polyhedra kept in memory.
+  const char* fracName = this->GetVolumeFractionArrayName(partIndx);
+  double isoValue = this->VolumeFractionSurfaceValue * this->Internal->VolumeFractionValueScale;
+  int batchSiz = std::max(1, vtkSMPTools::GetEstimatedNumberOfThreads());
+  std::vector<vtkSmartPointer<vtkPolyData>> plyHedra(batchSiz);
+  for (int batchBeg = 0; batchBeg < numBlcks; batchBeg += batchSiz)
+  {
+    int batchEnd = std::min(batchBeg + batchSiz, numBlcks);
 
-    // perform marching cubes on the dual grid to obtain the greater-than-
+    // perform marching cubes on the dual grids to obtain the greater-than-
     // isovalue polyhedra, of which each 2D polygon is assigned with a global
     // volume Id
-    this->ExtractFragmentPolyhedra(dualGrds[i], this->GetVolumeFractionArrayName(partIndx),
-      this->VolumeFractionSurfaceValue * this->Internal->VolumeFractionValueScale, plyHedra);
-
-    // # clear and re-init EquivalenceSet
-    // # clear and re-init the face hash with the number of points contained
-    //   in the polyhedra
-    // # add each face of the polyhedra to the face hash, with the block-based
-    //   local point Id as the face hash entry / index, assign it with the face
-    //   index (in the polyhedra, via PolygonId) for late access to the original
-    //   2D polygon in the polyhedra, and assign it with the volume index (in
-    //   the polyhedra, via VolumeId)
-    // # resolve the polygons of the polyhedra in the face hash
-    // # obtain the remaining / exterior faces from the face hash and group them
-    //   based on the local (block-based) fragment Id
-    // # Given each exterior face extracted from the face hash, gain access to
-    //   the original 2D polygon in the polyhedra, insert it to the output
-    //   vtkPolyData. The points are also inserted to the output polygon and
-    //   a global Id is assigned to each point as the point data attribute
-    this->ExtractFragmentPolygons(i, maxFsize[i], plyHedra, surfaces[i], mbPntLoc);
-
-    plyHedra->Delete();
-    plyHedra = nullptr;
+    vtkSMPTools::For(batchBeg, batchEnd, 1,
+      [&](vtkIdType begin, vtkIdType end)
+      {
+        for (vtkIdType blckIdx = begin; blckIdx < end; blckIdx++)
+        {
+          vtkSmartPointer<vtkPolyData>& blckHedra = plyHedra[blckIdx - batchBeg];
+          blckHedra = vtkSmartPointer<vtkPolyData>::New();
+          this->ExtractFragmentPolyhedra(dualGrds[blckIdx], fracName, isoValue, blckHedra);
+        }
+      });
+
+    for (i = batchBeg; i < batchEnd; i++)
+    {
+      surfaces[i] = vtkPolyData::New();
+
+      // # clear and re-init EquivalenceSet
+      // # clear and re-init the face hash with the number of points contained
+      //   in the polyhedra
+      // # add each face of the polyhedra to the face hash, with the block-based
+      //   local point Id as the face hash entry / index, assign it with the face
+      //   index (in the polyhedra, via PolygonId) for late access to the original
+      //   2D polygon in the polyhedra, and assign it with the volume index (in
+      //   the polyhedra, via VolumeId)
+      // # resolve the polygons of the polyhedra in the face hash
+      // # obtain the remaining / exterior faces from the face hash and group them
+      //   based on the local (block-based) fragment Id
+      // # Given each exterior face extracted from the face hash, gain access to
+      //   the original 2D polygon in the polyhedra, insert it to the output
+      //   vtkPolyData. The points are also inserted to the output polygon and
+      //   a global Id is assigned to each point as the point data attribute
+      this->ExtractFragmentPolygons(i, maxFsize[i], plyHedra[i - batchBeg], surfaces[i], mbPntLoc);
+
+      plyHedra[i - batchBeg] = nullptr;
+    }
   }
 
   // The equivalenceSet keeps track of fragment ids and determines which
@@ -1702,16 +1750,6 @@ void vtkRectilinearGridConnectivity::ExtractFragmentPolyhedra(
     }
     tempAray = nullptr;
   }
-  if (this->Internal->ComponentNumbersObtained == 0)
-  {
-    this->Internal->ComponentNumbersObtained = 1;
-    this->Internal->NumberIntegralComponents = 0;
-    for (a = 0; a < numArays; a++)
-    {
-      this->Internal->NumberIntegralComponents += numComps[a];
-      this->Internal->ComponentNumbersPerArray.push_back(numComps[a]);
-    }
-  }
 
   // create a vtkPoints for all the points of the fragment surfaces
   rectGrid->GetBounds(dataBbox);
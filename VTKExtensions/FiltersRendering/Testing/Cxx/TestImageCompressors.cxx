@@ -1,6 +1,7 @@
 // SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
 // SPDX-License-Identifier: BSD-3-Clause
 
+#include "vtkDeltaImageCompressor.h"
 #include "vtkImageCompressor.h"
 #include "vtkImageData.h"
 #include "vtkLZ4Compressor.h"
@@ -14,6 +15,7 @@
 #include "vtkUnsignedCharArray.h"
 #include "vtkZlibImageCompressor.h"
 
+#include <algorithm>
 #include <iostream>
 #include <map>
 #include <string>
@@ -39,7 +41,8 @@ typedef std::map<std::string, Data> MapType;
 
 namespace
 {
-bool DoTest(Data& data, vtkImageCompressor* compressor, vtkUnsignedCharArray* input)
+bool DoTest(
+  Data& data, vtkImageCompressor* compressor, vtkUnsignedCharArray* input, bool lossless = false)
 {
   vtkNew<vtkUnsignedCharArray> outputCompressed;
   vtkNew<vtkUnsignedCharArray> outputDeCompressed;
@@ -69,6 +72,16 @@ bool DoTest(Data& data, vtkImageCompressor* compressor, vtkUnsignedCharArray* in
   data.DecompressTime += timer->GetElapsedTime();
   data.CompressedSize =
     outputCompressed->GetNumberOfTuples() * outputCompressed->GetNumberOfComponents();
+
+  if (lossless &&
+    !std::equal(input->GetPointer(0),
+      input->GetPointer(0) + input->GetNumberOfTuples() * input->GetNumberOfComponents(),
+      outputDeCompressed->GetPointer(0)))
+  {
+    std::cerr << "Decompressed image does not match the input for "
+              << compressor->SaveConfiguration() << endl;
+    return false;
+  }
   return true;
 }
 }
@@ -117,10 +130,17 @@ extern int TestImageCompressors(int argc, char* argv[])
   {
     vtkNew<vtkLZ4Compressor> lz4;
     lz4->SetQuality(0);
-    if (!DoTest(datas["LZ4 (quality: 0)"], lz4.Get(), input))
+    if (!DoTest(datas["LZ4 (quality: 0)"], lz4.Get(), input, true))
     {
       return TEST_FAILED;
     }
+    // use an odd number of tiles to exercise uneven tile boundaries.
+    lz4->SetNumberOfTiles(7);
+    if (!DoTest(datas["LZ4 (quality: 0, tiles: 7)"], lz4.Get(), input, true))
+    {
+      return TEST_FAILED;
+    }
+    lz4->SetNumberOfTiles(0);
     if (test_lossy)
     {
       lz4->SetQuality(3);
@@ -139,10 +159,18 @@ extern int TestImageCompressors(int argc, char* argv[])
 
     vtkNew<vtkSquirtCompressor> squirt;
     squirt->SetSquirtLevel(0);
-    if (!DoTest(datas["SQUIRT (squirt-level: 0)"], squirt.Get(), input))
+    // SQUIRT always quantizes opacity, so it is only lossless for RGB.
+    const bool squirtLossless = input->GetNumberOfComponents() == 3;
+    if (!DoTest(datas["SQUIRT (squirt-level: 0)"], squirt.Get(), input, squirtLossless))
     {
       return TEST_FAILED;
     }
+    squirt->SetNumberOfTiles(7);
+    if (!DoTest(datas["SQUIRT (squirt-level: 0, tiles: 7)"], squirt.Get(), input, squirtLossless))
+    {
+      return TEST_FAILED;
+    }
+    squirt->SetNumberOfTiles(0);
 
     if (test_lossy)
     {
@@ -160,6 +188,40 @@ extern int TestImageCompressors(int argc, char* argv[])
       }
     }
 
+    // Frames are compared against the previous one: the first frame is a
+    // keyframe, an identical frame only sends the change mask.
+    vtkNew<vtkDeltaImageCompressor> delta;
+    delta->SetQuality(0);
+    delta->SetImageResolution(image->GetDimensions()[0], image->GetDimensions()[1]);
+    Data& deltaKeyFrame = datas["DELTA (keyframe)"];
+    Data& deltaUnchanged = datas["DELTA (unchanged)"];
+    if (!DoTest(deltaKeyFrame, delta.Get(), input, true) ||
+      !DoTest(deltaUnchanged, delta.Get(), input, true) ||
+      deltaUnchanged.CompressedSize * 10 > deltaKeyFrame.CompressedSize)
+    {
+      std::cerr << "Delta compression of an unchanged frame failed." << endl;
+      return TEST_FAILED;
+    }
+    vtkNew<vtkUnsignedCharArray> modified;
+    modified->DeepCopy(input);
+    const int numComps = modified->GetNumberOfComponents();
+    for (int y = image->GetDimensions()[1] / 3; y < image->GetDimensions()[1] / 2; ++y)
+    {
+      for (int x = image->GetDimensions()[0] / 3; x < image->GetDimensions()[0] / 2; ++x)
+      {
+        unsigned char* pixel =
+          modified->GetPointer((static_cast<vtkIdType>(y) * image->GetDimensions()[0] + x) *
+            numComps);
+        std::transform(pixel, pixel + numComps, pixel, [](unsigned char c) { return 255 - c; });
+      }
+    }
+    if (!DoTest(datas["DELTA (changed region)"], delta.Get(), modified.Get(), true) ||
+      !DoTest(datas["DELTA (changed back)"], delta.Get(), input, true))
+    {
+      std::cerr << "Delta compression of a changed frame failed." << endl;
+      return TEST_FAILED;
+    }
+
     vtkNew<vtkZlibImageCompressor> zlib;
     zlib->SetCompressionLevel(1);
     if (!DoTest(datas["ZLIB (compression-level: 1, color-space: 0)"], zlib.Get(), input))
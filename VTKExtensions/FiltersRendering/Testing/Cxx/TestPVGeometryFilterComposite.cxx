@@ -0,0 +1,241 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+// PARAVIEW_DEPRECATED_IN_6_2_0()
+#define PARAVIEW_DEPRECATION_LEVEL 0
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkFloatArray.h"
+#include "vtkImageData.h"
+#include "vtkLogger.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPVGeometryFilter.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+
+#define VERIFY(x, y)                                                                               \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    vtkLogF(ERROR, y);                                                                             \
+    return false;                                                                                  \
+  }
+
+namespace
+{
+constexpr unsigned int NumberOfBlocks = 64;
+// Index of a leaf that shares its data object with the first leaf.
+constexpr unsigned int SharedBlockIndex = 1;
+
+vtkSmartPointer<vtkImageData> CreateBlock(unsigned int index)
+{
+  auto image = vtkSmartPointer<vtkImageData>::New();
+  const int size = 2 + static_cast<int>(index % 7);
+  image->SetDimensions(size, size + 1, size + 2);
+  image->SetOrigin(index, 0, 0);
+  return image;
+}
+
+bool TestLeafExecution()
+{
+  // Leaves with odd indices are left empty to check that the output tree keeps
+  // them at the same location, except for one that is shared with the first
+  // leaf.
+  vtkNew<vtkMultiBlockDataSet> input;
+  input->SetNumberOfBlocks(NumberOfBlocks);
+  for (unsigned int cc = 0; cc < NumberOfBlocks; cc += 2)
+  {
+    input->SetBlock(cc, ::CreateBlock(cc));
+  }
+  input->SetBlock(SharedBlockIndex, input->GetBlock(0));
+
+  vtkNew<vtkPVGeometryFilter> filter;
+  filter->SetInputData(input);
+  filter->SetUseOutline(0);
+  filter->SetGenerateProcessIds(false);
+  filter->Update();
+
+  auto output = vtkMultiBlockDataSet::SafeDownCast(filter->GetOutputDataObject(0));
+  VERIFY(output != nullptr, "vtkMultiBlockDataSet output expected.");
+  VERIFY(output->GetNumberOfBlocks() == NumberOfBlocks, "Unexpected number of blocks.");
+
+  // Each leaf must match the surface extracted from the same block on its own.
+  vtkNew<vtkPVGeometryFilter> reference;
+  reference->SetUseOutline(0);
+  reference->SetGenerateProcessIds(false);
+  for (unsigned int cc = 0; cc < NumberOfBlocks; ++cc)
+  {
+    auto leaf = vtkPolyData::SafeDownCast(output->GetBlock(cc));
+    if (cc % 2 == 1 && cc != SharedBlockIndex)
+    {
+      VERIFY(leaf == nullptr, "Empty input leaves must remain empty.");
+      continue;
+    }
+    VERIFY(leaf != nullptr, "Missing output leaf.");
+    VERIFY(cc != SharedBlockIndex || leaf != output->GetBlock(0),
+      "Shared input leaves must have distinct output leaves.");
+
+    reference->SetInputData(input->GetBlock(cc));
+    reference->Update();
+    vtkPolyData* expected = reference->GetOutput();
+    VERIFY(leaf->GetNumberOfPoints() == expected->GetNumberOfPoints(),
+      "Unexpected number of points.");
+    VERIFY(leaf->GetNumberOfCells() == expected->GetNumberOfCells(), "Unexpected number of cells.");
+
+    double leafBounds[6];
+    double expectedBounds[6];
+    leaf->GetBounds(leafBounds);
+    expected->GetBounds(expectedBounds);
+    for (int i = 0; i < 6; ++i)
+    {
+      VERIFY(leafBounds[i] == expectedBounds[i], "Leaves were not assigned in order.");
+    }
+
+    auto compositeIndex = leaf->GetCellData()->GetArray("vtkCompositeIndex");
+    VERIFY(compositeIndex != nullptr, "Missing vtkCompositeIndex array.");
+    VERIFY(compositeIndex->GetComponent(0, 0) == cc + 1, "Unexpected vtkCompositeIndex value.");
+  }
+
+  // The outline flag must reflect the leaves, as when executing them in order.
+  VERIFY(filter->GetOutlineFlag() == 0, "No outline expected.");
+  filter->SetUseOutline(1);
+  filter->Update();
+  VERIFY(filter->GetOutlineFlag() == 1, "Outlines expected for the composite input.");
+
+  return true;
+}
+
+bool TestAttributeOnlyUpdate()
+{
+  vtkNew<vtkPoints> points;
+  points->InsertNextPoint(0, 0, 0);
+  points->InsertNextPoint(1, 0, 0);
+  points->InsertNextPoint(1, 1, 0);
+  points->InsertNextPoint(0, 1, 0);
+  vtkNew<vtkCellArray> polys;
+  const vtkIdType quad[4] = { 0, 1, 2, 3 };
+  polys->InsertNextCell(4, quad);
+
+  vtkNew<vtkPolyData> mesh;
+  mesh->SetPoints(points);
+  mesh->SetPolys(polys);
+  vtkNew<vtkFloatArray> scalars;
+  scalars->SetName("Scalars");
+  scalars->SetNumberOfTuples(4);
+  scalars->FillValue(1.0);
+  mesh->GetPointData()->AddArray(scalars);
+
+  vtkNew<vtkMultiBlockDataSet> input;
+  input->SetBlock(0, mesh);
+
+  vtkNew<vtkPVGeometryFilter> filter;
+  filter->SetInputData(input);
+  filter->SetUseOutline(0);
+  filter->SetGeneratePointNormals(true);
+  filter->Update();
+
+  // Only change the point data: the surface can be reused from the previous
+  // execution, but generated arrays must still be present.
+  scalars->FillValue(2.0);
+  scalars->Modified();
+  mesh->Modified();
+  filter->Update();
+
+  auto output = vtkMultiBlockDataSet::SafeDownCast(filter->GetOutputDataObject(0));
+  VERIFY(output != nullptr, "vtkMultiBlockDataSet output expected.");
+  auto leaf = vtkPolyData::SafeDownCast(output->GetBlock(0));
+  VERIFY(leaf != nullptr && leaf->GetNumberOfCells() == 1, "Unexpected surface.");
+  vtkPointData* pointData = leaf->GetPointData();
+  auto outScalars = pointData->GetArray("Scalars");
+  VERIFY(outScalars != nullptr && outScalars->GetComponent(0, 0) == 2.0,
+    "Updated point data was not forwarded.");
+  VERIFY(pointData->GetArray("Normals") != nullptr, "Missing normals.");
+  VERIFY(pointData->GetArray("vtkOriginalPointIds") != nullptr, "Missing vtkOriginalPointIds.");
+  VERIFY(leaf->GetCellData()->GetArray("vtkOriginalCellIds") != nullptr,
+    "Missing vtkOriginalCellIds.");
+  VERIFY(leaf->GetCellData()->GetArray("vtkCompositeIndex") != nullptr,
+    "Missing vtkCompositeIndex.");
+
+  // Arrays that are no longer generated must not be preserved by later reuses.
+  filter->SetGeneratePointNormals(false);
+  filter->Update();
+  scalars->FillValue(3.0);
+  scalars->Modified();
+  mesh->Modified();
+  filter->Update();
+
+  output = vtkMultiBlockDataSet::SafeDownCast(filter->GetOutputDataObject(0));
+  leaf = vtkPolyData::SafeDownCast(output->GetBlock(0));
+  VERIFY(leaf != nullptr, "Unexpected surface.");
+  outScalars = leaf->GetPointData()->GetArray("Scalars");
+  VERIFY(outScalars != nullptr && outScalars->GetComponent(0, 0) == 3.0,
+    "Updated point data was not forwarded.");
+  VERIFY(leaf->GetPointData()->GetArray("Normals") == nullptr, "Stale normals were preserved.");
+  return true;
+}
+
+bool TestSharedPoints()
+{
+  // Leaves sharing the same points, each using a different subset of them.
+  constexpr vtkIdType NumberOfQuads = 8;
+  vtkNew<vtkPoints> points;
+  for (vtkIdType cc = 0; cc <= NumberOfQuads; ++cc)
+  {
+    points->InsertNextPoint(cc, 0, 0);
+    points->InsertNextPoint(cc, 1, 0);
+  }
+  vtkNew<vtkMultiBlockDataSet> input;
+  for (vtkIdType cc = 0; cc < NumberOfQuads; ++cc)
+  {
+    vtkNew<vtkCellArray> polys;
+    const vtkIdType quad[4] = { 2 * cc, 2 * cc + 2, 2 * cc + 3, 2 * cc + 1 };
+    polys->InsertNextCell(4, quad);
+    vtkNew<vtkPolyData> mesh;
+    mesh->SetPoints(points);
+    mesh->SetPolys(polys);
+    input->SetBlock(static_cast<unsigned int>(cc), mesh);
+  }
+  // and a leaf with its own points, which may be extracted concurrently.
+  input->SetBlock(NumberOfQuads, ::CreateBlock(0));
+
+  vtkNew<vtkPVGeometryFilter> filter;
+  filter->SetInputData(input);
+  filter->SetUseOutline(0);
+  filter->SetGenerateProcessIds(false);
+  filter->Update();
+
+  auto output = vtkMultiBlockDataSet::SafeDownCast(filter->GetOutputDataObject(0));
+  VERIFY(output != nullptr, "vtkMultiBlockDataSet output expected.");
+  VERIFY(output->GetNumberOfBlocks() == NumberOfQuads + 1, "Unexpected number of blocks.");
+
+  vtkNew<vtkPVGeometryFilter> reference;
+  reference->SetUseOutline(0);
+  reference->SetGenerateProcessIds(false);
+  for (unsigned int cc = 0; cc <= NumberOfQuads; ++cc)
+  {
+    auto leaf = vtkPolyData::SafeDownCast(output->GetBlock(cc));
+    VERIFY(leaf != nullptr, "Missing output leaf.");
+    reference->SetInputData(input->GetBlock(cc));
+    reference->Update();
+    vtkPolyData* expected = reference->GetOutput();
+    VERIFY(leaf->GetNumberOfCells() == expected->GetNumberOfCells(), "Unexpected number of cells.");
+
+    double leafBounds[6];
+    double expectedBounds[6];
+    leaf->GetBounds(leafBounds);
+    expected->GetBounds(expectedBounds);
+    for (int i = 0; i < 6; ++i)
+    {
+      VERIFY(leafBounds[i] == expectedBounds[i], "Unexpected leaf bounds.");
+    }
+  }
+  return true;
+}
+}
+
+int TestPVGeometryFilterComposite(int, char*[])
+{
+  return TestLeafExecution() && TestAttributeOnlyUpdate() && TestSharedPoints() ? EXIT_SUCCESS
+                                                                                : EXIT_FAILURE;
+}
@@ -0,0 +1,480 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkDeltaImageCompressor.h"
+
+#include "vtkMultiProcessStream.h"
+#include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
+#include "vtkUnsignedCharArray.h"
+
+#include "vtk_lz4.h"
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+
+namespace
+{
+// Header written in front of every compressed frame.
+struct FrameHeader
+{
+  vtkTypeUInt32 Flags;
+  vtkTypeUInt32 FrameNumber;
+  vtkTypeUInt32 Width;
+  vtkTypeUInt32 Height;
+  vtkTypeUInt32 NumberOfComponents;
+  vtkTypeUInt32 TileSize;
+};
+
+constexpr vtkTypeUInt32 KeyFrameFlag = 0x1;
+
+// Per-channel color masks indexed by quality, matching vtkLZ4Compressor.
+constexpr unsigned char ColorMasks[6][4] = { { 0xFF, 0xFF, 0xFF, 0xFF },
+  { 0xFE, 0xFF, 0xFE, 0xFE }, { 0xFC, 0xFE, 0xFC, 0xFC }, { 0xF8, 0xFC, 0xF8, 0xF8 },
+  { 0xF0, 0xF8, 0xF0, 0xF0 }, { 0xE0, 0xF0, 0xE0, 0xE0 } };
+
+// Splits a width x height image into square tiles, numbered row by row.
+class TileGrid
+{
+public:
+  TileGrid(int width, int height, int tileSize)
+    : Width(width)
+    , Height(height)
+    , TileSize(tileSize)
+    , TilesX((width + tileSize - 1) / tileSize)
+    , TilesY((height + tileSize - 1) / tileSize)
+  {
+  }
+
+  int GetNumberOfTiles() const { return this->TilesX * this->TilesY; }
+
+  vtkIdType GetNumberOfPixels(int tile) const
+  {
+    int x0, x1, y0, y1;
+    this->GetExtent(tile, x0, x1, y0, y1);
+    return static_cast<vtkIdType>(x1 - x0) * (y1 - y0);
+  }
+
+  /**
+   * Calls `functor(firstPixel, numberOfPixels)` for each row of the tile,
+   * stopping early if it returns false. Returns false if it stopped early.
+   */
+  template <typename Functor>
+  bool ForEachRow(int tile, Functor&& functor) const
+  {
+    int x0, x1, y0, y1;
+    this->GetExtent(tile, x0, x1, y0, y1);
+    for (int y = y0; y < y1; ++y)
+    {
+      if (!functor(static_cast<vtkIdType>(y) * this->Width + x0, x1 - x0))
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+private:
+  void GetExtent(int tile, int& x0, int& x1, int& y0, int& y1) const
+  {
+    x0 = (tile % this->TilesX) * this->TileSize;
+    y0 = (tile / this->TilesX) * this->TileSize;
+    x1 = std::min(x0 + this->TileSize, this->Width);
+    y1 = std::min(y0 + this->TileSize, this->Height);
+  }
+
+  int Width;
+  int Height;
+  int TileSize;
+  int TilesX;
+  int TilesY;
+};
+
+// Number of bytes used to flag the changed tiles of a delta frame.
+size_t GetChangeMaskSize(int numberOfTiles)
+{
+  return (static_cast<size_t>(numberOfTiles) + 7) / 8;
+}
+
+// Offsets of the changed tiles, in pixels, in the packed tile buffer.
+std::vector<vtkIdType> GetPackedOffsets(
+  const TileGrid& grid, const std::vector<unsigned char>& changed)
+{
+  const int numberOfTiles = grid.GetNumberOfTiles();
+  std::vector<vtkIdType> offsets(numberOfTiles + 1, 0);
+  for (int tile = 0; tile < numberOfTiles; ++tile)
+  {
+    offsets[tile + 1] = offsets[tile] + (changed[tile] ? grid.GetNumberOfPixels(tile) : 0);
+  }
+  return offsets;
+}
+}
+
+vtkStandardNewMacro(vtkDeltaImageCompressor);
+//----------------------------------------------------------------------------
+vtkDeltaImageCompressor::vtkDeltaImageCompressor()
+  : Quality(3)
+  , KeyFrameInterval(30)
+  , TileSize(64)
+  , ImageWidth(0)
+  , ImageHeight(0)
+  , FramesSinceKeyFrame(0)
+  , KeyFrameRequested(true)
+{
+}
+
+//----------------------------------------------------------------------------
+vtkDeltaImageCompressor::~vtkDeltaImageCompressor() = default;
+
+//----------------------------------------------------------------------------
+void vtkDeltaImageCompressor::SetImageResolution(int width, int height)
+{
+  this->ImageWidth = width;
+  this->ImageHeight = height;
+}
+
+//----------------------------------------------------------------------------
+void vtkDeltaImageCompressor::RequestKeyFrame()
+{
+  this->KeyFrameRequested = true;
+}
+
+//----------------------------------------------------------------------------
+int vtkDeltaImageCompressor::Compress()
+{
+  if (!(this->Input && this->Output))
+  {
+    vtkWarningMacro("Cannot compress, empty input or output detected.");
+    return VTK_ERROR;
+  }
+
+  vtkUnsignedCharArray* input = this->Input;
+  const int numComps = input->GetNumberOfComponents();
+  const vtkIdType numberOfPixels = input->GetNumberOfTuples();
+  const unsigned char* inputPtr = input->GetPointer(0);
+
+  // Without a matching resolution, treat the image as a single row.
+  int width = this->ImageWidth;
+  int height = this->ImageHeight;
+  if (static_cast<vtkIdType>(width) * height != numberOfPixels)
+  {
+    width = static_cast<int>(numberOfPixels);
+    height = numberOfPixels > 0 ? 1 : 0;
+  }
+
+  const int quality = this->LossLessMode ? 0 : this->Quality;
+  FrameState& reference = this->Reference;
+  const bool keyFrame = this->KeyFrameRequested || reference.Width != width ||
+    reference.Height != height || reference.NumberOfComponents != numComps ||
+    reference.TileSize != this->TileSize || reference.Quality != quality ||
+    (this->KeyFrameInterval > 0 && this->FramesSinceKeyFrame >= this->KeyFrameInterval);
+
+  const TileGrid grid(width, height, this->TileSize);
+  const int numberOfTiles = grid.GetNumberOfTiles();
+  const size_t rowStride = static_cast<size_t>(numComps);
+
+  // Find the tiles that differ from the previous frame.
+  std::vector<unsigned char> changed(numberOfTiles, 1);
+  if (!keyFrame)
+  {
+    const unsigned char* referencePtr = reference.Pixels.data();
+    vtkSMPTools::For(0, numberOfTiles,
+      [&](vtkIdType first, vtkIdType last)
+      {
+        for (vtkIdType tile = first; tile < last; ++tile)
+        {
+          const bool same = grid.ForEachRow(static_cast<int>(tile),
+            [&](vtkIdType begin, int length)
+            {
+              return std::memcmp(inputPtr + begin * numComps, referencePtr + begin * numComps,
+                       length * rowStride) == 0;
+            });
+          changed[tile] = same ? 0 : 1;
+        }
+      });
+  }
+
+  // Pack the changed tiles, reducing colors for lossy compression, and
+  // record them as the new reference.
+  const std::vector<vtkIdType> offsets = ::GetPackedOffsets(grid, changed);
+  std::vector<unsigned char> packed(static_cast<size_t>(offsets[numberOfTiles]) * numComps);
+  reference.Pixels.resize(static_cast<size_t>(numberOfPixels) * numComps);
+  const unsigned char* mask = ::ColorMasks[quality];
+  vtkSMPTools::For(0, numberOfTiles,
+    [&](vtkIdType first, vtkIdType last)
+    {
+      for (vtkIdType tile = first; tile < last; ++tile)
+      {
+        if (!changed[tile])
+        {
+          continue;
+        }
+        unsigned char* out = packed.data() + offsets[tile] * numComps;
+        grid.ForEachRow(static_cast<int>(tile),
+          [&](vtkIdType begin, int length)
+          {
+            const unsigned char* in = inputPtr + begin * numComps;
+            const size_t rowSize = length * rowStride;
+            std::copy(in, in + rowSize, reference.Pixels.data() + begin * numComps);
+            for (int pixel = 0; pixel < length; ++pixel)
+            {
+              for (int comp = 0; comp < numComps; ++comp)
+              {
+                *out++ = *in++ & mask[comp % 4];
+              }
+            }
+            return true;
+          });
+      }
+    });
+
+  // Compress the packed tiles after the frame header and the change mask.
+  const size_t changeMaskSize = keyFrame ? 0 : ::GetChangeMaskSize(numberOfTiles);
+  const size_t headerSize = sizeof(FrameHeader) + changeMaskSize;
+  const bool status = this->CompressTiles(offsets[numberOfTiles], 0,
+    [&](vtkIdType begin, vtkIdType end, std::vector<unsigned char>& buffer)
+    {
+      const int tileSize = static_cast<int>((end - begin) * numComps);
+      if (tileSize == 0)
+      {
+        // nothing changed.
+        buffer.clear();
+        return true;
+      }
+      const int maxOutputSize = LZ4_compressBound(tileSize);
+      buffer.resize(static_cast<size_t>(maxOutputSize));
+      const int compressedSize =
+        LZ4_compress_fast(reinterpret_cast<const char*>(packed.data() + begin * numComps),
+          reinterpret_cast<char*>(buffer.data()), tileSize, maxOutputSize, 16);
+      buffer.resize(static_cast<size_t>(std::max(compressedSize, 0)));
+      return compressedSize > 0;
+    },
+    headerSize);
+  if (!status)
+  {
+    // The reference may have been partially updated.
+    this->KeyFrameRequested = true;
+    return VTK_ERROR;
+  }
+
+  ++reference.FrameNumber;
+  FrameHeader header;
+  header.Flags = keyFrame ? KeyFrameFlag : 0;
+  header.FrameNumber = reference.FrameNumber;
+  header.Width = static_cast<vtkTypeUInt32>(width);
+  header.Height = static_cast<vtkTypeUInt32>(height);
+  header.NumberOfComponents = static_cast<vtkTypeUInt32>(numComps);
+  header.TileSize = static_cast<vtkTypeUInt32>(this->TileSize);
+  unsigned char* out = this->Output->GetPointer(0);
+  std::memcpy(out, &header, sizeof(header));
+  out += sizeof(header);
+  std::fill(out, out + changeMaskSize, 0);
+  for (int tile = 0; tile < numberOfTiles && !keyFrame; ++tile)
+  {
+    if (changed[tile])
+    {
+      out[tile / 8] |= static_cast<unsigned char>(1 << (tile % 8));
+    }
+  }
+
+  reference.Width = width;
+  reference.Height = height;
+  reference.NumberOfComponents = numComps;
+  reference.TileSize = this->TileSize;
+  reference.Quality = quality;
+  this->FramesSinceKeyFrame = keyFrame ? 1 : this->FramesSinceKeyFrame + 1;
+  this->KeyFrameRequested = false;
+  return VTK_OK;
+}
+
+//----------------------------------------------------------------------------
+int vtkDeltaImageCompressor::Decompress()
+{
+  if (!(this->Input && this->Output))
+  {
+    vtkWarningMacro("Cannot decompress, empty input or output detected.");
+    return VTK_ERROR;
+  }
+
+  const size_t inputSize = static_cast<size_t>(
+    this->Input->GetNumberOfTuples() * this->Input->GetNumberOfComponents());
+  const unsigned char* in = this->Input->GetPointer(0);
+  FrameHeader header;
+  if (inputSize < sizeof(header))
+  {
+    vtkWarningMacro("Cannot decompress, truncated frame.");
+    return VTK_ERROR;
+  }
+  std::memcpy(&header, in, sizeof(header));
+
+  const int numComps = this->Output->GetNumberOfComponents();
+  const vtkIdType numberOfPixels = this->Output->GetNumberOfTuples();
+  const int width = static_cast<int>(header.Width);
+  const int height = static_cast<int>(header.Height);
+  const int tileSize = static_cast<int>(header.TileSize);
+  if (static_cast<int>(header.NumberOfComponents) != numComps ||
+    static_cast<vtkIdType>(header.Width) * header.Height != numberOfPixels || tileSize < 8 ||
+    tileSize > 1024)
+  {
+    vtkWarningMacro("Cannot decompress, frame does not match the output.");
+    return VTK_ERROR;
+  }
+
+  FrameState& decoded = this->Decoded;
+  const bool keyFrame = (header.Flags & KeyFrameFlag) != 0;
+  if (!keyFrame &&
+    (decoded.Width != width || decoded.Height != height ||
+      decoded.NumberOfComponents != numComps || decoded.TileSize != tileSize ||
+      header.FrameNumber != decoded.FrameNumber + 1))
+  {
+    vtkWarningMacro("Cannot decompress, frame does not follow the previous frame. "
+                    "Waiting for the next keyframe.");
+    decoded.Width = 0;
+    return VTK_ERROR;
+  }
+
+  const TileGrid grid(width, height, tileSize);
+  const int numberOfTiles = grid.GetNumberOfTiles();
+  const size_t rowStride = static_cast<size_t>(numComps);
+  size_t offset = sizeof(header);
+  std::vector<unsigned char> changed(numberOfTiles, 1);
+  if (!keyFrame)
+  {
+    const size_t changeMaskSize = ::GetChangeMaskSize(numberOfTiles);
+    if (inputSize < offset + changeMaskSize)
+    {
+      vtkWarningMacro("Cannot decompress, truncated frame.");
+      return VTK_ERROR;
+    }
+    for (int tile = 0; tile < numberOfTiles; ++tile)
+    {
+      changed[tile] = (in[offset + tile / 8] >> (tile % 8)) & 0x1;
+    }
+    offset += changeMaskSize;
+  }
+
+  // Decompress the packed changed tiles.
+  const std::vector<vtkIdType> offsets = ::GetPackedOffsets(grid, changed);
+  std::vector<unsigned char> packed(static_cast<size_t>(offsets[numberOfTiles]) * numComps);
+  const bool status = this->DecompressTiles(in + offset, inputSize - offset,
+    offsets[numberOfTiles],
+    [&](const unsigned char* data, size_t size, vtkIdType begin, vtkIdType end)
+    {
+      const int maxDecompressedSize = static_cast<int>((end - begin) * numComps);
+      if (maxDecompressedSize == 0)
+      {
+        return size == 0;
+      }
+      const int decompressedSize = LZ4_decompress_safe(reinterpret_cast<const char*>(data),
+        reinterpret_cast<char*>(packed.data() + begin * numComps), static_cast<int>(size),
+        maxDecompressedSize);
+      return decompressedSize == maxDecompressedSize;
+    });
+  if (!status)
+  {
+    vtkWarningMacro("Cannot decompress, corrupted frame.");
+    decoded.Width = 0;
+    return VTK_ERROR;
+  }
+
+  // Update the changed tiles of the previous frame and copy it to the output.
+  decoded.Pixels.resize(static_cast<size_t>(numberOfPixels) * numComps);
+  vtkSMPTools::For(0, numberOfTiles,
+    [&](vtkIdType first, vtkIdType last)
+    {
+      for (vtkIdType tile = first; tile < last; ++tile)
+      {
+        if (!changed[tile])
+        {
+          continue;
+        }
+        const unsigned char* packedTile = packed.data() + offsets[tile] * numComps;
+        grid.ForEachRow(static_cast<int>(tile),
+          [&](vtkIdType begin, int length)
+          {
+            const size_t rowSize = length * rowStride;
+            std::copy(
+              packedTile, packedTile + rowSize, decoded.Pixels.data() + begin * numComps);
+            packedTile += rowSize;
+            return true;
+          });
+      }
+    });
+  std::copy(decoded.Pixels.begin(), decoded.Pixels.end(), this->Output->GetPointer(0));
+
+  decoded.Width = width;
+  decoded.Height = height;
+  decoded.NumberOfComponents = numComps;
+  decoded.TileSize = tileSize;
+  decoded.FrameNumber = header.FrameNumber;
+  return VTK_OK;
+}
+
+//-----------------------------------------------------------------------------
+void vtkDeltaImageCompressor::SaveConfiguration(vtkMultiProcessStream* stream)
+{
+  this->Superclass::SaveConfiguration(stream);
+  *stream << this->Quality << this->KeyFrameInterval << this->TileSize;
+}
+
+//-----------------------------------------------------------------------------
+bool vtkDeltaImageCompressor::RestoreConfiguration(vtkMultiProcessStream* stream)
+{
+  if (this->Superclass::RestoreConfiguration(stream))
+  {
+    int quality, keyFrameInterval, tileSize;
+    *stream >> quality >> keyFrameInterval >> tileSize;
+    this->SetQuality(quality);
+    this->SetKeyFrameInterval(keyFrameInterval);
+    this->SetTileSize(tileSize);
+    return true;
+  }
+  return false;
+}
+
+//-----------------------------------------------------------------------------
+const char* vtkDeltaImageCompressor::SaveConfiguration()
+{
+  std::ostringstream oss;
+  oss << this->Superclass::SaveConfiguration() << " " << this->Quality << " "
+      << this->KeyFrameInterval << " " << this->TileSize;
+  this->SetConfiguration(oss.str().c_str());
+  return this->Configuration;
+}
+
+//-----------------------------------------------------------------------------
+const char* vtkDeltaImageCompressor::RestoreConfiguration(const char* stream)
+{
+  stream = this->Superclass::RestoreConfiguration(stream);
+  if (stream)
+  {
+    std::istringstream iss(stream);
+    int quality;
+    iss >> quality;
+    this->SetQuality(quality);
+    // key frame interval and tile size are optional.
+    int keyFrameInterval;
+    if (iss >> keyFrameInterval)
+    {
+      this->SetKeyFrameInterval(keyFrameInterval);
+      int tileSize;
+      if (iss >> tileSize)
+      {
+        this->SetTileSize(tileSize);
+      }
+    }
+    iss.clear();
+    return stream + iss.tellg();
+  }
+  return nullptr;
+}
+
+//----------------------------------------------------------------------------
+void vtkDeltaImageCompressor::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Quality: " << this->Quality << endl;
+  os << indent << "KeyFrameInterval: " << this->KeyFrameInterval << endl;
+  os << indent << "TileSize: " << this->TileSize << endl;
+  os << indent << "ImageWidth: " << this->ImageWidth << endl;
+  os << indent << "ImageHeight: " << this->ImageHeight << endl;
+}
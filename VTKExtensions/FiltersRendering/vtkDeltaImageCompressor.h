@@ -0,0 +1,137 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkDeltaImageCompressor
+ * @brief   Image compressor/decompressor that only sends the parts of an
+ * image that changed since the previous frame.
+ *
+ * vtkDeltaImageCompressor splits images into square tiles and compares each
+ * tile against the previously compressed frame. Only tiles that changed are
+ * packed and compressed with LZ4; the decompressor keeps the previously
+ * decompressed frame and updates only those tiles. This is well suited to
+ * sequences of mostly identical frames such as animations with a fixed camera
+ * or interaction with widgets.
+ *
+ * A keyframe, containing all the tiles, is emitted for the first frame, every
+ * KeyFrameInterval frames, and whenever the image resolution, the number of
+ * components, the tile size or the effective quality changes.
+ *
+ * Since each frame depends on the previous one, a given instance must compress
+ * (or decompress) every frame of a stream in order. The decompressor reports
+ * an error when it receives a frame that does not follow the last one it
+ * decompressed; decompression then resumes at the next keyframe.
+ */
+
+#ifndef vtkDeltaImageCompressor_h
+#define vtkDeltaImageCompressor_h
+
+#include "vtkImageCompressor.h"
+#include "vtkPVVTKExtensionsFiltersRenderingModule.h" // needed for exports
+
+#include <vector> // for std::vector
+
+class vtkMultiProcessStream;
+
+class VTKPVVTKEXTENSIONSFILTERSRENDERING_EXPORT vtkDeltaImageCompressor : public vtkImageCompressor
+{
+public:
+  static vtkDeltaImageCompressor* New();
+  vtkTypeMacro(vtkDeltaImageCompressor, vtkImageCompressor);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  ///@{
+  /**
+   * Set the quality measure. The value can be between 0 and 5. 0 means preserve
+   * input image quality while 5 means improve compression at the cost of image
+   * quality. For quality values > 0, changed tiles are sent with a color mask
+   * similar to vtkLZ4Compressor.
+   */
+  vtkSetClampMacro(Quality, int, 0, 5);
+  vtkGetMacro(Quality, int);
+  ///@}
+
+  ///@{
+  /**
+   * Set the number of frames after which a keyframe is sent even if the
+   * image did not change much. 0 disables periodic keyframes. Default is 30.
+   */
+  vtkSetClampMacro(KeyFrameInterval, int, 0, VTK_INT_MAX);
+  vtkGetMacro(KeyFrameInterval, int);
+  ///@}
+
+  ///@{
+  /**
+   * Set the width and height, in pixels, of the tiles compared between
+   * frames. Default is 64.
+   */
+  vtkSetClampMacro(TileSize, int, 8, 1024);
+  vtkGetMacro(TileSize, int);
+  ///@}
+
+  /**
+   * Forces the next compressed frame to be a keyframe. Use this when the
+   * frames produced by this compressor start going to a different receiver.
+   */
+  void RequestKeyFrame();
+
+  ///@{
+  /**
+   * Compress/Decompress data array on the objects input with results
+   * in the objects output. See also Set/GetInput/Output.
+   */
+  int Compress() override;
+  int Decompress() override;
+  ///@}
+
+  /**
+   * Communicates the next expected image resolution, used to lay out tiles.
+   */
+  void SetImageResolution(int width, int height) override;
+
+  ///@{
+  /**
+   * Serialize/Restore compressor configuration (but not the data) into the
+   * stream. The configuration string is
+   * `vtkDeltaImageCompressor LossLessMode Quality [KeyFrameInterval [TileSize]]`.
+   */
+  void SaveConfiguration(vtkMultiProcessStream* stream) override;
+  bool RestoreConfiguration(vtkMultiProcessStream* stream) override;
+  const char* SaveConfiguration() override;
+  const char* RestoreConfiguration(const char* stream) override;
+  ///@}
+
+protected:
+  vtkDeltaImageCompressor();
+  ~vtkDeltaImageCompressor() override;
+
+  int Quality;
+  int KeyFrameInterval;
+  int TileSize;
+
+  int ImageWidth;
+  int ImageHeight;
+
+private:
+  vtkDeltaImageCompressor(const vtkDeltaImageCompressor&) = delete;
+  void operator=(const vtkDeltaImageCompressor&) = delete;
+
+  // Last frame seen by Compress, as received, and how it was encoded.
+  struct FrameState
+  {
+    std::vector<unsigned char> Pixels;
+    int Width = 0;
+    int Height = 0;
+    int NumberOfComponents = 0;
+    int TileSize = 0;
+    int Quality = 0;
+    vtkTypeUInt32 FrameNumber = 0;
+  };
+  FrameState Reference;
+  int FramesSinceKeyFrame;
+  bool KeyFrameRequested;
+
+  // Last frame produced by Decompress.
+  FrameState Decoded;
+};
+
+#endif
@@ -6,10 +6,31 @@
 
 #include "vtkCommand.h"
 #include "vtkMultiProcessStream.h"
+#include "vtkSMPTools.h"
 #include "vtkUnsignedCharArray.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
 #include <sstream>
 #include <string>
 
+namespace
+{
+// Tiles smaller than this are not worth compressing separately.
+constexpr vtkIdType MinimumPixelsPerTile = 64 * 1024;
+
+// Upper bound on the number of tiles, which also bounds the header size.
+constexpr int MaximumNumberOfTiles = 256;
+
+void GetTileRange(
+  vtkIdType numberOfPixels, int numberOfTiles, int tile, vtkIdType& begin, vtkIdType& end)
+{
+  begin = (numberOfPixels * tile) / numberOfTiles;
+  end = (numberOfPixels * (tile + 1)) / numberOfTiles;
+}
+}
+
 //-----------------------------------------------------------------------------
 vtkCxxSetObjectMacro(vtkImageCompressor, Output, vtkUnsignedCharArray);
 
@@ -88,6 +109,122 @@ const char* vtkImageCompressor::RestoreConfiguration(const char* stream)
   return nullptr;
 }
 
+//-----------------------------------------------------------------------------
+bool vtkImageCompressor::CompressTiles(vtkIdType numberOfPixels, int requestedNumberOfTiles,
+  const TileCompressorType& compressTile, size_t reservedBytes)
+{
+  int numberOfTiles = requestedNumberOfTiles;
+  if (numberOfTiles <= 0)
+  {
+    numberOfTiles = static_cast<int>(std::min<vtkIdType>(
+      vtkSMPTools::GetEstimatedNumberOfThreads(), numberOfPixels / MinimumPixelsPerTile));
+  }
+  numberOfTiles = std::max(1,
+    static_cast<int>(std::min<vtkIdType>(
+      { static_cast<vtkIdType>(numberOfTiles), MaximumNumberOfTiles, numberOfPixels })));
+
+  std::vector<std::vector<unsigned char>> tiles(numberOfTiles);
+  std::atomic<bool> status(true);
+  vtkSMPTools::For(0, numberOfTiles,
+    [&](vtkIdType first, vtkIdType last)
+    {
+      for (vtkIdType tile = first; tile < last; ++tile)
+      {
+        vtkIdType begin, end;
+        ::GetTileRange(numberOfPixels, numberOfTiles, static_cast<int>(tile), begin, end);
+        if (!compressTile(begin, end, tiles[tile]))
+        {
+          status = false;
+        }
+      }
+    });
+  if (!status)
+  {
+    return false;
+  }
+
+  // Assemble the header followed by all tiles.
+  std::vector<vtkTypeUInt32> header(1 + numberOfTiles);
+  header[0] = static_cast<vtkTypeUInt32>(numberOfTiles);
+  size_t totalSize = reservedBytes + header.size() * sizeof(vtkTypeUInt32);
+  for (int tile = 0; tile < numberOfTiles; ++tile)
+  {
+    header[1 + tile] = static_cast<vtkTypeUInt32>(tiles[tile].size());
+    totalSize += tiles[tile].size();
+  }
+
+  this->Output->SetNumberOfComponents(1);
+  this->Output->SetNumberOfTuples(static_cast<vtkIdType>(totalSize));
+  unsigned char* out = this->Output->GetPointer(0) + reservedBytes;
+  std::memcpy(out, header.data(), header.size() * sizeof(vtkTypeUInt32));
+  out += header.size() * sizeof(vtkTypeUInt32);
+  for (const auto& tile : tiles)
+  {
+    std::copy(tile.begin(), tile.end(), out);
+    out += tile.size();
+  }
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+bool vtkImageCompressor::DecompressTiles(
+  vtkIdType numberOfPixels, const TileDecompressorType& decompressTile)
+{
+  const size_t inputSize = static_cast<size_t>(
+    this->Input->GetNumberOfTuples() * this->Input->GetNumberOfComponents());
+  return this->DecompressTiles(
+    this->Input->GetPointer(0), inputSize, numberOfPixels, decompressTile);
+}
+
+//-----------------------------------------------------------------------------
+bool vtkImageCompressor::DecompressTiles(const unsigned char* in, size_t inputSize,
+  vtkIdType numberOfPixels, const TileDecompressorType& decompressTile)
+{
+  vtkTypeUInt32 numberOfTiles = 0;
+  if (inputSize < sizeof(numberOfTiles))
+  {
+    return false;
+  }
+  std::memcpy(&numberOfTiles, in, sizeof(numberOfTiles));
+  const size_t headerSize = (1 + static_cast<size_t>(numberOfTiles)) * sizeof(vtkTypeUInt32);
+  if (numberOfTiles == 0 || numberOfTiles > static_cast<vtkTypeUInt32>(MaximumNumberOfTiles) ||
+    inputSize < headerSize)
+  {
+    return false;
+  }
+
+  // Locate each tile in the input.
+  std::vector<size_t> offsets(numberOfTiles + 1);
+  offsets[0] = headerSize;
+  for (vtkTypeUInt32 tile = 0; tile < numberOfTiles; ++tile)
+  {
+    vtkTypeUInt32 size;
+    std::memcpy(&size, in + (1 + tile) * sizeof(vtkTypeUInt32), sizeof(size));
+    offsets[tile + 1] = offsets[tile] + size;
+  }
+  if (offsets[numberOfTiles] != inputSize)
+  {
+    return false;
+  }
+
+  std::atomic<bool> status(true);
+  const int count = static_cast<int>(numberOfTiles);
+  vtkSMPTools::For(0, count,
+    [&](vtkIdType first, vtkIdType last)
+    {
+      for (vtkIdType tile = first; tile < last; ++tile)
+      {
+        vtkIdType begin, end;
+        ::GetTileRange(numberOfPixels, count, static_cast<int>(tile), begin, end);
+        if (!decompressTile(in + offsets[tile], offsets[tile + 1] - offsets[tile], begin, end))
+        {
+          status = false;
+        }
+      }
+    });
+  return status;
+}
+
 //-----------------------------------------------------------------------------
 void vtkImageCompressor::PrintSelf(ostream& os, vtkIndent indent)
 {
@@ -21,6 +21,9 @@
 #include "vtkObject.h"
 #include "vtkPVVTKExtensionsFiltersRenderingModule.h" // needed for export macro
 
+#include <functional> // for std::function
+#include <vector>     // for std::vector
+
 class vtkUnsignedCharArray;
 class vtkMultiProcessStream;
 
@@ -115,6 +118,33 @@ protected:
   vtkSetStringMacro(Configuration);
   char* Configuration;
 
+  ///@{
+  /**
+   * Helpers for subclasses that split an image into independent tiles which
+   * are compressed, and later decompressed, concurrently using vtkSMPTools.
+   * A tile is a contiguous range of pixels `[begin, end)`.
+   *
+   * `CompressTiles` fills `this->Output` with the number of tiles, the
+   * compressed size of each tile and the compressed tiles themselves.
+   * `compressTile` must append the compressed pixels of a tile to the given
+   * buffer and return false on error. `requestedNumberOfTiles` of 0 picks a
+   * number of tiles based on the image size and the number of threads.
+   * The first `reservedBytes` of the output are left for the caller to fill.
+   *
+   * `DecompressTiles` parses `this->Input`, or the given range of bytes, as
+   * produced by `CompressTiles` and calls `decompressTile` with each
+   * compressed tile and its pixel range.
+   */
+  using TileCompressorType = std::function<bool(vtkIdType, vtkIdType, std::vector<unsigned char>&)>;
+  using TileDecompressorType =
+    std::function<bool(const unsigned char*, size_t, vtkIdType, vtkIdType)>;
+  bool CompressTiles(vtkIdType numberOfPixels, int requestedNumberOfTiles,
+    const TileCompressorType& compressTile, size_t reservedBytes = 0);
+  bool DecompressTiles(vtkIdType numberOfPixels, const TileDecompressorType& decompressTile);
+  bool DecompressTiles(const unsigned char* in, size_t inputSize, vtkIdType numberOfPixels,
+    const TileDecompressorType& decompressTile);
+  ///@}
+
 private:
   vtkImageCompressor(const vtkImageCompressor&) = delete;
   void operator=(const vtkImageCompressor&) = delete;
@@ -7,14 +7,16 @@
 #include "vtkUnsignedCharArray.h"
 
 #include "vtk_lz4.h"
+#include <algorithm>
 #include <cassert>
-#include <iostream>
 #include <sstream>
+#include <vector>
 
 vtkStandardNewMacro(vtkLZ4Compressor);
 //----------------------------------------------------------------------------
 vtkLZ4Compressor::vtkLZ4Compressor()
   : Quality(3)
+  , NumberOfTiles(0)
 {
 }
 
@@ -43,27 +45,38 @@ int vtkLZ4Compressor::Compress()
   memcpy(&compress_mask, &compress_masks[compress_level], 4);
 
   vtkUnsignedCharArray* input = this->Input;
-  int inputSize = input->GetNumberOfTuples() * input->GetNumberOfComponents();
+  const int numComps = input->GetNumberOfComponents();
+  const bool applyMask = (compress_level > 0 && numComps == 4);
+  const unsigned char* inputPtr = input->GetPointer(0);
 
-  if (this->Quality > 0 && input->GetNumberOfComponents() == 4)
-  {
-    this->TemporaryBuffer->SetNumberOfComponents(input->GetNumberOfComponents());
-    this->TemporaryBuffer->SetNumberOfTuples(input->GetNumberOfTuples());
-    const unsigned int* in = reinterpret_cast<const unsigned int*>(input->GetPointer(0));
-    unsigned int* out = reinterpret_cast<unsigned int*>(this->TemporaryBuffer->GetPointer(0));
-    for (vtkIdType cc = 0, max = this->Input->GetNumberOfTuples(); cc < max; ++cc)
+  // Each tile is compressed as an independent LZ4 block.
+  const bool status = this->CompressTiles(input->GetNumberOfTuples(), this->NumberOfTiles,
+    [&](vtkIdType begin, vtkIdType end, std::vector<unsigned char>& buffer)
     {
-      out[cc] = in[cc] & compress_mask;
-    }
-    input = this->TemporaryBuffer.Get();
-  }
-
-  int maxOutputSize = LZ4_compressBound(inputSize);
-  int compressedSize = LZ4_compress_fast(reinterpret_cast<const char*>(input->GetPointer(0)),
-    reinterpret_cast<char*>(this->Output->WritePointer(0, maxOutputSize)), inputSize, maxOutputSize,
-    16);
-  this->Output->SetNumberOfTuples(compressedSize);
-  return compressedSize > 0 ? VTK_OK : VTK_ERROR;
+      const int tileSize = static_cast<int>((end - begin) * numComps);
+      const char* source = reinterpret_cast<const char*>(inputPtr + begin * numComps);
+
+      // For lossy compression, reduce the colors before compressing.
+      std::vector<unsigned int> masked;
+      if (applyMask)
+      {
+        const unsigned int* in = reinterpret_cast<const unsigned int*>(source);
+        masked.resize(static_cast<size_t>(end - begin));
+        for (vtkIdType cc = 0, max = end - begin; cc < max; ++cc)
+        {
+          masked[cc] = in[cc] & compress_mask;
+        }
+        source = reinterpret_cast<const char*>(masked.data());
+      }
+
+      const int maxOutputSize = LZ4_compressBound(tileSize);
+      buffer.resize(static_cast<size_t>(maxOutputSize));
+      const int compressedSize = LZ4_compress_fast(
+        source, reinterpret_cast<char*>(buffer.data()), tileSize, maxOutputSize, 16);
+      buffer.resize(static_cast<size_t>(std::max(compressedSize, 0)));
+      return compressedSize > 0 || tileSize == 0;
+    });
+  return status ? VTK_OK : VTK_ERROR;
 }
 
 //----------------------------------------------------------------------------
@@ -75,27 +88,27 @@ int vtkLZ4Compressor::Decompress()
     return VTK_ERROR;
   }
 
-  int maxDecompressedSize =
-    this->Output->GetNumberOfComponents() * this->Output->GetNumberOfTuples();
-  int decompressedSize =
-    LZ4_decompress_safe(reinterpret_cast<const char*>(this->Input->GetPointer(0)),
-      reinterpret_cast<char*>(this->Output->GetPointer(0)), this->Input->GetNumberOfTuples(),
-      maxDecompressedSize);
-
-  //  // We use LZ4_decompress_safe for now since there seems to be some bug
-  //  // in LZ4_decompress_fast which is causing segfaults on Windows.
-  //  int decompressedSize = LZ4_decompress_fast(
-  //    reinterpret_cast<const char*>(this->Input->GetPointer(0)),
-  //    reinterpret_cast<char*>(this->Output->GetPointer(0)),
-  //    maxDecompressedSize);
-  return decompressedSize > 0 ? VTK_OK : VTK_ERROR;
+  const int numComps = this->Output->GetNumberOfComponents();
+  unsigned char* outputPtr = this->Output->GetPointer(0);
+  const bool status = this->DecompressTiles(this->Output->GetNumberOfTuples(),
+    [&](const unsigned char* data, size_t size, vtkIdType begin, vtkIdType end)
+    {
+      const int maxDecompressedSize = static_cast<int>((end - begin) * numComps);
+      // We use LZ4_decompress_safe since there seems to be some bug in
+      // LZ4_decompress_fast which is causing segfaults on Windows.
+      const int decompressedSize = LZ4_decompress_safe(reinterpret_cast<const char*>(data),
+        reinterpret_cast<char*>(outputPtr + begin * numComps), static_cast<int>(size),
+        maxDecompressedSize);
+      return decompressedSize == maxDecompressedSize;
+    });
+  return status ? VTK_OK : VTK_ERROR;
 }
 
 //-----------------------------------------------------------------------------
 void vtkLZ4Compressor::SaveConfiguration(vtkMultiProcessStream* stream)
 {
   this->Superclass::SaveConfiguration(stream);
-  *stream << this->Quality;
+  *stream << this->Quality << this->NumberOfTiles;
 }
 
 //-----------------------------------------------------------------------------
@@ -103,9 +116,10 @@ bool vtkLZ4Compressor::RestoreConfiguration(vtkMultiProcessStream* stream)
 {
   if (this->Superclass::RestoreConfiguration(stream))
   {
-    int quality;
-    *stream >> quality;
+    int quality, numberOfTiles;
+    *stream >> quality >> numberOfTiles;
     this->SetQuality(quality);
+    this->SetNumberOfTiles(numberOfTiles);
     return true;
   }
   return false;
@@ -115,7 +129,8 @@ bool vtkLZ4Compressor::RestoreConfiguration(vtkMultiProcessStream* stream)
 const char* vtkLZ4Compressor::SaveConfiguration()
 {
   std::ostringstream oss;
-  oss << this->Superclass::SaveConfiguration() << " " << this->Quality;
+  oss << this->Superclass::SaveConfiguration() << " " << this->Quality << " "
+      << this->NumberOfTiles;
   this->SetConfiguration(oss.str().c_str());
   return this->Configuration;
 }
@@ -130,6 +145,14 @@ const char* vtkLZ4Compressor::RestoreConfiguration(const char* stream)
     int quality;
     iss >> quality;
     this->SetQuality(quality);
+    int numberOfTiles = 0;
+    if (!(iss >> numberOfTiles))
+    {
+      // not specified, use automatic tiling.
+      numberOfTiles = 0;
+      iss.clear();
+    }
+    this->SetNumberOfTiles(numberOfTiles);
     return stream + iss.tellg();
   }
   return nullptr;
@@ -139,5 +162,6 @@ const char* vtkLZ4Compressor::RestoreConfiguration(const char* stream)
 void vtkLZ4Compressor::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
-  std::cout << "Quality: " << this->Quality << endl;
+  os << indent << "Quality: " << this->Quality << endl;
+  os << indent << "NumberOfTiles: " << this->NumberOfTiles << endl;
 }
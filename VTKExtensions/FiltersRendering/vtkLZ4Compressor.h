@@ -13,7 +13,6 @@
 #define vtkLZ4Compressor_h
 
 #include "vtkImageCompressor.h"
-#include "vtkNew.h"                                   // needed for vtkNew
 #include "vtkPVVTKExtensionsFiltersRenderingModule.h" // needed for exports
 
 class vtkMultiProcessStream;
@@ -36,6 +35,17 @@ public:
   vtkGetMacro(Quality, int);
   ///@}
 
+  ///@{
+  /**
+   * Set the number of LZ4 blocks the image is split into, each covering a
+   * contiguous range of pixels. Blocks are (de)compressed concurrently. 0
+   * (default) chooses the count from the image size and thread count. May be
+   * given after the quality in the configuration string.
+   */
+  vtkSetClampMacro(NumberOfTiles, int, 0, 256);
+  vtkGetMacro(NumberOfTiles, int);
+  ///@}
+
   ///@{
   /**
    * Compress/Decompress data array on the objects input with results
@@ -60,13 +70,11 @@ protected:
   ~vtkLZ4Compressor() override;
 
   int Quality;
+  int NumberOfTiles;
 
 private:
   vtkLZ4Compressor(const vtkLZ4Compressor&) = delete;
   void operator=(const vtkLZ4Compressor&) = delete;
-
-  // Used when Quality > 1.
-  vtkNew<vtkUnsignedCharArray> TemporaryBuffer;
 };
 
 #endif
@@ -20,6 +20,7 @@
 #include "vtkExplicitStructuredGrid.h"
 #include "vtkExplicitStructuredGridSurfaceFilter.h"
 #include "vtkFeatureEdges.h"
+#include "vtkFieldData.h"
 #include "vtkFloatArray.h"
 #include "vtkGarbageCollector.h"
 #include "vtkGenericDataSet.h"
@@ -44,6 +45,8 @@
 #include "vtkPartitionedDataSet.h"
 #include "vtkPartitionedDataSetCollection.h"
 #include "vtkPointData.h"
+#include "vtkPointSet.h"
+#include "vtkPoints.h"
 #include "vtkPolyData.h"
 #include "vtkPolyDataNormals.h"
 #include "vtkPolygon.h"
@@ -51,6 +54,8 @@
 #include "vtkRecoverGeometryWireframe.h"
 #include "vtkRectilinearGrid.h"
 #include "vtkRectilinearGridOutlineFilter.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStructuredGrid.h"
@@ -65,9 +70,12 @@
 #include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <map>
 #include <memory>
 #include <numeric>
+#include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace
@@ -75,6 +83,40 @@ namespace
 constexpr const char* ORIGINAL_FACE_IDS = "RecoverWireframeOriginalFaceIds";
 constexpr const char* TEMP_ORIGINAL_IDS = "__original_ids__";
 
+//----------------------------------------------------------------------------
+/**
+ * Adds the objects of `dobj` whose lazily computed state (bounds, array
+ * ranges) is cached on the object itself rather than on `dobj`, i.e. its
+ * points and arrays, to `objects`.
+ */
+void GetSharableObjects(vtkDataObject* dobj, std::vector<vtkObject*>& objects)
+{
+  if (auto ps = vtkPointSet::SafeDownCast(dobj))
+  {
+    if (auto points = ps->GetPoints())
+    {
+      objects.push_back(points);
+      objects.push_back(points->GetData());
+    }
+  }
+  else if (auto rg = vtkRectilinearGrid::SafeDownCast(dobj))
+  {
+    objects.push_back(rg->GetXCoordinates());
+    objects.push_back(rg->GetYCoordinates());
+    objects.push_back(rg->GetZCoordinates());
+  }
+  for (int type = 0; type < vtkDataObject::NUMBER_OF_ATTRIBUTE_TYPES; ++type)
+  {
+    if (auto fd = dobj->GetAttributesAsFieldData(type))
+    {
+      for (int cc = 0, max = fd->GetNumberOfArrays(); cc < max; ++cc)
+      {
+        objects.push_back(fd->GetAbstractArray(cc));
+      }
+    }
+  }
+}
+
 //----------------------------------------------------------------------------
 void AddOriginalIds(vtkDataSetAttributes* attributes, vtkIdType size)
 {
@@ -147,6 +189,71 @@ void CleanupTemporaryOriginalIds(vtkDataObject* object)
   }
 }
 
+//----------------------------------------------------------------------------
+/**
+ * Returns the vtkDataSet leaves of a vtkDataObjectTree, or the object itself
+ * when it is a vtkDataSet.
+ */
+std::vector<vtkDataSet*> GetLeafDataSets(vtkDataObject* object)
+{
+  if (auto dataSet = vtkDataSet::SafeDownCast(object))
+  {
+    return { dataSet };
+  }
+  if (auto composite = vtkCompositeDataSet::SafeDownCast(object))
+  {
+    return vtkCompositeDataSet::GetDataSets(composite);
+  }
+  return {};
+}
+
+//----------------------------------------------------------------------------
+void AddArrayNames(vtkDataSetAttributes* attributes, std::set<std::string>& names)
+{
+  for (int cc = 0; cc < attributes->GetNumberOfArrays(); ++cc)
+  {
+    if (const char* name = attributes->GetArrayName(cc))
+    {
+      names.insert(name);
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+/**
+ * Returns the point and cell arrays that this filter generated, i.e. present
+ * in the output but not in the input. These arrays (original ids, normals,
+ * edge flags, process ids...) only depend on the mesh, so they must be kept
+ * from the cached output instead of being dropped when only the input
+ * attributes are forwarded.
+ */
+std::set<std::string> GetGeneratedArrays(vtkDataObject* input, vtkDataObject* output)
+{
+  std::set<std::string> inputArrays;
+  for (vtkDataSet* dataSet : ::GetLeafDataSets(input))
+  {
+    ::AddArrayNames(dataSet->GetPointData(), inputArrays);
+    ::AddArrayNames(dataSet->GetCellData(), inputArrays);
+  }
+
+  std::set<std::string> outputArrays;
+  for (vtkDataSet* dataSet : ::GetLeafDataSets(output))
+  {
+    ::AddArrayNames(dataSet->GetPointData(), outputArrays);
+    ::AddArrayNames(dataSet->GetCellData(), outputArrays);
+  }
+
+  std::set<std::string> generatedArrays;
+  for (const std::string& name : outputArrays)
+  {
+    if (inputArrays.find(name) == inputArrays.end() && name != ::TEMP_ORIGINAL_IDS)
+    {
+      generatedArrays.insert(name);
+    }
+  }
+  return generatedArrays;
+}
+
 };
 
 namespace
@@ -235,9 +342,7 @@ vtkPVGeometryFilter::vtkPVGeometryFilter()
   this->HideInternalAMRFaces = true;
   this->UseNonOverlappingAMRMetaDataForOutlines = true;
 
-  this->MeshCache->SetConsumer(this);
-  this->MeshCache->AddOriginalIds(vtkDataObject::POINT, ::TEMP_ORIGINAL_IDS);
-  this->MeshCache->AddOriginalIds(vtkDataObject::CELL, ::TEMP_ORIGINAL_IDS);
+  this->ResetMeshCache({});
 }
 
 //----------------------------------------------------------------------------
@@ -246,6 +351,74 @@ vtkPVGeometryFilter::~vtkPVGeometryFilter()
   this->SetController(nullptr);
 }
 
+//----------------------------------------------------------------------------
+/**
+ * Executes a range of distinct leaf blocks. Internal filters are not
+ * thread-safe, so every thread uses its own vtkPVGeometryFilter configured
+ * like the filter that owns the functor.
+ */
+class vtkPVGeometryFilter::BlockExecutionFunctor
+{
+public:
+  BlockExecutionFunctor(vtkPVGeometryFilter* self, const std::vector<vtkDataObject*>& blocks,
+    const std::vector<vtkIdType>& blockIndices, std::vector<vtkSmartPointer<vtkPolyData>>& outputs,
+    std::vector<int>& outlineFlags, const int* wholeExtent)
+    : Self(self)
+    , Blocks(blocks)
+    , BlockIndices(blockIndices)
+    , Outputs(outputs)
+    , OutlineFlags(outlineFlags)
+    , WholeExtent(wholeExtent)
+  {
+  }
+
+  void Initialize()
+  {
+    vtkPVGeometryFilter* worker = this->Workers.Local();
+    vtkPVGeometryFilter* self = this->Self;
+    worker->SetController(self->Controller);
+    worker->SetUseOutline(self->UseOutline);
+    worker->SetBlockColorsDistinctValues(self->BlockColorsDistinctValues);
+    worker->SetGenerateFeatureEdges(self->GenerateFeatureEdges);
+    worker->SetGenerateCellNormals(self->GenerateCellNormals);
+    worker->SetGeneratePointNormals(self->GeneratePointNormals);
+    worker->SetSplitting(self->Splitting);
+    worker->SetFeatureAngle(self->FeatureAngle);
+    worker->SetTriangulate(self->Triangulate);
+    worker->SetNonlinearSubdivisionLevel(self->NonlinearSubdivisionLevel);
+    worker->SetMatchBoundariesIgnoringCellOrder(self->MatchBoundariesIgnoringCellOrder);
+    worker->SetPassThroughCellIds(self->PassThroughCellIds);
+    worker->SetPassThroughPointIds(self->PassThroughPointIds);
+    worker->SetGenerateProcessIds(self->GenerateProcessIds);
+    worker->SetHideInternalAMRFaces(self->HideInternalAMRFaces);
+    worker->SetUseNonOverlappingAMRMetaDataForOutlines(
+      self->UseNonOverlappingAMRMetaDataForOutlines);
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkPVGeometryFilter* worker = this->Workers.Local();
+    for (vtkIdType cc = begin; cc < end; ++cc)
+    {
+      const vtkIdType blockIndex = this->BlockIndices[cc];
+      this->Outputs[blockIndex] =
+        worker->ExecuteLeafBlock(this->Blocks[blockIndex], this->WholeExtent);
+      this->OutlineFlags[blockIndex] = worker->OutlineFlag;
+    }
+  }
+
+  void Reduce() {}
+
+private:
+  vtkPVGeometryFilter* Self;
+  const std::vector<vtkDataObject*>& Blocks;
+  const std::vector<vtkIdType>& BlockIndices;
+  std::vector<vtkSmartPointer<vtkPolyData>>& Outputs;
+  std::vector<int>& OutlineFlags;
+  const int* WholeExtent;
+  vtkSMPThreadLocalObject<vtkPVGeometryFilter> Workers;
+};
+
 //----------------------------------------------------------------------------
 int vtkPVGeometryFilter::RequestDataObject(vtkInformation* vtkNotUsed(request),
   vtkInformationVector** inputVector, vtkInformationVector* outputVector)
@@ -460,8 +633,30 @@ void vtkPVGeometryFilter::ExecuteBlock(vtkDataObject* input, vtkPolyData* output
 }
 
 //----------------------------------------------------------------------------
-void vtkPVGeometryFilter::UpdateCache(vtkDataObject* output)
+void vtkPVGeometryFilter::ResetMeshCache(const std::set<std::string>& preservedArrays)
+{
+  this->MeshCache = vtkSmartPointer<vtkDataObjectMeshCache>::New();
+  this->MeshCache->SetConsumer(this);
+  this->MeshCache->AddOriginalIds(vtkDataObject::POINT, ::TEMP_ORIGINAL_IDS);
+  this->MeshCache->AddOriginalIds(vtkDataObject::CELL, ::TEMP_ORIGINAL_IDS);
+  for (const std::string& name : preservedArrays)
+  {
+    this->MeshCache->AddPreservedCachedArray(name);
+  }
+  this->PreservedCachedArrays = preservedArrays;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVGeometryFilter::UpdateCache(vtkDataObject* input, vtkDataObject* output)
 {
+  // The cache cannot forget preserved arrays, so start from a new one when
+  // the generated arrays changed with the input or the filter options.
+  std::set<std::string> generatedArrays = ::GetGeneratedArrays(input, output);
+  if (generatedArrays != this->PreservedCachedArrays)
+  {
+    this->ResetMeshCache(generatedArrays);
+    this->MeshCache->SetOriginalDataObject(input);
+  }
   this->MeshCache->UpdateCache(output);
   ::CleanupTemporaryOriginalIds(output);
 }
@@ -556,7 +751,7 @@ int vtkPVGeometryFilter::RequestData(
 
   if (isCachingSupported)
   {
-    this->UpdateCache(dataObjectOutput);
+    this->UpdateCache(modifiedInput, dataObjectOutput);
   }
   return 1;
 }
@@ -860,6 +1055,29 @@ vtkSmartPointer<vtkDataObjectTree> vtkPVGeometryFilter::GetDataObjectTreeInput(
   return tempInput;
 }
 
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkPolyData> vtkPVGeometryFilter::ExecuteLeafBlock(
+  vtkDataObject* block, const int* wholeExtent)
+{
+  if (!block)
+  {
+    return nullptr;
+  }
+
+  vtkNew<vtkPolyData> output;
+  auto blockHTG = vtkHyperTreeGrid::SafeDownCast(block);
+  if (this->GenerateFeatureEdges && blockHTG)
+  {
+    this->GenerateFeatureEdgesHTG(blockHTG, output);
+  }
+  else
+  {
+    this->ExecuteBlock(block, output, 0, 0, 1, 0, wholeExtent);
+    this->CleanupOutputData(output);
+  }
+  return output;
+}
+
 //----------------------------------------------------------------------------
 int vtkPVGeometryFilter::RequestDataObjectTree(
   vtkInformation*, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
@@ -895,34 +1113,118 @@ int vtkPVGeometryFilter::RequestDataObjectTree(
     ++totalNumberOfBlocks;
   }
 
-  int* wholeExtent =
-    vtkStreamingDemandDrivenPipeline::GetWholeExtent(inputVector[0]->GetInformationObject(0));
-  int numInputs = 0;
+  std::vector<vtkDataObject*> blocks;
+  blocks.reserve(totalNumberOfBlocks);
   for (inIter->InitTraversal(); !inIter->IsDoneWithTraversal(); inIter->GoToNextItem())
   {
-    vtkDataObject* block = inIter->GetCurrentDataObject();
-    if (!block)
+    blocks.push_back(inIter->GetCurrentDataObject());
+  }
+
+  // A leaf may appear several times in the tree. Execute it once, so that no
+  // two threads work on the same data object, and copy its result afterwards.
+  const vtkIdType numberOfBlocks = static_cast<vtkIdType>(blocks.size());
+  std::vector<vtkIdType> distinctBlocks;
+  std::vector<vtkIdType> firstOccurrences(numberOfBlocks);
+  {
+    std::map<vtkDataObject*, vtkIdType> blockIndices;
+    for (vtkIdType cc = 0; cc < numberOfBlocks; ++cc)
     {
-      continue;
+      auto inserted = blockIndices.insert(std::make_pair(blocks[cc], cc));
+      firstOccurrences[cc] = inserted.first->second;
+      if (inserted.second)
+      {
+        distinctBlocks.push_back(cc);
+      }
     }
+  }
 
-    vtkNew<vtkPolyData> tmpOut;
-    auto blockHTG = vtkHyperTreeGrid::SafeDownCast(block);
-    if (this->GenerateFeatureEdges && blockHTG)
+  // Distinct leaves may still share points or arrays, e.g. after shallow
+  // copies. Computing bounds and ranges updates caches on these shared objects,
+  // hence such leaves are executed on the calling thread.
+  std::vector<vtkIdType> concurrentBlocks;
+  std::vector<vtkIdType> serialBlocks;
+  {
+    std::vector<std::vector<vtkObject*>> sharableObjects(distinctBlocks.size());
+    std::unordered_map<vtkObject*, int> sharableObjectCounts;
+    for (size_t cc = 0; cc < distinctBlocks.size(); ++cc)
     {
-      this->GenerateFeatureEdgesHTG(blockHTG, tmpOut);
+      if (vtkDataObject* block = blocks[distinctBlocks[cc]])
+      {
+        ::GetSharableObjects(block, sharableObjects[cc]);
+      }
+      std::sort(sharableObjects[cc].begin(), sharableObjects[cc].end());
+      sharableObjects[cc].erase(std::unique(sharableObjects[cc].begin(), sharableObjects[cc].end()),
+        sharableObjects[cc].end());
+      for (vtkObject* object : sharableObjects[cc])
+      {
+        ++sharableObjectCounts[object];
+      }
     }
-    else
+    for (size_t cc = 0; cc < distinctBlocks.size(); ++cc)
     {
-      this->ExecuteBlock(block, tmpOut, 0, 0, 1, 0, wholeExtent);
-      this->CleanupOutputData(tmpOut);
+      const bool shared = std::any_of(sharableObjects[cc].begin(), sharableObjects[cc].end(),
+        [&](vtkObject* object) { return object && sharableObjectCounts[object] > 1; });
+      (shared ? serialBlocks : concurrentBlocks).push_back(distinctBlocks[cc]);
     }
+  }
+
+  int* wholeExtent =
+    vtkStreamingDemandDrivenPipeline::GetWholeExtent(inputVector[0]->GetInformationObject(0));
+  const vtkIdType numberOfDistinctBlocks = static_cast<vtkIdType>(distinctBlocks.size());
+  const vtkIdType numberOfConcurrentBlocks = static_cast<vtkIdType>(concurrentBlocks.size());
+  std::vector<vtkSmartPointer<vtkPolyData>> blockOutputs(numberOfBlocks);
+  std::vector<int> outlineFlags(numberOfBlocks, this->OutlineFlag);
+  {
+    // Leaves are processed without communication, so they are independent of
+    // each other. Execute them concurrently, each thread using its own copy of
+    // this filter, and keep the results in traversal order. Deferred garbage
+    // collection only applies to the main thread, objects released by the
+    // workers are collected right away.
+    BlockExecutionFunctor functor(
+      this, blocks, concurrentBlocks, blockOutputs, outlineFlags, wholeExtent);
+    // Run in batches so progress is still reported from this thread.
+    const vtkIdType batchSize = std::max<vtkIdType>(numberOfConcurrentBlocks / 10,
+      static_cast<vtkIdType>(vtkSMPTools::GetEstimatedNumberOfThreads()));
+    for (vtkIdType begin = 0; begin < numberOfConcurrentBlocks; begin += batchSize)
+    {
+      const vtkIdType end = std::min(begin + batchSize, numberOfConcurrentBlocks);
+      vtkSMPTools::For(begin, end, 1, functor);
+      this->UpdateProgress(static_cast<double>(end) / numberOfDistinctBlocks);
+    }
+  }
+  vtkIdType numberOfExecutedBlocks = numberOfConcurrentBlocks;
+  for (vtkIdType blockIndex : serialBlocks)
+  {
+    blockOutputs[blockIndex] = this->ExecuteLeafBlock(blocks[blockIndex], wholeExtent);
+    outlineFlags[blockIndex] = this->OutlineFlag;
+    this->UpdateProgress(static_cast<double>(++numberOfExecutedBlocks) / numberOfDistinctBlocks);
+  }
+
+  for (vtkIdType cc = 0; cc < numberOfBlocks; ++cc)
+  {
+    const vtkIdType first = firstOccurrences[cc];
+    if (first != cc && blockOutputs[first])
+    {
+      blockOutputs[cc].TakeReference(blockOutputs[first]->NewInstance());
+      blockOutputs[cc]->ShallowCopy(blockOutputs[first]);
+      outlineFlags[cc] = outlineFlags[first];
+    }
+    // As when executing the leaves in order, the last non-empty leaf decides.
+    if (blocks[cc])
+    {
+      this->OutlineFlag = outlineFlags[cc];
+    }
+  }
+
+  vtkIdType blockIndex = 0;
+  for (inIter->InitTraversal(); !inIter->IsDoneWithTraversal(); inIter->GoToNextItem())
+  {
+    vtkPolyData* blockOutput = blockOutputs[blockIndex++];
     // skip empty nodes.
-    if (tmpOut->GetNumberOfPoints() > 0)
+    if (blockOutput && blockOutput->GetNumberOfPoints() > 0)
     {
-      output->SetDataSet(inIter, tmpOut);
+      output->SetDataSet(inIter, blockOutput);
     }
-    this->UpdateProgress(static_cast<float>(++numInputs) / totalNumberOfBlocks);
   }
   vtkTimerLog::MarkEndEvent("vtkPVGeometryFilter::ExecuteCompositeDataSet");
 
@@ -18,6 +18,9 @@
 
 #include "vtkNew.h" // for vtkNew
 
+#include <set>    // for std::set
+#include <string> // for std::string
+
 class vtkCartesianGrid;
 class vtkCellGrid;
 class vtkDataSet;
@@ -373,6 +376,15 @@ private:
    */
   void GenerateFeatureEdgesHTG(vtkHyperTreeGrid* input, vtkPolyData* output);
 
+  /**
+   * Produce the geometry for a single leaf of a vtkDataObjectTree, without
+   * communicating with other processes. Returns nullptr if \c block is nullptr.
+   * Leaves are independent, so RequestDataObjectTree() executes them
+   * concurrently using one instance of this filter per thread.
+   */
+  vtkSmartPointer<vtkPolyData> ExecuteLeafBlock(vtkDataObject* block, const int* wholeExtent);
+  class BlockExecutionFunctor;
+
   /**
    * Execute normals computation for the output polydata.
    */
@@ -391,9 +403,18 @@ private:
   bool UseCacheIfPossible(vtkDataObject* input, vtkDataObject* output);
 
   /**
-   * Update cache content with given data object.
+   * Update cache content with given data object. Arrays generated by this
+   * filter, i.e. not found in \c input, are kept when the cache is reused.
+   * When they differ from the ones of the previous execution, the cache is
+   * reset so that arrays no longer generated are not preserved anymore.
+   */
+  void UpdateCache(vtkDataObject* input, vtkDataObject* output);
+
+  /**
+   * Create a new mesh cache, forwarding attributes through the temporary
+   * original ids and preserving the given generated arrays.
    */
-  void UpdateCache(vtkDataObject* output);
+  void ResetMeshCache(const std::set<std::string>& preservedArrays);
 
   /**
    * Get the input as a vtkDataObjectTree.
@@ -405,7 +426,8 @@ private:
    */
   vtkSmartPointer<vtkDataObjectTree> GetDataObjectTreeInput(vtkInformationVector** inputVector);
 
-  vtkNew<vtkDataObjectMeshCache> MeshCache;
+  vtkSmartPointer<vtkDataObjectMeshCache> MeshCache;
+  std::set<std::string> PreservedCachedArrays;
 };
 
 #endif
@@ -29,7 +29,9 @@
 #include "vtkUnsignedIntArray.h"
 
 #include <algorithm>
+#include <array>
 #include <iostream>
+#include <map>
 #include <sstream>
 #include <string>
 #include <unordered_map>
@@ -38,6 +40,12 @@
 
 using std::ostringstream;
 
+namespace
+{
+// Maximum number of sort indices kept, each using about 16 bytes per local row.
+constexpr std::size_t MaximumNumberOfSortIndices = 4;
+}
+
 //****************************************************************************
 class vtkSortedTableStreamer::InternalsBase
 {
@@ -55,6 +63,9 @@ public:
   virtual bool IsSortable() = 0;
   virtual bool TestInternalClasses() = 0;
 
+  // Time of the last use, used to discard the least recently used sort index.
+  vtkMTimeType LastUsed = 0;
+
   // --------------------------------------------------------------------------
   //  static void WaitForGDB()
   //    {
@@ -605,6 +616,18 @@ public:
   // --------------------------------------------------------------------------
   bool IsSortable() override
   {
+    // The range is reduced across processes and requires a pass over the
+    // array, so only compute it once per index.
+    if (this->SortableComputed)
+    {
+      // Extract() may have changed the range in the meantime.
+      this->CommonRange[0] = this->SortableRange[0];
+      this->CommonRange[1] = this->SortableRange[1];
+      return this->Sortable;
+    }
+    this->SortableComputed = true;
+    this->Sortable = false;
+
     // See if one process is able to sort the table,
     // if not then just say NOT sortable
     int localCanSort = (this->DataToSort == nullptr) ? 0 : 1;
@@ -666,6 +689,9 @@ public:
     this->CommonRange[0] -= epsilon;
     this->CommonRange[1] += epsilon;
 
+    this->Sortable = sortable;
+    this->SortableRange[0] = this->CommonRange[0];
+    this->SortableRange[1] = this->CommonRange[1];
     return sortable;
   }
 
@@ -674,6 +700,7 @@ public:
   {
     // We are building the cache so no need to build it next time
     this->NeedToBuildCache = false;
+    this->SearchCache.clear();
 
     // Communication buffer
     vtkIdType* bufferHistogramValues = new vtkIdType[this->NumProcs * HISTOGRAM_SIZE];
@@ -1013,6 +1040,19 @@ public:
     Histogram* globalHistogram, vtkIdType& nbGlobalToSkip, vtkIdType& localOffset,
     vtkIdType& nbInLocalBar)
   {
+    // Pages are typically requested more than once, e.g. when scrolling back
+    // and forth, and the upper bound of a page is the lower bound of the next
+    // one. Since every process requests the same pages, the cache is the same
+    // on all processes and the collective calls below stay matched.
+    auto cached = this->SearchCache.find(searchedGlobalIndex);
+    if (cached != this->SearchCache.end())
+    {
+      nbGlobalToSkip = cached->second[0];
+      localOffset = cached->second[1];
+      nbInLocalBar = cached->second[2];
+      return;
+    }
+
     // Communication buffer
     vtkIdType* bufferHistogramValues = new vtkIdType[this->NumProcs * HISTOGRAM_SIZE];
 
@@ -1065,6 +1105,7 @@ public:
     } while (nbGlobalToSkip > 0 && _globalHistogram.CanBeReduced());
 
     delete[] bufferHistogramValues;
+    this->SearchCache[searchedGlobalIndex] = { { nbGlobalToSkip, localOffset, nbInLocalBar } };
   }
 
   // --------------------------------------------------------------------------
@@ -1130,13 +1171,18 @@ public:
   }
 
   // --------------------------------------------------------------------------
-  void InvalidateCache() override { this->NeedToBuildCache = true; }
+  void InvalidateCache() override
+  {
+    this->NeedToBuildCache = true;
+    this->SortableComputed = false;
+    this->SearchCache.clear();
+  }
 
   // --------------------------------------------------------------------------
   bool IsInvalid(vtkTable* input, vtkDataArray* dataToProcess) override
   {
-    return !dataToProcess || input->GetMTime() != this->InputMTime ||
-      dataToProcess->GetMTime() != this->DataMTime;
+    return dataToProcess != this->DataToSort || input->GetMTime() != this->InputMTime ||
+      (dataToProcess && dataToProcess->GetMTime() != this->DataMTime);
   }
 
   // --------------------------------------------------------------------------
@@ -1356,6 +1402,15 @@ private:
   bool NeedToBuildCache;
   bool Debug;
 
+  // Result of IsSortable(), computed once per index.
+  bool SortableComputed = false;
+  bool Sortable = false;
+  double SortableRange[2] = { 0, 0 };
+
+  // Results of SearchGlobalIndexLocation() for the global indices searched
+  // since the cache was built.
+  std::map<vtkIdType, std::array<vtkIdType, 3>> SearchCache;
+
   static constexpr int VTK_TABLE_EXCHANGE_TAG = 50;
   // HISTOGRAM_SIZE could be computed dynamically based on the type of the
   // array to sort but to make sure that unsigned char won't be distributed
@@ -1378,7 +1433,6 @@ vtkSortedTableStreamer::vtkSortedTableStreamer()
   this->SetColumnToSort("");
   this->Block = 0;
   this->BlockSize = 1024;
-  this->Internal = nullptr;
   this->SelectedComponent = 0;
   this->SetController(vtkMultiProcessController::GetGlobalController());
 }
@@ -1388,11 +1442,6 @@ vtkSortedTableStreamer::~vtkSortedTableStreamer()
 {
   this->SetColumnToSort(nullptr);
   this->SetController(nullptr);
-  if (this->Internal)
-  {
-    delete this->Internal;
-    this->Internal = nullptr;
-  }
 }
 
 //----------------------------------------------------------------------------
@@ -1604,14 +1653,37 @@ vtkSmartPointer<vtkIdTypeArray> vtkSortedTableStreamer::GenerateBlockIndicesArra
 int vtkSortedTableStreamer::RequestData(vtkInformation* vtkNotUsed(request),
   vtkInformationVector** inputVector, vtkInformationVector* outputVector)
 {
-  // Manage multiblock dataset by merging data into a single vtkTable
+  // Manage multiblock dataset by merging data into a single vtkTable. The
+  // merged table is kept so that the sort indices built on it can be reused
+  // when only the requested block changes.
   auto inputPTD = vtkPartitionedDataSet::GetData(inputVector[0], 0);
 
-  vtkSmartPointer<vtkTable> input = this->MergeBlocks(inputPTD);
-  if (this->ShowFieldData)
+  vtkMTimeType inputMTime = inputPTD->GetMTime();
+  for (unsigned int cc = 0, max = inputPTD->GetNumberOfPartitions(); cc < max; ++cc)
+  {
+    if (auto partition = inputPTD->GetPartitionAsDataObject(cc))
+    {
+      inputMTime = std::max(inputMTime, partition->GetMTime());
+    }
+  }
+  const bool mergeInput = this->MergedInput == nullptr || this->MergedInputSource != inputPTD ||
+    this->MergedInputShowFieldData != this->ShowFieldData ||
+    inputMTime > this->MergedInputTime.GetMTime();
+  if (mergeInput)
   {
-    this->PopulateFieldDataArrays(inputPTD, input);
+    this->MergedInput = this->MergeBlocks(inputPTD);
+    if (this->ShowFieldData)
+    {
+      this->PopulateFieldDataArrays(inputPTD, this->MergedInput);
+    }
+    this->MergedInputSource = inputPTD;
+    this->MergedInputShowFieldData = this->ShowFieldData;
+    // indices refer to arrays of the previous table.
+    this->Internal = nullptr;
+    this->SortIndices.clear();
   }
+  vtkTable* input = this->MergedInput;
+
   int hasCompositeIds = vtkDataTabulator::HasInputCompositeIds(inputPTD);
   if (this->Controller && this->Controller->GetNumberOfProcesses() > 1)
   {
@@ -1649,6 +1721,11 @@ int vtkSortedTableStreamer::RequestData(vtkInformation* vtkNotUsed(request),
       input->GetRowData()->AddArray(blockIndicesArray);
     }
   }
+  if (mergeInput)
+  {
+    // after the arrays above were added, since they may modify the input.
+    this->MergedInputTime.Modified();
+  }
 
   // Get input data
   vtkInformation* outInfo = outputVector->GetInformationObject(0);
@@ -1665,17 +1742,54 @@ int vtkSortedTableStreamer::RequestData(vtkInformation* vtkNotUsed(request),
   // single point/cell.
   // --------------------------------------------------------------------------
 
-  // Delete internal object if the input has change (table or array to sort)
-  if (this->Internal && this->Internal->IsInvalid(input, arrayToProcess))
+  int realComponent =
+    (!arrayToProcess) ? 0 : this->GetSelectedComponent() % arrayToProcess->GetNumberOfComponents();
+
+  // Reuse the sort index built for this column, component and order unless
+  // the table or the array to sort changed. Building an index is collective,
+  // so all processes must agree on reusing it.
+  const std::string indexKey = std::string(this->GetColumnToSort() ? this->GetColumnToSort() : "") +
+    "|" + std::to_string(this->GetSelectedComponent()) + "|" +
+    (orderInverted ? "inverted" : "ordered");
+  auto indexIter = this->SortIndices.find(indexKey);
+  int reuseIndex = indexIter != this->SortIndices.end() &&
+    !indexIter->second->IsInvalid(input, arrayToProcess);
+  if (this->Controller && this->Controller->GetNumberOfProcesses() > 1)
   {
-    delete this->Internal;
-    this->Internal = nullptr;
+    int globalReuseIndex;
+    this->Controller->AllReduce(&reuseIndex, &globalReuseIndex, 1, vtkCommunicator::MIN_OP);
+    reuseIndex = globalReuseIndex;
   }
 
-  // Make sure that an internal object is available
-  this->CreateInternalIfNeeded(input, arrayToProcess);
-  int realComponent =
-    (!arrayToProcess) ? 0 : this->GetSelectedComponent() % arrayToProcess->GetNumberOfComponents();
+  if (reuseIndex)
+  {
+    this->Internal = indexIter->second.get();
+  }
+  else
+  {
+    if (indexIter != this->SortIndices.end())
+    {
+      this->SortIndices.erase(indexIter);
+    }
+    while (this->SortIndices.size() >= MaximumNumberOfSortIndices)
+    {
+      auto lru = std::min_element(this->SortIndices.begin(), this->SortIndices.end(),
+        [](const auto& a, const auto& b) { return a.second->LastUsed < b.second->LastUsed; });
+      this->SortIndices.erase(lru);
+    }
+
+    // Make sure that an internal object is available
+    this->Internal = nullptr;
+    this->CreateInternalIfNeeded(input, arrayToProcess);
+    if (!this->Internal)
+    {
+      return 0;
+    }
+    this->SortIndices[indexKey].reset(this->Internal);
+  }
+  vtkTimeStamp lastUsed;
+  lastUsed.Modified();
+  this->Internal->LastUsed = lastUsed;
   this->Internal->SetSelectedComponent(realComponent);
 
   // Manage custom case where sorting occur on a virtual array (process id)
@@ -1712,29 +1826,14 @@ const char* vtkSortedTableStreamer::GetColumnNameToSort()
 //----------------------------------------------------------------------------
 void vtkSortedTableStreamer::SetColumnNameToSort(const char* columnName)
 {
+  // sort indices are kept per column, see RequestData().
   this->SetColumnToSort(columnName);
-  if (strcmp("vtkOriginalProcessIds", this->GetColumnToSort()) != 0)
-  {
-    if (this->Internal)
-    {
-      delete this->Internal;
-      this->Internal = nullptr;
-    }
-  }
 }
 //----------------------------------------------------------------------------
 void vtkSortedTableStreamer::SetInvertOrder(int newValue)
 {
-  bool changed = this->InvertOrder != newValue;
-  bool removeInternal = changed && strcmp("vtkOriginalProcessIds", this->GetColumnToSort()) != 0;
-
-  if (removeInternal && this->Internal)
-  {
-    delete this->Internal;
-    this->Internal = nullptr;
-  }
-
-  if (changed)
+  // sort indices are kept per order, see RequestData().
+  if (this->InvertOrder != newValue)
   {
     this->InvertOrder = newValue;
     this->Modified();
@@ -17,6 +17,11 @@
 #include "vtkPVVTKExtensionsFiltersRenderingModule.h" // needed for export macro
 #include "vtkSmartPointer.h"                          // for vtkSmartPointer
 #include "vtkTableAlgorithm.h"
+#include "vtkTimeStamp.h" // for vtkTimeStamp
+
+#include <map>     // for std::map
+#include <memory>  // for std::unique_ptr
+#include <string>  // for std::string
 #include <utility> // for std::pair
 
 class vtkDataArray;
@@ -33,7 +38,9 @@ private:
   class InternalsBase;
   template <class T>
   class Internals;
-  InternalsBase* Internal;
+  // Sort indices, keyed on the sorted column, component and order.
+  std::map<std::string, std::unique_ptr<InternalsBase>> SortIndices;
+  InternalsBase* Internal = nullptr;
 
 public:
   static void PrintInfo(vtkTable* input);
@@ -139,6 +146,13 @@ private:
 
   vtkSmartPointer<vtkTable> MergeBlocks(vtkPartitionedDataSet* cd);
 
+  // Input table merged from the partitions of the input, kept until the input
+  // changes.
+  vtkSmartPointer<vtkTable> MergedInput;
+  vtkPartitionedDataSet* MergedInputSource = nullptr;
+  bool MergedInputShowFieldData = false;
+  vtkTimeStamp MergedInputTime;
+
   /**
    * Add field data columns defined by block to the output table.
    */
@@ -7,19 +7,212 @@
 #include "vtkObjectFactory.h"
 #include "vtkUnsignedCharArray.h"
 #include <algorithm>
+#include <cassert>
 #include <sstream>
+#include <vector>
 
 vtkStandardNewMacro(vtkSquirtCompressor);
 
 //-----------------------------------------------------------------------------
 vtkSquirtCompressor::vtkSquirtCompressor()
   : SquirtLevel(3)
+  , NumberOfTiles(0)
 {
 }
 
 //-----------------------------------------------------------------------------
 vtkSquirtCompressor::~vtkSquirtCompressor() = default;
 
+namespace
+{
+//-----------------------------------------------------------------------------
+// Returns the number of leading pixels in `pixels` (at most 15, the longest
+// run SQUIRT can encode for RGBA) whose masked value equals `key`. When at
+// least 16 pixels are available, the comparison is done on a fixed-size block
+// without early exit so that the compiler can vectorize it.
+int ComputeRunRGBA(const unsigned int* pixels, vtkIdType available, unsigned int key,
+  unsigned int compress_mask)
+{
+  constexpr int maxRun = 0x0F;
+  if (available > maxRun)
+  {
+    unsigned int matches = 0;
+    for (int cc = 0; cc < maxRun + 1; ++cc)
+    {
+      matches |= static_cast<unsigned int>((pixels[cc] & compress_mask) == key) << cc;
+    }
+    // count trailing ones, i.e. the run of matching pixels.
+    const unsigned int mismatches = ~matches;
+#if defined(__GNUC__) || defined(__clang__)
+    const int run = __builtin_ctz(mismatches);
+#else
+    int run = 0;
+    while (((mismatches >> run) & 0x1) == 0)
+    {
+      ++run;
+    }
+#endif
+    return std::min(run, maxRun);
+  }
+
+  int run = 0;
+  while (run < available && run < maxRun && (pixels[run] & compress_mask) == key)
+  {
+    ++run;
+  }
+  return run;
+}
+
+//-----------------------------------------------------------------------------
+void CompressRGBA(const unsigned int* colors, vtkIdType numPixels, unsigned int compress_mask,
+  std::vector<unsigned char>& buffer)
+{
+  // worst case, each pixel is its own run.
+  buffer.resize(static_cast<size_t>(numPixels) * 4);
+  unsigned int* compressed = reinterpret_cast<unsigned int*>(buffer.data());
+
+  vtkIdType index = 0;
+  vtkIdType comp_index = 0;
+  while (index < numPixels)
+  {
+    // Record color
+    const unsigned int current_color = compressed[comp_index] = colors[index];
+    unsigned char opacity = *(((const unsigned char*)&current_color) + 3);
+    index++;
+
+    // Compute Run
+    int count = ComputeRunRGBA(
+      colors + index, numPixels - index, current_color & compress_mask, compress_mask);
+    index += count;
+    if (opacity > 0)
+    {
+      opacity /= 16; // since we want to encode 8-bit opacity into 4 bits.
+      opacity = opacity << 4;
+      count |= opacity;
+    }
+
+    // Record Run length
+    *((unsigned char*)compressed + comp_index * 4 + 3) = (unsigned char)count;
+    comp_index++;
+  }
+  buffer.resize(static_cast<size_t>(comp_index) * 4);
+}
+
+//-----------------------------------------------------------------------------
+void CompressRGB(const unsigned char* colors, vtkIdType numPixels, unsigned int compress_mask,
+  std::vector<unsigned char>& buffer)
+{
+  // worst case, each pixel is its own run.
+  buffer.resize(static_cast<size_t>(numPixels) * 4);
+  unsigned int* compressed = reinterpret_cast<unsigned int*>(buffer.data());
+
+  auto readColor = [colors](vtkIdType pixel)
+  {
+    unsigned int color = 0;
+    unsigned char* p = (unsigned char*)&color;
+    p[0] = colors[3 * pixel];
+    p[1] = colors[3 * pixel + 1];
+    p[2] = colors[3 * pixel + 2];
+    return color;
+  };
+
+  vtkIdType index = 0;
+  vtkIdType comp_index = 0;
+  while (index < numPixels)
+  {
+    // Record color
+    const unsigned int current_color = readColor(index);
+    compressed[comp_index] = current_color;
+    index++;
+
+    // Compute Run
+    int count = 0;
+    while (index < numPixels && count < 255 &&
+      (current_color & compress_mask) == (readColor(index) & compress_mask))
+    {
+      index++;
+      count++;
+    }
+
+    // Record Run length
+    reinterpret_cast<unsigned char*>(compressed)[comp_index * 4 + 3] =
+      static_cast<unsigned char>(count);
+    comp_index++;
+  }
+  buffer.resize(static_cast<size_t>(comp_index) * 4);
+}
+
+//-----------------------------------------------------------------------------
+bool DecompressRGBA(
+  const unsigned int* compressed, vtkIdType compSize, unsigned int* colors, vtkIdType numPixels)
+{
+  vtkIdType index = 0;
+
+  // Go through compress buffer and extract RLE format into color buffer
+  for (vtkIdType i = 0; i < compSize; i++)
+  {
+    // Get color and count
+    unsigned int current_color = compressed[i];
+
+    // Get run length count;
+    int count = *((unsigned char*)&current_color + 3);
+
+    if (count > 0x0f)
+    {
+      // we have some opacity.
+      unsigned char opacity = (count & 0xF0);
+      opacity = opacity >> 4;
+      opacity *= 16;
+      *((unsigned char*)&current_color + 3) = opacity;
+    }
+    else
+    {
+      *((unsigned char*)&current_color + 3) = 0;
+    }
+    count &= 0x0F;
+
+    if (index + count + 1 > numPixels)
+    {
+      return false;
+    }
+
+    // Blast color into color buffer
+    std::fill_n(colors + index, count + 1, current_color);
+    index += count + 1;
+  }
+  return index == numPixels;
+}
+
+//-----------------------------------------------------------------------------
+bool DecompressRGB(
+  const unsigned int* compressed, vtkIdType compSize, unsigned char* colors, vtkIdType numPixels)
+{
+  vtkIdType index = 0;
+
+  // Go through compress buffer and extract RLE format into color buffer
+  for (vtkIdType i = 0; i < compSize; i++)
+  {
+    // Get color and count
+    const unsigned int current_color = compressed[i];
+
+    // Get run length count;
+    const int count = *((const unsigned char*)&current_color + 3);
+    if (index + count + 1 > numPixels)
+    {
+      return false;
+    }
+
+    const unsigned char* current_color_rgb = reinterpret_cast<const unsigned char*>(&current_color);
+    for (int j = 0; j <= count; j++)
+    {
+      std::copy(current_color_rgb, current_color_rgb + 3, colors + 3 * index);
+      ++index;
+    }
+  }
+  return index == numPixels;
+}
+}
+
 //-----------------------------------------------------------------------------
 int vtkSquirtCompressor::Compress()
 {
@@ -37,12 +230,7 @@ int vtkSquirtCompressor::Compress()
     return VTK_ERROR;
   }
 
-  int count = 0;
-  int index = 0;
-  int comp_index = 0;
-  int end_index;
   int compress_level = this->LossLessMode ? 0 : this->SquirtLevel;
-  unsigned int current_color;
   unsigned char compress_masks[6][4] = { { 0xFF, 0xFF, 0xFF, 0xFF }, { 0xFE, 0xFF, 0xFE, 0xFE },
     { 0xFC, 0xFE, 0xFC, 0xFC }, { 0xF8, 0xFC, 0xF8, 0xF8 }, { 0xF0, 0xF8, 0xF0, 0xF0 },
     { 0xE0, 0xF0, 0xE0, 0xE0 } };
@@ -58,106 +246,30 @@ int vtkSquirtCompressor::Compress()
   // I shifted the level by one so that 0 means no compression.
   memcpy(&compress_mask, &compress_masks[compress_level], 4);
 
-  // Access raw arrays directly
+  // Each tile of the image is run-length encoded independently.
+  const vtkIdType numPixels = input->GetNumberOfTuples();
+  bool status;
   if (input->GetNumberOfComponents() == 4)
   {
-    unsigned int* _rawColorBuffer;
-    unsigned int* _rawCompressedBuffer;
-    int numPixels = input->GetNumberOfTuples();
-    _rawColorBuffer = (unsigned int*)input->GetPointer(0);
-    _rawCompressedBuffer = (unsigned int*)this->Output->WritePointer(0, numPixels * 4);
-    end_index = numPixels;
-
-    // Go through color buffer and put RLE format into compressed buffer
-    while ((index < end_index) && (comp_index < end_index))
-    {
-
-      // Record color
-      current_color = _rawCompressedBuffer[comp_index] = _rawColorBuffer[index];
-      unsigned char opacity = *(((unsigned char*)&current_color) + 3);
-      index++;
-
-      // Compute Run
-      while ((index < end_index) && (count < 0x0F) &&
-        ((current_color & compress_mask) == (_rawColorBuffer[index] & compress_mask)))
-      {
-        index++;
-        count++;
-      }
-      if (opacity > 0)
+    const unsigned int* colors = reinterpret_cast<const unsigned int*>(input->GetPointer(0));
+    status = this->CompressTiles(numPixels, this->NumberOfTiles,
+      [&](vtkIdType begin, vtkIdType end, std::vector<unsigned char>& buffer)
       {
-        opacity /= 16; // since we want to encode 8-bit opacity into 4 bits.
-        opacity = opacity << 4;
-        count |= opacity;
-      }
-
-      // Record Run length
-      *((unsigned char*)_rawCompressedBuffer + comp_index * 4 + 3) = (unsigned char)count;
-      comp_index++;
-
-      count = 0;
-    }
+        ::CompressRGBA(colors + begin, end - begin, compress_mask, buffer);
+        return true;
+      });
   }
-  else if (input->GetNumberOfComponents() == 3)
+  else
   {
-    unsigned char* _rawColorBuffer;
-    unsigned int* _rawCompressedBuffer;
-    int numPixels = input->GetNumberOfTuples();
-    _rawColorBuffer = (unsigned char*)input->GetPointer(0);
-    _rawCompressedBuffer = (unsigned int*)this->Output->WritePointer(0, numPixels * 4);
-    end_index = numPixels;
-
-    // Go through color buffer and put RLE format into compressed buffer
-    while ((index < 3 * numPixels) && (comp_index < end_index))
-    {
-
-      int next_color = 0;
-      // Record color
-      unsigned char* p = (unsigned char*)&current_color;
-      *p++ = _rawColorBuffer[index];
-      *p++ = _rawColorBuffer[index + 1];
-      *p++ = _rawColorBuffer[index + 2];
-      *p = 0x0;
-
-      _rawCompressedBuffer[comp_index] = current_color;
-      index += 3;
-
-      p = (unsigned char*)&next_color;
-      *p++ = _rawColorBuffer[index];
-      *p++ = _rawColorBuffer[index + 1];
-      *p++ = _rawColorBuffer[index + 2];
-      *p = 0x0;
-
-      // Compute Run
-      while (((current_color & compress_mask) == (next_color & compress_mask)) &&
-        (index < 3 * numPixels) && (count < 255))
+    const unsigned char* colors = input->GetPointer(0);
+    status = this->CompressTiles(numPixels, this->NumberOfTiles,
+      [&](vtkIdType begin, vtkIdType end, std::vector<unsigned char>& buffer)
       {
-        index += 3;
-        count++;
-        if (index < 3 * numPixels)
-        {
-          p = (unsigned char*)&next_color;
-          *p++ = _rawColorBuffer[index];
-          *p++ = _rawColorBuffer[index + 1];
-          *p++ = _rawColorBuffer[index + 2];
-          *p = 0x0;
-        }
-      }
-
-      // Record Run length
-      reinterpret_cast<unsigned char*>(_rawCompressedBuffer)[comp_index * 4 + 3] =
-        static_cast<unsigned char>(count);
-      comp_index++;
-
-      count = 0;
-    }
+        ::CompressRGB(colors + 3 * begin, end - begin, compress_mask, buffer);
+        return true;
+      });
   }
-
-  // Back to vtk arrays :)
-  this->Output->SetNumberOfComponents(1);
-  this->Output->SetNumberOfTuples(4 * comp_index);
-
-  return VTK_OK;
+  return status ? VTK_OK : VTK_ERROR;
 }
 
 //-----------------------------------------------------------------------------
@@ -189,107 +301,48 @@ int vtkSquirtCompressor::Decompress()
 //-----------------------------------------------------------------------------
 int vtkSquirtCompressor::DecompressRGBA()
 {
-  vtkUnsignedCharArray* in = this->GetInput();
   vtkUnsignedCharArray* out = this->GetOutput();
   assert(out->GetNumberOfComponents() == 4);
 
-  int count = 0;
-  int index = 0;
-  unsigned int current_color;
-  unsigned int* _rawColorBuffer;
-  unsigned int* _rawCompressedBuffer;
-
-  // Get compressed buffer size
-  int CompSize = in->GetNumberOfTuples() / 4; /// NOTE 1->4
-
-  // Access raw arrays directly
-  _rawColorBuffer = (unsigned int*)out->GetPointer(0);
-  _rawCompressedBuffer = (unsigned int*)in->GetPointer(0);
-
-  // Go through compress buffer and extract RLE format into color buffer
-  for (int i = 0; i < CompSize; i++)
-  {
-    // Get color and count
-    current_color = _rawCompressedBuffer[i];
-
-    // Get run length count;
-    count = *((unsigned char*)&current_color + 3);
-
-    if (count > 0x0f)
-    {
-      // we have some opacity.
-      unsigned char opacity = (count & 0xF0);
-      opacity = opacity >> 4;
-      opacity *= 16;
-      *((unsigned char*)&current_color + 3) = opacity;
-    }
-    else
-    {
-      *((unsigned char*)&current_color + 3) = 0;
-    }
-    count &= 0x0F;
-
-    // Set color
-    _rawColorBuffer[index++] = current_color;
-
-    // Blast color into color buffer
-    for (int j = 0; j < count; j++)
+  unsigned int* colors = reinterpret_cast<unsigned int*>(out->GetPointer(0));
+  const bool status = this->DecompressTiles(out->GetNumberOfTuples(),
+    [&](const unsigned char* data, size_t size, vtkIdType begin, vtkIdType end)
     {
-      _rawColorBuffer[index++] = current_color;
-    }
+      return ::DecompressRGBA(reinterpret_cast<const unsigned int*>(data),
+        static_cast<vtkIdType>(size / 4), colors + begin, end - begin);
+    });
+  if (!status)
+  {
+    vtkErrorMacro("Invalid SQUIRT compressed data.");
   }
-  return VTK_OK;
+  return status ? VTK_OK : VTK_ERROR;
 }
 
 //-----------------------------------------------------------------------------
 int vtkSquirtCompressor::DecompressRGB()
 {
-  vtkUnsignedCharArray* in = this->GetInput();
   vtkUnsignedCharArray* out = this->GetOutput();
   assert(out->GetNumberOfComponents() == 3);
 
-  int count = 0;
-  unsigned int current_color;
-  unsigned char* _rawColorBuffer;
-  unsigned int* _rawCompressedBuffer;
-
-  // Get compressed buffer size
-  int CompSize = in->GetNumberOfTuples() / 4; /// NOTE 1->4
-
-  // Access raw arrays directly
-  _rawColorBuffer = (unsigned char*)out->GetPointer(0);
-  _rawCompressedBuffer = (unsigned int*)in->GetPointer(0);
-
-  // Go through compress buffer and extract RLE format into color buffer
-  for (int i = 0; i < CompSize; i++)
-  {
-    // Get color and count
-    current_color = _rawCompressedBuffer[i];
-
-    // Get run length count;
-    count = *((unsigned char*)&current_color + 3);
-
-    *((unsigned char*)&current_color + 3) = 0xff;
-
-    unsigned char current_color_rgb[3];
-    std::copy(reinterpret_cast<const unsigned char*>(&current_color),
-      reinterpret_cast<const unsigned char*>(&current_color) + 3, current_color_rgb);
-    std::copy(current_color_rgb, current_color_rgb + 3, _rawColorBuffer);
-    _rawColorBuffer += 3;
-    for (int j = 0; j < count; j++)
+  unsigned char* colors = out->GetPointer(0);
+  const bool status = this->DecompressTiles(out->GetNumberOfTuples(),
+    [&](const unsigned char* data, size_t size, vtkIdType begin, vtkIdType end)
     {
-      std::copy(current_color_rgb, current_color_rgb + 3, _rawColorBuffer);
-      _rawColorBuffer += 3;
-    }
+      return ::DecompressRGB(reinterpret_cast<const unsigned int*>(data),
+        static_cast<vtkIdType>(size / 4), colors + 3 * begin, end - begin);
+    });
+  if (!status)
+  {
+    vtkErrorMacro("Invalid SQUIRT compressed data.");
   }
-  return VTK_OK;
+  return status ? VTK_OK : VTK_ERROR;
 }
 
 //-----------------------------------------------------------------------------
 void vtkSquirtCompressor::SaveConfiguration(vtkMultiProcessStream* stream)
 {
   vtkImageCompressor::SaveConfiguration(stream);
-  *stream << this->SquirtLevel;
+  *stream << this->SquirtLevel << this->NumberOfTiles;
 }
 
 //-----------------------------------------------------------------------------
@@ -297,7 +350,9 @@ bool vtkSquirtCompressor::RestoreConfiguration(vtkMultiProcessStream* stream)
 {
   if (vtkImageCompressor::RestoreConfiguration(stream))
   {
-    *stream >> this->SquirtLevel;
+    int numberOfTiles;
+    *stream >> this->SquirtLevel >> numberOfTiles;
+    this->SetNumberOfTiles(numberOfTiles);
     return true;
   }
   return false;
@@ -307,7 +362,8 @@ bool vtkSquirtCompressor::RestoreConfiguration(vtkMultiProcessStream* stream)
 const char* vtkSquirtCompressor::SaveConfiguration()
 {
   std::ostringstream oss;
-  oss << vtkImageCompressor::SaveConfiguration() << " " << this->SquirtLevel;
+  oss << vtkImageCompressor::SaveConfiguration() << " " << this->SquirtLevel << " "
+      << this->NumberOfTiles;
 
   this->SetConfiguration(oss.str().c_str());
 
@@ -322,6 +378,14 @@ const char* vtkSquirtCompressor::RestoreConfiguration(const char* stream)
   {
     std::istringstream iss(stream);
     iss >> this->SquirtLevel;
+    // the number of tiles is optional, defaulting to automatic.
+    int numberOfTiles = 0;
+    if (!(iss >> numberOfTiles))
+    {
+      numberOfTiles = 0;
+      iss.clear();
+    }
+    this->SetNumberOfTiles(numberOfTiles);
     return stream + iss.tellg();
   }
   return nullptr;
@@ -332,4 +396,5 @@ void vtkSquirtCompressor::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
   os << indent << "SquirtLevel: " << this->SquirtLevel << endl;
+  os << indent << "NumberOfTiles: " << this->NumberOfTiles << endl;
 }
@@ -58,6 +58,18 @@ public:
   vtkGetMacro(SquirtLevel, int);
   ///@}
 
+  ///@{
+  /**
+   * Set the number of tiles the image is split into. Tiles are compressed and
+   * decompressed independently, in parallel. 0 (default) picks the number of
+   * tiles based on the image size and the number of available threads.
+   * The number of tiles is an optional trailing value in the configuration
+   * string.
+   */
+  vtkSetClampMacro(NumberOfTiles, int, 0, 256);
+  vtkGetMacro(NumberOfTiles, int);
+  ///@}
+
   ///@{
   /**
    * Compress/Decompress data array on the objects input with results
@@ -85,6 +97,7 @@ protected:
   int DecompressRGBA();
 
   int SquirtLevel;
+  int NumberOfTiles;
 
 private:
   vtkSquirtCompressor(const vtkSquirtCompressor&) = delete;
@@ -21,7 +21,7 @@ namespace
 
 // ensure that the writer works when the columns are not in the same order on all ranks.
 // also ensures partial arrays don't mess things up.
-bool WriteCSV(const std::string& fname, int rank)
+bool WriteCSV(const std::string& fname, int rank, bool writeInParallel)
 {
   vtkNew<vtkTable> table;
   vtkNew<vtkDoubleArray> col1;
@@ -67,6 +67,7 @@ bool WriteCSV(const std::string& fname, int rank)
   vtkNew<vtkCSVWriter> writer;
   writer->SetFileName(fname.c_str());
   writer->SetInputDataObject(table);
+  writer->SetWriteInParallel(writeInParallel);
   writer->Update();
   return true;
 }
@@ -137,11 +138,17 @@ extern int TestCSVWriter(int argc, char* argv[])
   }
 
   std::string tname{ testing->GetTempDirectory() };
-  int success = WriteCSV(tname + "/TestCSVWriter.csv", myRank) &&
+  int success = WriteCSV(tname + "/TestCSVWriter.csv", myRank, false) &&
       ReadAndVerifyCSV(tname + "/TestCSVWriter.csv", myRank, numRanks)
     ? 1
     : 0;
 
+  // each rank writes its rows to the shared file directly.
+  success = success && WriteCSV(tname + "/TestCSVWriterParallel.csv", myRank, true) &&
+      ReadAndVerifyCSV(tname + "/TestCSVWriterParallel.csv", myRank, numRanks)
+    ? 1
+    : 0;
+
   int all_success;
   contr->AllReduce(&success, &all_success, 1, vtkCommunicator::LOGICAL_AND_OP);
 
@@ -0,0 +1,197 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkAppendPolyData.h"
+#include "vtkClientServerInterpreter.h"
+#include "vtkClientServerInterpreterInitializer.h"
+#include "vtkClientServerStream.h"
+#include "vtkCommand.h"
+#include "vtkLogger.h"
+#include "vtkMPIController.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkParallelSerialWriter.h"
+#include "vtkPolyData.h"
+#include "vtkSphereSource.h"
+#include "vtkTestUtilities.h"
+#include "vtkXMLPolyDataReader.h"
+#include "vtkXMLPolyDataWriter.h"
+
+#include <cstring>
+#include <string>
+#include <thread>
+
+#define VERIFY(x, y)                                                                               \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    vtkLogF(ERROR, y);                                                                             \
+    return false;                                                                                  \
+  }
+
+namespace
+{
+// Internal writer recording whether it reported progress or errors on a
+// thread other than the one that created it.
+class vtkTestSerialWriter : public vtkXMLPolyDataWriter
+{
+public:
+  static vtkTestSerialWriter* New();
+  vtkTypeMacro(vtkTestSerialWriter, vtkXMLPolyDataWriter);
+
+  std::thread::id CallingThread = std::this_thread::get_id();
+  bool EventOffCallingThread = false;
+
+  void OnEvent(vtkObject*, unsigned long, void*)
+  {
+    if (std::this_thread::get_id() != this->CallingThread)
+    {
+      this->EventOffCallingThread = true;
+    }
+  }
+
+protected:
+  vtkTestSerialWriter()
+  {
+    this->AddObserver(vtkCommand::ProgressEvent, this, &vtkTestSerialWriter::OnEvent);
+    this->AddObserver(vtkCommand::ErrorEvent, this, &vtkTestSerialWriter::OnEvent);
+  }
+};
+vtkStandardNewMacro(vtkTestSerialWriter);
+
+// The test does not load the client/server wrappings, hence provide the two
+// methods vtkParallelSerialWriter invokes on its internal writer.
+int vtkTestSerialWriterCommand(vtkClientServerInterpreter*, vtkObjectBase* ptr, const char* method,
+  const vtkClientServerStream& msg, vtkClientServerStream& result, void*)
+{
+  auto writer = vtkTestSerialWriter::SafeDownCast(ptr);
+  char* fileName = nullptr;
+  if (writer && strcmp(method, "SetFileName") == 0 && msg.GetArgument(0, 2, &fileName))
+  {
+    writer->SetFileName(fileName);
+    result.Reset();
+    return 1;
+  }
+  if (writer && strcmp(method, "Write") == 0)
+  {
+    const int status = writer->Write();
+    result.Reset();
+    result << vtkClientServerStream::Reply << status << vtkClientServerStream::End;
+    return 1;
+  }
+  result.Reset();
+  result << vtkClientServerStream::Error << "Unexpected method." << vtkClientServerStream::End;
+  return 0;
+}
+
+void RegisterTestSerialWriter(vtkClientServerInterpreter* interpreter)
+{
+  interpreter->AddCommandFunction("vtkTestSerialWriter", vtkTestSerialWriterCommand);
+}
+
+// Records the errors vtkParallelSerialWriter reports and the thread reporting
+// them.
+struct ErrorObserver
+{
+  std::thread::id CallingThread = std::this_thread::get_id();
+  int NumberOfErrors = 0;
+  bool ErrorOffCallingThread = false;
+
+  void OnError(vtkObject*, unsigned long, void*)
+  {
+    ++this->NumberOfErrors;
+    if (std::this_thread::get_id() != this->CallingThread)
+    {
+      this->ErrorOffCallingThread = true;
+    }
+  }
+};
+
+bool TestWrite(vtkMultiProcessController* controller, const std::string& tempDir, bool async)
+{
+  const int rank = controller->GetLocalProcessId();
+  const int numRanks = controller->GetNumberOfProcesses();
+
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(8 * numRanks);
+  vtkNew<vtkAppendPolyData> append;
+  vtkNew<vtkTestSerialWriter> internalWriter;
+
+  vtkNew<vtkParallelSerialWriter> writer;
+  writer->SetInputConnection(sphere->GetOutputPort());
+  writer->SetController(controller);
+  writer->SetWriter(internalWriter);
+  writer->SetFileNameMethod("SetFileName");
+  writer->SetPostGatherHelper(append);
+  writer->SetPiece(rank);
+  writer->SetNumberOfPieces(numRanks);
+  writer->SetWriteAsynchronously(async);
+  ErrorObserver errors;
+  writer->AddObserver(vtkCommand::ErrorEvent, &errors, &ErrorObserver::OnError);
+
+  // write two files in a row: with async on, the second write waits for the
+  // first one.
+  const std::string prefix =
+    tempDir + "/TestParallelSerialWriter" + (async ? "Async" : "") + std::to_string(numRanks);
+  for (const char* suffix : { "-0.vtp", "-1.vtp" })
+  {
+    writer->SetFileName((prefix + suffix).c_str());
+    writer->Write();
+  }
+  VERIFY(writer->WaitForPendingWrite(), "The last write failed.");
+  VERIFY(!internalWriter->EventOffCallingThread, "Internal writer reported events off-thread.");
+  VERIFY(errors.NumberOfErrors == 0, "Unexpected error.");
+
+  // count the points of all pieces.
+  sphere->UpdatePiece(rank, numRanks, 0);
+  int localPoints = static_cast<int>(sphere->GetOutput()->GetNumberOfPoints());
+  int totalPoints = 0;
+  controller->Reduce(&localPoints, &totalPoints, 1, vtkCommunicator::SUM_OP, 0);
+  if (rank == 0)
+  {
+    for (const char* suffix : { "-0.vtp", "-1.vtp" })
+    {
+      vtkNew<vtkXMLPolyDataReader> reader;
+      reader->SetFileName((prefix + suffix).c_str());
+      reader->Update();
+      VERIFY(reader->GetOutput()->GetNumberOfPoints() == totalPoints,
+        "The pieces of some ranks were not written.");
+    }
+  }
+
+  // failures of the internal writer are reported by vtkParallelSerialWriter on
+  // the calling thread.
+  writer->SetFileName((tempDir + "/missing-directory/TestParallelSerialWriter.vtp").c_str());
+  writer->Write();
+  const bool success = writer->WaitForPendingWrite();
+  VERIFY(!internalWriter->EventOffCallingThread, "Internal writer reported errors off-thread.");
+  VERIFY(!errors.ErrorOffCallingThread, "Errors were reported off the calling thread.");
+  if (rank == 0)
+  {
+    VERIFY(async ? !success : success, "Unexpected status for the failed write.");
+    VERIFY(errors.NumberOfErrors > 0 || !async, "The failed write was not reported.");
+  }
+  return true;
+}
+}
+
+int TestParallelSerialWriter(int argc, char* argv[])
+{
+  vtkNew<vtkMPIController> controller;
+  controller->Initialize(&argc, &argv);
+  vtkMultiProcessController::SetGlobalController(controller);
+  vtkClientServerInterpreterInitializer::GetInitializer()->RegisterCallback(
+    ::RegisterTestSerialWriter);
+
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  const std::string tempDirectory = tempDir;
+  delete[] tempDir;
+
+  int success = ::TestWrite(controller, tempDirectory, false) ? 1 : 0;
+  success = ::TestWrite(controller, tempDirectory, true) && success ? 1 : 0;
+
+  int allSuccess = 0;
+  controller->AllReduce(&success, &allSuccess, 1, vtkCommunicator::LOGICAL_AND_OP);
+  vtkMultiProcessController::SetGlobalController(nullptr);
+  controller->Finalize();
+  return allSuccess ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -15,11 +15,14 @@
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMultiProcessController.h"
+#include "vtkMultiProcessStream.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPVMergeTables.h"
 #include "vtkPointData.h"
 #include "vtkPointSet.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStringArray.h"
@@ -29,9 +32,14 @@
 #include "vtksys/FStream.hxx"
 #include "vtksys/SystemTools.hxx"
 
+#include <algorithm>
 #include <iostream>
+#include <iterator>
+#include <memory>
+#include <numeric>
 #include <regex>
 #include <sstream>
+#include <type_traits>
 #include <vector>
 
 //-----------------------------------------------------------------------------
@@ -208,9 +216,41 @@ int vtkCSVWriter::ProcessRequest(
 
 namespace
 {
+/**
+ * Appends a value to the buffer. Floating point values are formatted as an
+ * iostream would with the writer's precision and notation, but without the
+ * overhead of the stream.
+ */
+template <typename ValueType>
+void AppendValue(std::string& buffer, ValueType value, vtkCSVWriter* writer)
+{
+  auto out = std::back_inserter(buffer);
+  if constexpr (std::is_floating_point<ValueType>::value)
+  {
+    if (writer->GetUseScientificNotation())
+    {
+      vtk::format_to(out, "{:.{}e}", value, writer->GetPrecision());
+    }
+    else
+    {
+      vtk::format_to(out, "{:.{}g}", value, writer->GetPrecision());
+    }
+  }
+  else if constexpr (sizeof(ValueType) == 1)
+  {
+    // enforce numeric values for char types.
+    vtk::format_to(out, "{}", static_cast<int>(value));
+  }
+  else
+  {
+    vtk::format_to(out, "{}", value);
+  }
+}
+
 /**
  * Worker interface, so we can store pointers of concrete subclasses in a generic container.
- * The operator() should write the array value at given index into the stream.
+ * The operator() should append the array value at given index to the buffer. It
+ * may be called concurrently from several threads.
  */
 struct AbstractStreamWorker
 {
@@ -221,7 +261,7 @@ struct AbstractStreamWorker
 
   virtual ~AbstractStreamWorker() = default;
 
-  virtual void operator()(ostream& stream, vtkCSVWriter* writer, vtkIdType index) = 0;
+  virtual void operator()(std::string& buffer, vtkCSVWriter* writer, vtkIdType index) = 0;
   vtkIdType NumberOfComponents;
 };
 
@@ -237,9 +277,9 @@ struct DataToStreamWorker : public AbstractStreamWorker
     this->Range = vtk::DataArrayValueRange(array);
   }
 
-  void operator()(ostream& stream, vtkCSVWriter* vtkNotUsed(writer), vtkIdType index) override
+  void operator()(std::string& buffer, vtkCSVWriter* writer, vtkIdType index) override
   {
-    stream << this->Range[index];
+    ::AppendValue(buffer, static_cast<vtk::GetAPIType<ArrayT>>(this->Range[index]), writer);
   }
 
 private:
@@ -260,60 +300,14 @@ struct DataToStreamWorker<vtkStringArray> : public AbstractStreamWorker
   {
   }
 
-  void operator()(ostream& stream, vtkCSVWriter* writer, vtkIdType index) override
+  void operator()(std::string& buffer, vtkCSVWriter* writer, vtkIdType index) override
   {
-    stream << writer->GetString(this->Array->GetValue(index));
+    buffer += writer->GetString(this->Array->GetValue(index));
   }
 
   vtkStringArray* Array;
 };
 
-/**
- * vtkCharArray specialization to enforce numeric values.
- */
-template <>
-struct DataToStreamWorker<vtkAOSDataArrayTemplate<char>> : public AbstractStreamWorker
-{
-  DataToStreamWorker(vtkAOSDataArrayTemplate<char>* array)
-    : AbstractStreamWorker(array)
-  {
-    this->Range = vtk::DataArrayValueRange(array);
-  }
-
-  void operator()(ostream& stream, vtkCSVWriter* vtkNotUsed(writer), vtkIdType index) override
-  {
-    stream << static_cast<int>(this->Range[index]);
-  }
-
-private:
-  using RangeType = typename vtk::detail::SelectValueRange<vtkAOSDataArrayTemplate<char>,
-    vtk::detail::DynamicTupleSize>::type;
-  RangeType Range;
-};
-
-/**
- * vtkUnsignedCharArray specialization to enforce numeric values.
- */
-template <>
-struct DataToStreamWorker<vtkAOSDataArrayTemplate<unsigned char>> : public AbstractStreamWorker
-{
-  DataToStreamWorker(vtkAOSDataArrayTemplate<unsigned char>* array)
-    : AbstractStreamWorker(array)
-  {
-    this->Range = vtk::DataArrayValueRange(array);
-  }
-
-  void operator()(ostream& stream, vtkCSVWriter* vtkNotUsed(writer), vtkIdType index) override
-  {
-    stream << static_cast<int>(this->Range[index]);
-  }
-
-private:
-  using RangeType = typename vtk::detail::SelectValueRange<vtkAOSDataArrayTemplate<unsigned char>,
-    vtk::detail::DynamicTupleSize>::type;
-  RangeType Range;
-};
-
 /**
  * Worker dedicated to construct the correct type of workers. Instead
  * of dispatching every row, this pattern enables us to dispatch
@@ -330,6 +324,11 @@ struct WorkerCreator
   }
 };
 
+// Rows are formatted in chunks of this size, each chunk by a single thread.
+constexpr vtkIdType ROWS_PER_CHUNK = 4096;
+// Number of chunks formatted before they are written, to bound memory usage.
+constexpr vtkIdType CHUNKS_PER_BATCH = 256;
+
 } // end anonymous namespace
 
 class vtkCSVWriter::CSVFile
@@ -381,70 +380,74 @@ public:
 
   void WriteHeader(vtkDataSetAttributes* dsa, vtkCSVWriter* self, OpenMode mode)
   {
+    this->SetColumns(dsa);
     if (OpenMode::Write == mode)
     {
-      bool add_delimiter = false;
-      if (this->TimeStep >= 0)
+      this->Stream << this->FormatHeader(self);
+    }
+  }
+
+  /**
+   * Save the order of arrays to write out.
+   */
+  void SetColumns(vtkDataSetAttributes* dsa)
+  {
+    this->ColumnInfo.clear();
+    for (int cc = 0, numArrays = dsa->GetNumberOfArrays(); cc < numArrays; ++cc)
+    {
+      auto array = dsa->GetAbstractArray(cc);
+      this->ColumnInfo.emplace_back(array->GetName(), array->GetNumberOfComponents());
+    }
+  }
+
+  void SetColumns(const std::vector<std::pair<std::string, int>>& columns)
+  {
+    this->ColumnInfo = columns;
+  }
+
+  const std::vector<std::pair<std::string, int>>& GetColumns() const { return this->ColumnInfo; }
+
+  std::string FormatHeader(vtkCSVWriter* self)
+  {
+    std::string header;
+    bool add_delimiter = false;
+    if (this->TimeStep >= 0)
+    {
+      header += self->GetString("TimeStep");
+      add_delimiter = true;
+    }
+    if (!vtkMath::IsNan(this->Time))
+    {
+      if (add_delimiter)
       {
-        this->Stream << self->GetString("TimeStep");
-        add_delimiter = true;
+        // add separator for all but the very first column
+        header += self->GetFieldDelimiter();
       }
-      if (!vtkMath::IsNan(this->Time))
+      // add a time column.
+      header += self->GetString("Time");
+      add_delimiter = true;
+    }
+    for (const auto& cinfo : this->ColumnInfo)
+    {
+      for (int comp = 0; comp < cinfo.second; ++comp)
       {
         if (add_delimiter)
         {
           // add separator for all but the very first column
-          this->Stream << self->GetFieldDelimiter();
+          header += self->GetFieldDelimiter();
         }
-        // add a time column.
-        this->Stream << self->GetString("Time");
         add_delimiter = true;
-      }
-      for (int cc = 0, numArrays = dsa->GetNumberOfArrays(); cc < numArrays; ++cc)
-      {
-        auto array = dsa->GetAbstractArray(cc);
-        const int num_comps = array->GetNumberOfComponents();
 
-        // save order of arrays written out in header
-        this->ColumnInfo.emplace_back(array->GetName(), num_comps);
-
-        for (int comp = 0; comp < num_comps; ++comp)
+        std::string array_name = cinfo.first;
+        if (cinfo.second > 1)
         {
-          if (add_delimiter)
-          {
-            // add separator for all but the very first column
-            this->Stream << self->GetFieldDelimiter();
-          }
-          add_delimiter = true;
-
-          std::ostringstream array_name;
-          array_name << array->GetName();
-          if (array->GetNumberOfComponents() > 1)
-          {
-            array_name << ":" << comp;
-          }
-          this->Stream << self->GetString(array_name.str());
+          array_name += ":" + vtk::to_string(comp);
         }
+        header += self->GetString(array_name);
       }
-      this->Stream << "\n";
     }
-    else // (OpenMode::Append == mode)
-    {
-      for (int cc = 0, numArrays = dsa->GetNumberOfArrays(); cc < numArrays; ++cc)
-      {
-        auto array = dsa->GetAbstractArray(cc);
-        const int num_comps = array->GetNumberOfComponents();
-
-        // save order of arrays written out in header
-        this->ColumnInfo.emplace_back(array->GetName(), num_comps);
-      }
-    }
-    // push the floating point precision/notation type.
-    if (self->GetUseScientificNotation())
-    {
-      this->Stream << std::scientific;
-    }
-    this->Stream << std::setprecision(self->GetPrecision());
+    header += "\n";
+    return header;
   }
 
   void InitializeStreamWorkers(vtkDataSetAttributes* dsa, vtkCSVWriter* self)
@@ -494,23 +497,83 @@ public:
 
   void WriteData(vtkDataSetAttributes* dsa, vtkCSVWriter* self)
   {
-    const auto numTuples = dsa->GetNumberOfTuples();
-    for (vtkIdType tupleIndex = 0; tupleIndex < numTuples; ++tupleIndex)
+    this->FormatData(dsa, self,
+      [this](const std::string& chunk) { this->Stream.write(chunk.data(), chunk.size()); });
+  }
+
+  /**
+   * Returns the number of batches FormatBatch() splits `numTuples` rows in.
+   */
+  static vtkIdType GetNumberOfBatches(vtkIdType numTuples)
+  {
+    const vtkIdType rowsPerBatch = ::ROWS_PER_CHUNK * ::CHUNKS_PER_BATCH;
+    return (numTuples + rowsPerBatch - 1) / rowsPerBatch;
+  }
+
+  /**
+   * Formats the rows of the dataset attributes, using the workers initialized
+   * with InitializeStreamWorkers(). Chunks of rows are formatted in parallel and
+   * passed to `sink` in order.
+   */
+  template <typename SinkT>
+  void FormatData(vtkDataSetAttributes* dsa, vtkCSVWriter* self, SinkT&& sink)
+  {
+    for (vtkIdType batch = 0, max = GetNumberOfBatches(dsa->GetNumberOfTuples()); batch < max;
+         ++batch)
+    {
+      this->FormatBatch(dsa, self, batch, sink);
+    }
+  }
+
+  /**
+   * Formats the rows of the `batch`-th batch of rows only, see FormatData().
+   */
+  template <typename SinkT>
+  void FormatBatch(vtkDataSetAttributes* dsa, vtkCSVWriter* self, vtkIdType batch, SinkT&& sink)
+  {
+    const vtkIdType numTuples = dsa->GetNumberOfTuples();
+    const vtkIdType rowsPerBatch = ::ROWS_PER_CHUNK * ::CHUNKS_PER_BATCH;
+    const vtkIdType batchBegin = batch * rowsPerBatch;
+    const vtkIdType batchEnd = std::min(numTuples, batchBegin + rowsPerBatch);
+    const vtkIdType numChunks = (batchEnd - batchBegin + ::ROWS_PER_CHUNK - 1) / ::ROWS_PER_CHUNK;
+    std::vector<std::string> chunks(numChunks);
+    vtkSMPTools::For(0, numChunks,
+      [&](vtkIdType first, vtkIdType last)
+      {
+        for (vtkIdType chunk = first; chunk < last; ++chunk)
+        {
+          const vtkIdType begin = batchBegin + chunk * ::ROWS_PER_CHUNK;
+          const vtkIdType end = std::min(batchEnd, begin + ::ROWS_PER_CHUNK);
+          this->FormatRows(begin, end, numTuples, self, chunks[chunk]);
+        }
+      });
+    for (vtkIdType chunk = 0; chunk < numChunks; ++chunk)
+    {
+      sink(chunks[chunk]);
+    }
+  }
+
+private:
+  void FormatRows(
+    vtkIdType begin, vtkIdType end, vtkIdType numTuples, vtkCSVWriter* self, std::string& buffer)
+  {
+    const char* delimiter = self->GetFieldDelimiter();
+    for (vtkIdType tupleIndex = begin; tupleIndex < end; ++tupleIndex)
     {
       bool firstColumn = true;
       if (this->TimeStep >= 0)
       {
-        this->Stream << this->TimeStep;
+        ::AppendValue(buffer, this->TimeStep, self);
         firstColumn = false;
       }
       if (!vtkMath::IsNan(this->Time))
       {
         if (!firstColumn)
         {
-          this->Stream << self->GetFieldDelimiter();
+          buffer += delimiter;
         }
         // add a time column.
-        this->Stream << this->Time;
+        ::AppendValue(buffer, this->Time, self);
         firstColumn = false;
       }
 
@@ -522,20 +585,19 @@ public:
         {
           if (!firstColumn)
           {
-            this->Stream << self->GetFieldDelimiter();
+            buffer += delimiter;
           }
           firstColumn = false;
           if ((index + component) < numComps * numTuples)
           {
-            (*columnWorker)(this->Stream, self, index + component);
+            (*columnWorker)(buffer, self, index + component);
           }
         }
       }
-      this->Stream << "\n";
+      buffer += "\n";
     }
   }
 
-private:
   CSVFile(const CSVFile&) = delete;
   void operator=(const CSVFile&) = delete;
 };
@@ -671,6 +733,13 @@ bool vtkCSVWriter::WriteDataAndReturn()
     return ret;
   }
 
+  if (this->WriteInParallel)
+  {
+    const bool append =
+      this->WriteAllTimeSteps && !this->WriteAllTimeStepsSeparately && this->CurrentTimeIndex > 0;
+    return this->WriteSharedFile(table, filename.str(), timeStep, time, append);
+  }
+
   const int myRank = controller->GetLocalProcessId();
   const int numRanks = controller->GetNumberOfProcesses();
   if (myRank > 0)
@@ -793,6 +862,166 @@ bool vtkCSVWriter::WriteDataAndReturn()
   return true;
 }
 
+//-----------------------------------------------------------------------------
+bool vtkCSVWriter::WriteSharedFile(
+  vtkTable* table, const std::string& filename, int timeStep, double time, bool append)
+{
+  auto controller = this->Controller;
+  const int myRank = controller->GetLocalProcessId();
+  const int numRanks = controller->GetNumberOfProcesses();
+
+  const vtkIdType row_count = table->GetNumberOfRows();
+  std::vector<vtkIdType> global_row_counts(numRanks, 0);
+  controller->AllGather(&row_count, global_row_counts.data(), 1);
+
+  // the root determines which columns to write from the ranks that have rows
+  // and shares them with all ranks.
+  vtkMultiProcessStream columnsStream;
+  if (myRank == 0)
+  {
+    vtkDataSetAttributes::FieldList columns;
+    for (int rank = 0; rank < numRanks; ++rank)
+    {
+      if (global_row_counts[rank] > 0)
+      {
+        if (rank == 0)
+        {
+          columns.IntersectFieldList(table->GetRowData());
+        }
+        else
+        {
+          vtkNew<vtkTable> emptytable;
+          controller->Receive(emptytable, rank, 88020);
+          columns.IntersectFieldList(emptytable->GetRowData());
+        }
+      }
+    }
+    vtkNew<vtkDataSetAttributes> tmp;
+    tmp->CopyAllOn();
+    columns.CopyAllocate(tmp, vtkDataSetAttributes::PASSDATA, /*sz=*/1, 0);
+
+    CSVFile columnsFile(timeStep, time);
+    columnsFile.SetColumns(tmp);
+    columnsStream << static_cast<int>(columnsFile.GetColumns().size());
+    for (const auto& cinfo : columnsFile.GetColumns())
+    {
+      columnsStream << cinfo.first << cinfo.second;
+    }
+  }
+  else if (row_count > 0)
+  {
+    vtkNew<vtkTable> clone;
+    auto cloneRD = clone->GetRowData();
+    cloneRD->CopyAllOn();
+    cloneRD->CopyAllocate(table->GetRowData(), /*sze=*/1);
+    cloneRD->CopyData(table->GetRowData(), 0, 1, 0);
+    controller->Send(clone, 0, 88020);
+  }
+  controller->Broadcast(columnsStream, 0);
+
+  std::vector<std::pair<std::string, int>> columns;
+  int numColumns = 0;
+  columnsStream >> numColumns;
+  for (int cc = 0; cc < numColumns; ++cc)
+  {
+    std::pair<std::string, int> cinfo;
+    columnsStream >> cinfo.first >> cinfo.second;
+    columns.push_back(cinfo);
+  }
+
+  CSVFile file(timeStep, time);
+  file.SetColumns(columns);
+  if (row_count > 0)
+  {
+    file.InitializeStreamWorkers(table->GetRowData(), this);
+  }
+
+  // the root creates the file, or finds where to append to it.
+  int error_code = vtkErrorCode::NoError;
+  vtkIdType baseOffset = 0;
+  if (myRank == 0)
+  {
+    vtksys::ofstream stream(filename.c_str(), append ? ios::app | ios::binary : ios::binary);
+    if (stream.fail())
+    {
+      error_code = vtkErrorCode::CannotOpenFileError;
+    }
+    else if (append)
+    {
+      stream.seekp(0, ios::end);
+      baseOffset = static_cast<vtkIdType>(stream.tellp());
+    }
+  }
+  controller->Broadcast(&error_code, 1, 0);
+  if (error_code != vtkErrorCode::NoError)
+  {
+    this->SetErrorCode(error_code);
+    return false;
+  }
+  controller->Broadcast(&baseOffset, 1, 0);
+
+  // ranks format and write their rows one batch at a time, so that no rank
+  // holds more than a batch of formatted rows. Since the rows of a rank go
+  // after all rows of the previous ranks, a first pass computes the size of
+  // the formatted rows; the last formatted batch is kept to avoid formatting
+  // it again, which covers the common case of ranks with a single batch.
+  const vtkIdType numBatches = CSVFile::GetNumberOfBatches(row_count);
+  auto formatBatch = [&](vtkIdType batch, std::string& buffer)
+  {
+    buffer.clear();
+    if (batch == 0 && myRank == 0 && !append)
+    {
+      buffer = file.FormatHeader(this);
+    }
+    if (batch < numBatches)
+    {
+      file.FormatBatch(table->GetRowData(), this, batch,
+        [&buffer](const std::string& chunk) { buffer += chunk; });
+    }
+  };
+
+  // a rank without rows still has a batch, for the header on the root.
+  const vtkIdType numFormattedBatches = std::max<vtkIdType>(numBatches, 1);
+  std::string lastBuffer;
+  vtkIdType size = 0;
+  for (vtkIdType batch = 0; batch < numFormattedBatches; ++batch)
+  {
+    formatBatch(batch, lastBuffer);
+    size += static_cast<vtkIdType>(lastBuffer.size());
+  }
+
+  std::vector<vtkIdType> sizes(numRanks, 0);
+  controller->AllGather(&size, sizes.data(), 1);
+  vtkIdType offset = std::accumulate(sizes.begin(), sizes.begin() + myRank, baseOffset);
+  if (size > 0)
+  {
+    vtksys::ofstream stream(filename.c_str(), ios::in | ios::out | ios::binary);
+    std::string buffer;
+    for (vtkIdType batch = 0; batch < numFormattedBatches && !stream.fail(); ++batch)
+    {
+      const bool isLast = batch == numFormattedBatches - 1;
+      if (!isLast)
+      {
+        formatBatch(batch, buffer);
+      }
+      const std::string& data = isLast ? lastBuffer : buffer;
+      stream.seekp(static_cast<std::streamoff>(offset));
+      stream.write(data.data(), data.size());
+      offset += static_cast<vtkIdType>(data.size());
+    }
+    stream.close();
+    if (stream.fail())
+    {
+      error_code = vtkErrorCode::OutOfDiskSpaceError;
+    }
+  }
+
+  int global_error_code = vtkErrorCode::NoError;
+  controller->AllReduce(&error_code, &global_error_code, 1, vtkCommunicator::MAX_OP);
+  this->SetErrorCode(global_error_code);
+  return global_error_code == vtkErrorCode::NoError;
+}
+
 //-----------------------------------------------------------------------------
 void vtkCSVWriter::PrintSelf(ostream& os, vtkIndent indent)
 {
@@ -814,6 +1043,7 @@ void vtkCSVWriter::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "AddMetaData: " << (this->AddMetaData ? "Yes" : "No") << endl;
   os << indent << "AddTimeStep: " << (this->AddTimeStep ? "Yes" : "No") << endl;
   os << indent << "AddTime: " << (this->AddTime ? "Yes" : "No") << endl;
+  os << indent << "WriteInParallel: " << (this->WriteInParallel ? "Yes" : "No") << endl;
   os << indent << "NumberOfTimeSteps: " << this->NumberOfTimeSteps << endl;
   os << indent << "CurrentTimeIndex: " << this->CurrentTimeIndex << endl;
   os << indent << "TimeValues " << (this->TimeValues ? this->TimeValues->GetName() : "(none)")
@@ -169,6 +169,21 @@ public:
   vtkBooleanMacro(AddTimeStep, bool);
   ///@}
 
+  ///@{
+  /**
+   * When set to true (default is false) and running with more than one rank,
+   * each rank formats its own rows and writes them directly at its offset in
+   * the single output file, after the rows of the previous ranks, instead of
+   * sending them to the root to be written. Rows are formatted and written in
+   * bounded batches; ranks with more than one batch format their rows twice,
+   * once to compute their offset. This requires all ranks to have access to
+   * the same file system.
+   */
+  vtkSetMacro(WriteInParallel, bool);
+  vtkGetMacro(WriteInParallel, bool);
+  vtkBooleanMacro(WriteInParallel, bool);
+  ///@}
+
   ///@{
   /**
    * Internal method: decorates the "string" with the "StringDelimiter" if
@@ -211,6 +226,7 @@ protected:
   bool AddMetaData;
   bool AddTimeStep;
   bool AddTime;
+  bool WriteInParallel = false;
 
   vtkMultiProcessController* Controller;
 
@@ -223,6 +239,9 @@ private:
   void operator=(const vtkCSVWriter&) = delete;
 
   class CSVFile;
+
+  bool WriteSharedFile(
+    vtkTable* table, const std::string& filename, int timeStep, double time, bool append);
 };
 
 #endif
@@ -5,6 +5,7 @@
 #include "vtkClientServerInterpreter.h"
 #include "vtkClientServerInterpreterInitializer.h"
 #include "vtkClientServerStream.h"
+#include "vtkCommand.h"
 #include "vtkCompositeDataIterator.h"
 #include "vtkCompositeDataSet.h"
 #include "vtkConvertToPartitionedDataSetCollection.h"
@@ -17,6 +18,7 @@
 #include "vtkObjectFactory.h"
 #include "vtkPartitionedDataSet.h"
 #include "vtkPartitionedDataSetCollection.h"
+#include "vtkProgressObserver.h"
 #include "vtkReductionFilter.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
@@ -25,11 +27,19 @@
 #include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <future>
 #include <string>
+#include <vector>
 #include <vtksys/SystemTools.hxx>
 
 namespace
 {
+// Tag of the point-to-point messages streaming pieces to the IO rank. It is
+// above the tags reserved by vtkMultiProcessController for RMIs and by
+// vtkCommunicator for collective operations, and the pieces are exchanged on
+// the controller (or subcontroller) of this writer only.
+constexpr int STREAM_PIECES_TAG = 22000;
+
 bool vtkIsEmpty(vtkDataObject* dobj)
 {
   for (int cc = 0; (dobj != nullptr) && (cc < vtkDataObject::NUMBER_OF_ASSOCIATIONS); ++cc)
@@ -41,6 +51,53 @@ bool vtkIsEmpty(vtkDataObject* dobj)
   }
   return true;
 }
+
+/**
+ * Sends the non-empty pieces of each rank to the root of the controller, one
+ * piece per message, so that no rank has to serialize all of its data at once
+ * and the root only holds the pieces it has received so far. On the root, the
+ * pieces of all ranks are returned in rank order. On other ranks, the returned
+ * vector is empty.
+ */
+std::vector<vtkSmartPointer<vtkDataObject>> vtkStreamPiecesToRoot(
+  vtkMultiProcessController* controller, vtkDataObject* dobj)
+{
+  std::vector<vtkSmartPointer<vtkDataObject>> pieces;
+  for (auto piece : vtkCompositeDataSet::GetDataSets<vtkDataObject>(dobj))
+  {
+    if (!vtkIsEmpty(piece))
+    {
+      pieces.emplace_back(piece);
+    }
+  }
+
+  if (controller->GetLocalProcessId() != 0)
+  {
+    int count = static_cast<int>(pieces.size());
+    controller->Send(&count, 1, 0, STREAM_PIECES_TAG);
+    for (const auto& piece : pieces)
+    {
+      controller->Send(piece, 0, STREAM_PIECES_TAG);
+    }
+    pieces.clear();
+    return pieces;
+  }
+
+  for (int rank = 1, max = controller->GetNumberOfProcesses(); rank < max; ++rank)
+  {
+    int count = 0;
+    controller->Receive(&count, 1, rank, STREAM_PIECES_TAG);
+    for (int cc = 0; cc < count; ++cc)
+    {
+      auto piece = vtk::TakeSmartPointer(controller->ReceiveDataObject(rank, STREAM_PIECES_TAG));
+      if (!vtkIsEmpty(piece))
+      {
+        pieces.push_back(piece);
+      }
+    }
+  }
+  return pieces;
+}
 }
 
 vtkStandardNewMacro(vtkParallelSerialWriter);
@@ -82,6 +139,7 @@ vtkParallelSerialWriter::vtkParallelSerialWriter()
 //-----------------------------------------------------------------------------
 vtkParallelSerialWriter::~vtkParallelSerialWriter()
 {
+  this->WaitForPendingWrite();
   this->SetWriter(nullptr);
   this->SetFileNameMethod(nullptr);
   this->SetFileName(nullptr);
@@ -107,6 +165,58 @@ void vtkParallelSerialWriter::SetFileNameSuffix(const char* suffix)
   vtkSetStringBodyMacro(FileNameSuffix, formatStr);
 }
 
+//----------------------------------------------------------------------------
+bool vtkParallelSerialWriter::WaitForPendingWrite()
+{
+  if (!this->PendingWrite.valid())
+  {
+    return true;
+  }
+
+  bool success = this->PendingWrite.get();
+  for (unsigned long tag : this->PendingObserverTags)
+  {
+    this->PendingWriter->RemoveObserver(tag);
+  }
+  this->PendingObserverTags.clear();
+  this->PendingWriter->SetProgressObserver(nullptr);
+  this->PendingWriter->RemoveAllInputConnections(0);
+  this->PendingWriter = nullptr;
+
+  // report what the internal writer said now that we are back on the calling
+  // thread.
+  for (const auto& message : this->PendingMessages)
+  {
+    if (message.first == vtkCommand::ErrorEvent)
+    {
+      success = false;
+      vtkErrorMacro("Failed to write '" << this->PendingFileName << "': " << message.second);
+    }
+    else
+    {
+      vtkWarningMacro("While writing '" << this->PendingFileName << "': " << message.second);
+    }
+  }
+  if (!success && this->PendingMessages.empty())
+  {
+    vtkErrorMacro("Failed to write '" << this->PendingFileName << "'.");
+  }
+  this->PendingMessages.clear();
+  return success;
+}
+
+//----------------------------------------------------------------------------
+bool vtkParallelSerialWriter::OnPendingWriteMessage(
+  vtkObject*, unsigned long eventId, void* callData)
+{
+  const char* text = static_cast<const char*>(callData);
+  std::lock_guard<std::mutex> lock(this->PendingMessagesMutex);
+  this->PendingMessages.emplace_back(eventId, text ? text : "");
+  // do not let other observers, e.g. the progress handler, see the message
+  // off the calling thread.
+  return true;
+}
+
 //----------------------------------------------------------------------------
 int vtkParallelSerialWriter::Write()
 {
@@ -304,29 +414,15 @@ void vtkParallelSerialWriter::WriteATimestep(const std::string& fname, vtkPartit
     this->PreGatherHelper->RemoveAllInputConnections(0);
   }
 
-  // gather data to "root"; note this can be the root of the subcontroller.
-  std::vector<vtkSmartPointer<vtkDataObject>> gatheredDataSets;
-  controller->Gather(inputDO, gatheredDataSets, 0);
+  // stream the non-empty pieces to "root"; note this can be the root of the
+  // subcontroller.
+  std::vector<vtkSmartPointer<vtkDataObject>> allDataSets =
+    ::vtkStreamPiecesToRoot(controller, inputDO);
   if (controller->GetLocalProcessId() != 0)
   {
     // done.
     return;
   }
-  assert(!gatheredDataSets.empty());
-
-  // flatten the datasets.
-  std::vector<vtkSmartPointer<vtkDataObject>> allDataSets;
-  for (auto& dobj : gatheredDataSets)
-  {
-    const auto pieces = vtkCompositeDataSet::GetDataSets<vtkDataObject>(dobj);
-    allDataSets.insert(allDataSets.end(), pieces.begin(), pieces.end());
-  }
-  gatheredDataSets.clear();
-
-  // purge empty datasets from allDataSets.
-  allDataSets.erase(std::remove_if(allDataSets.begin(), allDataSets.end(),
-                      [](vtkDataObject* dobj) { return vtkIsEmpty(dobj); }),
-    allDataSets.end());
   if (allDataSets.empty())
   {
     return;
@@ -382,10 +478,66 @@ void vtkParallelSerialWriter::WriteAFile(const std::string& filename_arg, vtkDat
     }
   }
 
-  this->Writer->SetInputDataObject(input);
+  // the internal writer may still be in use by the previous write.
+  this->WaitForPendingWrite();
+
+  if (!this->WriteAsynchronously)
+  {
+    this->Writer->SetInputDataObject(input);
+    this->SetWriterFileName(filename.c_str());
+    std::string error;
+    if (!this->WriteInternal(this->Interpreter, error) && !error.empty())
+    {
+      vtkErrorMacro("Failed to write '" << filename << "': " << error);
+    }
+    this->Writer->RemoveAllInputConnections(0);
+    return;
+  }
+
+  // upstream filters and helpers reuse their output for the next execution and
+  // arrays may even be overwritten in place, e.g. zero-copy arrays of a
+  // simulation, so hand a private copy of the data over to the background
+  // thread. This also keeps lazily computed state, such as array ranges, from
+  // being updated concurrently with the pipeline.
+  auto snapshot = vtk::TakeSmartPointer(input->NewInstance());
+  snapshot->DeepCopy(input);
+  this->Writer->SetInputDataObject(snapshot);
   this->SetWriterFileName(filename.c_str());
-  this->WriteInternal();
-  this->Writer->RemoveAllInputConnections(0);
+  if (!this->AsynchronousInterpreter)
+  {
+    this->AsynchronousInterpreter.TakeReference(
+      vtkClientServerInterpreterInitializer::GetInitializer()->NewInterpreter());
+  }
+
+  // the internal writer may be registered with the progress handler and its
+  // errors would go to the output window, neither of which may be used off the
+  // calling thread. Mute its progress and hold its messages back until the
+  // write is waited for.
+  this->PendingWriter = this->Writer;
+  this->PendingFileName = filename;
+  vtkNew<vtkProgressObserver> progressObserver;
+  this->PendingWriter->SetProgressObserver(progressObserver);
+  for (unsigned long eventId : { vtkCommand::ErrorEvent, vtkCommand::WarningEvent })
+  {
+    this->PendingObserverTags.push_back(this->PendingWriter->AddObserver(
+      eventId, this, &vtkParallelSerialWriter::OnPendingWriteMessage, VTK_FLOAT_MAX));
+  }
+
+  this->PendingWrite = std::async(std::launch::async,
+    [this]()
+    {
+      std::string error;
+      if (this->WriteInternal(this->AsynchronousInterpreter, error))
+      {
+        return true;
+      }
+      if (!error.empty())
+      {
+        std::lock_guard<std::mutex> lock(this->PendingMessagesMutex);
+        this->PendingMessages.emplace_back(vtkCommand::ErrorEvent, error);
+      }
+      return false;
+    });
 }
 
 //----------------------------------------------------------------------------
@@ -406,16 +558,27 @@ vtkMTimeType vtkParallelSerialWriter::GetMTime()
 }
 
 //-----------------------------------------------------------------------------
-void vtkParallelSerialWriter::WriteInternal()
+bool vtkParallelSerialWriter::WriteInternal(vtkClientServerInterpreter* interp, std::string& error)
 {
   if (this->Writer && this->FileNameMethod)
   {
-    // Get the local process interpreter.
     vtkClientServerStream stream;
     stream << vtkClientServerStream::Invoke << this->Writer << "Write"
            << vtkClientServerStream::End;
-    this->Interpreter->ProcessStream(stream);
+    if (!interp->ProcessStream(stream))
+    {
+      const char* text = nullptr;
+      interp->GetLastResult().GetArgument(0, 0, &text);
+      error = text ? text : "the internal writer could not be invoked";
+      return false;
+    }
+
+    // writers returning a status report 0 on failure.
+    int status = 1;
+    interp->GetLastResult().GetArgument(0, 0, &status);
+    return status != 0;
   }
+  return true;
 }
 
 //-----------------------------------------------------------------------------
@@ -448,4 +611,5 @@ void vtkParallelSerialWriter::SetWriterFileName(const char* fname)
 void vtkParallelSerialWriter::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "WriteAsynchronously: " << this->WriteAsynchronously << endl;
 }
@@ -13,6 +13,12 @@
  *
  * This also makes it possible to write time-series for temporal datasets using
  * simple non-time-aware writers.
+ *
+ * Ranks send their non-empty pieces to the rank doing the IO one piece at a
+ * time rather than gathering their complete data in a single message. When
+ * WriteAsynchronously is on, the ranks doing the IO write on a background
+ * thread so that they can return to the pipeline, e.g. to compute the next
+ * timestep, while the file is being written.
  */
 
 #ifndef vtkParallelSerialWriter_h
@@ -21,7 +27,11 @@
 #include "vtkDataObjectAlgorithm.h"
 #include "vtkPVVTKExtensionsIOCoreModule.h" //needed for exports
 #include "vtkSmartPointer.h"                // needed for vtkSmartPointer
+#include <future>                           // for std::future
+#include <mutex>                            // for std::mutex
 #include <string>                           // for std::string
+#include <utility>                          // for std::pair
+#include <vector>                           // for std::vector
 
 class vtkClientServerInterpreter;
 class vtkMultiProcessController;
@@ -180,6 +190,31 @@ public:
   vtkGetMacro(RankAssignmentMode, int);
   ///@}
 
+  ///@{
+  /**
+   * When set to true, ranks doing the IO hand the data to write to a
+   * background thread and return immediately. A write still in progress is
+   * waited for before the next one starts, when WaitForPendingWrite() is
+   * called or when this writer is destroyed. The data is deep copied before
+   * being handed over, hence IO ranks need memory for one more copy of the data
+   * they write. The internal writer must not be used or changed while a write is
+   * in progress. While it writes in the background, the internal writer does
+   * not report progress and its errors and warnings are held back; they are
+   * reported by this writer, on the calling thread, once the write has been
+   * waited for. Off by default.
+   */
+  vtkSetMacro(WriteAsynchronously, bool);
+  vtkGetMacro(WriteAsynchronously, bool);
+  vtkBooleanMacro(WriteAsynchronously, bool);
+  ///@}
+
+  /**
+   * Block until the file being written on the background thread, if any, has
+   * been written out, then report the errors and warnings of that write.
+   * Returns false if that write failed.
+   */
+  bool WaitForPendingWrite();
+
   ///@{
   /**
    * Get/Set the controller to use. By default initialized to
@@ -208,7 +243,8 @@ private:
   void WriteAFile(const std::string& fname, vtkDataObject* input);
 
   void SetWriterFileName(const char* fname);
-  void WriteInternal();
+  bool WriteInternal(vtkClientServerInterpreter* interp, std::string& error);
+  bool OnPendingWriteMessage(vtkObject* caller, unsigned long eventId, void* callData);
 
   std::string GetPartitionFileName(const std::string& fname);
 
@@ -237,6 +273,19 @@ private:
   vtkMultiProcessController* Controller;
   vtkSmartPointer<vtkMultiProcessController> SubController;
   int SubControllerColor;
+
+  bool WriteAsynchronously = false;
+  std::future<bool> PendingWrite;
+  // Interpreter used on the background thread, since the global one is not
+  // thread safe.
+  vtkSmartPointer<vtkClientServerInterpreter> AsynchronousInterpreter;
+  // The writer, file name, observer tags and held back messages of the write
+  // in progress on the background thread.
+  vtkSmartPointer<vtkAlgorithm> PendingWriter;
+  std::string PendingFileName;
+  std::vector<unsigned long> PendingObserverTags;
+  std::vector<std::pair<unsigned long, std::string>> PendingMessages;
+  std::mutex PendingMessagesMutex;
 };
 
 #endif
@@ -1,21 +1,187 @@
 // SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
 // SPDX-License-Identifier: BSD-3-Clause
+#include "vtkCellData.h"
 #include "vtkCellTypeUtilities.h"
+#include "vtkDataArray.h"
+#include "vtkDummyController.h"
 #include "vtkMultiBlockDataSet.h"
+#include "vtkMultiProcessController.h"
 #include "vtkNew.h"
+#include "vtkPEnSightGoldBinaryReader.h"
 #include "vtkPGenericEnSightReader.h"
+#include "vtkPointData.h"
+#include "vtkPointSet.h"
+#include "vtkPoints.h"
 #include "vtkTestUtilities.h"
 #include "vtkUnstructuredGrid.h"
 
+#include "vtksys/SystemTools.hxx"
+
 #include <iostream>
+#include <memory>
+#include <random>
+#include <string>
 
-extern int TestPEnSightBinaryGoldReader(int argc, char* argv[])
+namespace
+{
+bool SameArrays(vtkDataArray* first, vtkDataArray* second)
+{
+  if (!first || !second)
+  {
+    return first == second;
+  }
+  if (first->GetNumberOfTuples() != second->GetNumberOfTuples() ||
+    first->GetNumberOfComponents() != second->GetNumberOfComponents())
+  {
+    return false;
+  }
+  for (vtkIdType tuple = 0; tuple < first->GetNumberOfTuples(); ++tuple)
+  {
+    for (int comp = 0; comp < first->GetNumberOfComponents(); ++comp)
+    {
+      if (first->GetComponent(tuple, comp) != second->GetComponent(tuple, comp))
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Compare the blocks, points and arrays of two outputs of the reader.
+bool SameOutputs(vtkMultiBlockDataSet* first, vtkMultiBlockDataSet* second, const char* what)
+{
+  if (first->GetNumberOfBlocks() != second->GetNumberOfBlocks())
+  {
+    std::cerr << what << " gave a different number of blocks." << std::endl;
+    return false;
+  }
+  for (unsigned int block = 0; block < first->GetNumberOfBlocks(); ++block)
+  {
+    vtkDataSet* firstBlock = vtkDataSet::SafeDownCast(first->GetBlock(block));
+    vtkDataSet* secondBlock = vtkDataSet::SafeDownCast(second->GetBlock(block));
+    if (!firstBlock || !secondBlock)
+    {
+      if (firstBlock != secondBlock)
+      {
+        std::cerr << what << " gave a different block " << block << "." << std::endl;
+        return false;
+      }
+      continue;
+    }
+    bool same = firstBlock->GetNumberOfPoints() == secondBlock->GetNumberOfPoints() &&
+      firstBlock->GetNumberOfCells() == secondBlock->GetNumberOfCells();
+    vtkPointSet* firstPointSet = vtkPointSet::SafeDownCast(firstBlock);
+    vtkPointSet* secondPointSet = vtkPointSet::SafeDownCast(secondBlock);
+    if (same && firstPointSet && secondPointSet && firstPointSet->GetPoints())
+    {
+      same = secondPointSet->GetPoints() &&
+        SameArrays(firstPointSet->GetPoints()->GetData(), secondPointSet->GetPoints()->GetData());
+    }
+    for (int cc = 0; same && cc < firstBlock->GetPointData()->GetNumberOfArrays(); ++cc)
+    {
+      vtkDataArray* array = firstBlock->GetPointData()->GetArray(cc);
+      same = array && SameArrays(array, secondBlock->GetPointData()->GetArray(array->GetName()));
+    }
+    for (int cc = 0; same && cc < firstBlock->GetCellData()->GetNumberOfArrays(); ++cc)
+    {
+      vtkDataArray* array = firstBlock->GetCellData()->GetArray(cc);
+      same = array && SameArrays(array, secondBlock->GetCellData()->GetArray(array->GetName()));
+    }
+    if (!same)
+    {
+      std::cerr << what << " gave a different block " << block << "." << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+// Reading through a memory mapping must give the same result as reading
+// through a file stream.
+bool TestMemoryMapping(const char* fname)
+{
+  vtkNew<vtkPEnSightGoldBinaryReader> streamReader;
+  streamReader->SetCaseFileName(fname);
+  streamReader->UseMemoryMappingOff();
+  streamReader->Update();
+  vtkNew<vtkPEnSightGoldBinaryReader> mappedReader;
+  mappedReader->SetCaseFileName(fname);
+  mappedReader->UseMemoryMappingOn();
+  mappedReader->Update();
+  return SameOutputs(streamReader->GetOutput(), mappedReader->GetOutput(), "Memory mapped read");
+}
+
+// Reading while writing an offset index, and reading with an existing index,
+// must give the same result as reading without one.
+bool TestOffsetIndex(const char* fname, const std::string& tempDir)
+{
+  // Index files are written next to the data, work on a copy of it. Each
+  // process of the test gets its own copy.
+  const std::string dataDir = vtksys::SystemTools::GetFilenamePath(fname);
+  const std::string copyDir =
+    tempDir + "/TestPEnSightOffsetIndex-" + std::to_string(std::random_device{}());
+  vtksys::SystemTools::MakeDirectory(copyDir);
+  for (const char* name : { "TEST_bin.case", "test_bin.geo", "test_bin.pressure.0001",
+         "test_bin.extr_pressure.0001", "test_bin.velocity.0001", "test_bin.extr_velocity.0001" })
+  {
+    if (!vtksys::SystemTools::CopyFileAlways(dataDir + "/" + name, copyDir + "/" + name))
+    {
+      std::cerr << "Could not copy " << name << " to " << copyDir << "." << std::endl;
+      return false;
+    }
+  }
+  const std::string caseFile = copyDir + "/TEST_bin.case";
+  const std::string indexFile = copyDir + "/test_bin.geo.pvoffsets";
+
+  vtkNew<vtkPEnSightGoldBinaryReader> plainReader;
+  plainReader->SetCaseFileName(caseFile.c_str());
+  plainReader->Update();
+  bool success = true;
+  if (vtksys::SystemTools::FileExists(indexFile))
+  {
+    std::cerr << "An offset index was written while UseOffsetIndexFiles is off." << std::endl;
+    success = false;
+  }
+
+  vtkNew<vtkPEnSightGoldBinaryReader> indexingReader;
+  indexingReader->SetCaseFileName(caseFile.c_str());
+  indexingReader->UseOffsetIndexFilesOn();
+  indexingReader->Update();
+  if (!vtksys::SystemTools::FileExists(indexFile))
+  {
+    std::cerr << "No offset index was written for the geometry file." << std::endl;
+    success = false;
+  }
+
+  vtkNew<vtkPEnSightGoldBinaryReader> indexedReader;
+  indexedReader->SetCaseFileName(caseFile.c_str());
+  indexedReader->UseOffsetIndexFilesOn();
+  indexedReader->Update();
+
+  success = SameOutputs(plainReader->GetOutput(), indexingReader->GetOutput(),
+              "Reading while writing an offset index") &&
+    SameOutputs(plainReader->GetOutput(), indexedReader->GetOutput(),
+      "Reading with an offset index") &&
+    success;
+  vtksys::SystemTools::RemoveADirectory(copyDir);
+  return success;
+}
+
+int TestReader(int argc, char* argv[])
 {
-  char* fname =
-    vtkTestUtilities::ExpandDataFileName(argc, argv, "Testing/Data/EnSight/TEST_bin.case");
+  std::unique_ptr<char[]> fname(
+    vtkTestUtilities::ExpandDataFileName(argc, argv, "Testing/Data/EnSight/TEST_bin.case"));
+  std::unique_ptr<char[]> tempDir(
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary"));
+
+  if (!TestMemoryMapping(fname.get()) || !TestOffsetIndex(fname.get(), tempDir.get()))
+  {
+    return EXIT_FAILURE;
+  }
 
   vtkNew<vtkPGenericEnSightReader> reader;
-  reader->SetCaseFileName(fname);
+  reader->SetCaseFileName(fname.get());
   reader->Update();
   vtkMultiBlockDataSet* mb = reader->GetOutput();
   vtkUnstructuredGrid* ug = vtkUnstructuredGrid::SafeDownCast(mb->GetBlock(0));
@@ -48,3 +214,25 @@ extern int TestPEnSightBinaryGoldReader(int argc, char* argv[])
 
   return EXIT_SUCCESS;
 }
+}
+
+extern int TestPEnSightBinaryGoldReader(int argc, char* argv[])
+{
+  // The parallel readers expect a controller, each process reads on its own.
+  // SetGlobalController does not take a reference, hence reset it before the
+  // controller goes out of scope.
+  vtkNew<vtkDummyController> controller;
+  const bool installController = vtkMultiProcessController::GetGlobalController() == nullptr;
+  if (installController)
+  {
+    vtkMultiProcessController::SetGlobalController(controller);
+  }
+
+  const int status = ::TestReader(argc, argv);
+
+  if (installController)
+  {
+    vtkMultiProcessController::SetGlobalController(nullptr);
+  }
+  return status;
+}
@@ -10,9 +10,11 @@
 #include "vtkImageData.h"
 #include "vtkMultiBlockDataSet.h"
 #include "vtkObjectFactory.h"
+#include "vtkPVMemoryMappedFile.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkRectilinearGrid.h"
+#include "vtkSMPTools.h"
 #include "vtkStringScanner.h"
 #include "vtkStructuredGrid.h"
 #include "vtkUnsignedCharArray.h"
@@ -22,6 +24,7 @@
 #include "vtksys/SystemTools.hxx"
 
 #include <cctype>
+#include <cstring>
 #include <string>
 
 vtkStandardNewMacro(vtkPEnSightGoldBinaryReader);
@@ -29,10 +32,38 @@ vtkStandardNewMacro(vtkPEnSightGoldBinaryReader);
 // This is half the precision of an int.
 #define MAXIMUM_PART_ID 65536
 
+namespace
+{
+// Copies 4-byte words from the mapped file to `result`, reversing the bytes of
+// each word when the file and host byte orders differ. Large arrays are split
+// across threads and the swap loop is simple enough to be vectorized.
+void DecodeWords(const char* source, void* result, vtkIdType numWords, bool swap)
+{
+  vtkSMPTools::For(0, numWords, 64 * 1024,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      vtkTypeUInt32* words = static_cast<vtkTypeUInt32*>(result) + begin;
+      std::memcpy(words, source + begin * sizeof(vtkTypeUInt32),
+        (end - begin) * sizeof(vtkTypeUInt32));
+      if (swap)
+      {
+        for (vtkIdType cc = 0, max = end - begin; cc < max; ++cc)
+        {
+          const vtkTypeUInt32 word = words[cc];
+          words[cc] = (word >> 24) | ((word >> 8) & 0x0000FF00u) | ((word << 8) & 0x00FF0000u) |
+            (word << 24);
+        }
+      }
+    });
+}
+}
+
 //----------------------------------------------------------------------------
 vtkPEnSightGoldBinaryReader::vtkPEnSightGoldBinaryReader()
 {
   this->IFile = nullptr;
+  this->MappedFile = new vtkPVMemoryMappedFile;
+  this->UseMemoryMapping = true;
   this->FileSize = 0;
   this->Fortran = 0;
   this->NodeIdsListed = 0;
@@ -52,7 +83,8 @@ vtkPEnSightGoldBinaryReader::vtkPEnSightGoldBinaryReader()
 //----------------------------------------------------------------------------
 vtkPEnSightGoldBinaryReader::~vtkPEnSightGoldBinaryReader()
 {
-  delete this->IFile;
+  this->CloseFile();
+  delete this->MappedFile;
   delete[] this->FloatBuffer[2];
   delete[] this->FloatBuffer[1];
   delete[] this->FloatBuffer[0];
@@ -69,8 +101,7 @@ int vtkPEnSightGoldBinaryReader::OpenFile(const char* filename)
   }
 
   // Close file from any previous image
-  delete this->IFile;
-  this->IFile = nullptr;
+  this->CloseFile();
 
   // Open the new file
   vtkDebugMacro(<< "Opening file " << filename);
@@ -80,11 +111,18 @@ int vtkPEnSightGoldBinaryReader::OpenFile(const char* filename)
     // Find out how big the file is.
     this->FileSize = (long)(fs.st_size);
 
+    if (this->UseMemoryMapping && this->MappedFile->Open(filename))
+    {
+      this->IFile = new std::istream(this->MappedFile);
+    }
+    else
+    {
 #ifdef _WIN32
-    this->IFile = new vtksys::ifstream(filename, ios::in | ios::binary);
+      this->IFile = new vtksys::ifstream(filename, ios::in | ios::binary);
 #else
-    this->IFile = new vtksys::ifstream(filename, ios::in);
+      this->IFile = new vtksys::ifstream(filename, ios::in);
 #endif
+    }
   }
   else
   {
@@ -161,6 +199,15 @@ int vtkPEnSightGoldBinaryReader::OpenFile(const char* filename)
   return 1;
 }
 
+//----------------------------------------------------------------------------
+void vtkPEnSightGoldBinaryReader::CloseFile()
+{
+  // the stream must go before the memory it reads from.
+  delete this->IFile;
+  this->IFile = nullptr;
+  this->MappedFile->Close();
+}
+
 //----------------------------------------------------------------------------
 int vtkPEnSightGoldBinaryReader::InitializeFile(const char* fileName)
 {
@@ -248,6 +295,7 @@ int vtkPEnSightGoldBinaryReader::ReadGeometryFile(
   if (this->UseFileSets)
   {
     int realTimeStep = timeStep - 1;
+    this->LoadFileOffsetIndex(fileName);
     int j = 0;
     // Try to find the nearest time step for which we know the offset
     for (i = realTimeStep; i >= 0; i--)
@@ -273,7 +321,7 @@ int vtkPEnSightGoldBinaryReader::ReadGeometryFile(
       {
         if (this->FileOffsets.find(fileName) == this->FileOffsets.end())
         {
-          std::map<int, long> tsMap;
+          std::map<int, vtkTypeInt64> tsMap;
           this->FileOffsets[fileName] = tsMap;
         }
         this->FileOffsets[fileName][j] = this->IFile->tellg();
@@ -343,6 +391,8 @@ int vtkPEnSightGoldBinaryReader::ReadGeometryFile(
       return 0;
     }
     realId = this->InsertNewPartId(partId);
+    this->BeginPartLayout(
+      fileName, this->UseFileSets ? timeStep - 1 : 0, partId, this->IFile->tellg());
 
     // Increment the number of geometry parts such that the measured geometry,
     // if any, can be properly combined into a vtkMultiBlockDataSet object.
@@ -396,16 +446,14 @@ int vtkPEnSightGoldBinaryReader::ReadGeometryFile(
       if (lineRead < 0)
       {
         free(name);
-        delete this->IFile;
-        this->IFile = nullptr;
+        this->CloseFile();
         return 0;
       }
     }
     free(name);
   }
 
-  delete this->IFile;
-  this->IFile = nullptr;
+  this->CloseFile();
 
   if (lineRead < 0)
   {
@@ -541,8 +589,7 @@ int vtkPEnSightGoldBinaryReader::SkipTimeStep()
 
   if (lineRead < 0)
   {
-    delete this->IFile;
-    this->IFile = nullptr;
+    this->CloseFile();
     return 0;
   }
 
@@ -1142,6 +1189,7 @@ int vtkPEnSightGoldBinaryReader::ReadMeasuredGeometryFile(
   if (this->UseFileSets)
   {
     int realTimeStep = timeStep - 1;
+    this->LoadFileOffsetIndex(fileName);
     int k, j = 0;
     // Try to find the nearest time step for which we know the offset
     for (k = realTimeStep; k >= 0; k--)
@@ -1183,7 +1231,7 @@ int vtkPEnSightGoldBinaryReader::ReadMeasuredGeometryFile(
       this->ReadLine(line); // END TIME STEP
       if (this->FileOffsets.find(fileName) == this->FileOffsets.end())
       {
-        std::map<int, long> tsMap;
+        std::map<int, vtkTypeInt64> tsMap;
         this->FileOffsets[fileName] = tsMap;
       }
       this->FileOffsets[fileName][j] = this->IFile->tellg();
@@ -1280,8 +1328,7 @@ int vtkPEnSightGoldBinaryReader::ReadMeasuredGeometryFile(
   delete[] xCoords;
   delete[] yCoords;
   delete[] zCoords;
-  delete this->IFile;
-  this->IFile = nullptr;
+  this->CloseFile();
 
   return 1;
 }
@@ -1329,6 +1376,7 @@ int vtkPEnSightGoldBinaryReader::ReadScalarsPerNode(const char* fileName, const
   if (this->UseFileSets)
   {
     int realTimeStep = timeStep - 1;
+    this->LoadFileOffsetIndex(fileName);
     // Try to find the nearest time step for which we know the offset
     int j = 0;
     for (i = realTimeStep; i >= 0; i--)
@@ -1382,7 +1430,7 @@ int vtkPEnSightGoldBinaryReader::ReadScalarsPerNode(const char* fileName, const
       }
       if (this->FileOffsets.find(fileName) == this->FileOffsets.end())
       {
-        std::map<int, long> tsMap;
+        std::map<int, vtkTypeInt64> tsMap;
         this->FileOffsets[fileName] = tsMap;
       }
       this->FileOffsets[fileName][j] = this->IFile->tellg();
@@ -1432,8 +1480,7 @@ int vtkPEnSightGoldBinaryReader::ReadScalarsPerNode(const char* fileName, const
       delete[] scalarsRead;
     }
 
-    delete this->IFile;
-    this->IFile = nullptr;
+    this->CloseFile();
 
     return 1;
   }
@@ -1496,8 +1543,7 @@ int vtkPEnSightGoldBinaryReader::ReadScalarsPerNode(const char* fileName, const
     lineRead = this->ReadLine(line);
   }
 
-  delete this->IFile;
-  this->IFile = nullptr;
+  this->CloseFile();
 
   return 1;
 }
@@ -1546,6 +1592,7 @@ int vtkPEnSightGoldBinaryReader::ReadVectorsPerNode(const char* fileName, const
   if (this->UseFileSets)
   {
     int realTimeStep = timeStep - 1;
+    this->LoadFileOffsetIndex(fileName);
     // Try to find the nearest time step for which we know the offset
     int j = 0;
     for (i = realTimeStep; i >= 0; i--)
@@ -1599,7 +1646,7 @@ int vtkPEnSightGoldBinaryReader::ReadVectorsPerNode(const char* fileName, const
       }
       if (this->FileOffsets.find(fileName) == this->FileOffsets.end())
       {
-        std::map<int, long> tsMap;
+        std::map<int, vtkTypeInt64> tsMap;
         this->FileOffsets[fileName] = tsMap;
       }
       this->FileOffsets[fileName][j] = this->IFile->tellg();
@@ -1647,8 +1694,7 @@ int vtkPEnSightGoldBinaryReader::ReadVectorsPerNode(const char* fileName, const
       vectors->Delete();
     }
 
-    delete this->IFile;
-    this->IFile = nullptr;
+    this->CloseFile();
 
     return 1;
   }
@@ -1701,8 +1747,7 @@ int vtkPEnSightGoldBinaryReader::ReadVectorsPerNode(const char* fileName, const
     lineRead = this->ReadLine(line);
   }
 
-  delete this->IFile;
-  this->IFile = nullptr;
+  this->CloseFile();
 
   return 1;
 }
@@ -1750,6 +1795,7 @@ int vtkPEnSightGoldBinaryReader::ReadTensorsPerNode(const char* fileName, const
   if (this->UseFileSets)
   {
     int realTimeStep = timeStep - 1;
+    this->LoadFileOffsetIndex(fileName);
     int j = 0;
     // Try to find the nearest time step for which we know the offset
     for (i = realTimeStep; i >= 0; i--)
@@ -1790,7 +1836,7 @@ int vtkPEnSightGoldBinaryReader::ReadTensorsPerNode(const char* fileName, const
       }
       if (this->FileOffsets.find(fileName) == this->FileOffsets.end())
       {
-        std::map<int, long> tsMap;
+        std::map<int, vtkTypeInt64> tsMap;
         this->FileOffsets[fileName] = tsMap;
       }
       this->FileOffsets[fileName][j] = this->IFile->tellg();
@@ -1860,8 +1906,7 @@ int vtkPEnSightGoldBinaryReader::ReadTensorsPerNode(const char* fileName, const
     lineRead = this->ReadLine(line);
   }
 
-  delete this->IFile;
-  this->IFile = nullptr;
+  this->CloseFile();
 
   return 1;
 }
@@ -1910,6 +1955,7 @@ int vtkPEnSightGoldBinaryReader::ReadScalarsPerElement(const char* fileName,
   if (this->UseFileSets)
   {
     int realTimeStep = timeStep - 1;
+    this->LoadFileOffsetIndex(fileName);
     // Try to find the nearest time step for which we know the offset
     int j = 0;
     for (i = realTimeStep; i >= 0; i--)
@@ -1964,8 +2010,7 @@ int vtkPEnSightGoldBinaryReader::ReadScalarsPerElement(const char* fileName,
               if (elementType == -1)
               {
                 vtkErrorMacro("Unknown element type \"" << line << "\"");
-                delete this->IFile;
-                this->IFile = nullptr;
+                this->CloseFile();
                 return 0;
               }
               idx = this->UnstructuredPartIds->IsId(realId);
@@ -1982,7 +2027,7 @@ int vtkPEnSightGoldBinaryReader::ReadScalarsPerElement(const char* fileName,
       } // end while
       if (this->FileOffsets.find(fileName) == this->FileOffsets.end())
       {
-        std::map<int, long> tsMap;
+        std::map<int, vtkTypeInt64> tsMap;
         this->FileOffsets[fileName] = tsMap;
       }
       this->FileOffsets[fileName][j] = this->IFile->tellg();
@@ -2047,8 +2092,7 @@ int vtkPEnSightGoldBinaryReader::ReadScalarsPerElement(const char* fileName,
           if (elementType == -1)
           {
             vtkErrorMacro("Unknown element type \"" << line << "\"");
-            delete this->IFile;
-            this->IFile = nullptr;
+            this->CloseFile();
 
             if (component == 0)
             {
@@ -2106,8 +2150,7 @@ int vtkPEnSightGoldBinaryReader::ReadScalarsPerElement(const char* fileName,
     }
   }
 
-  delete this->IFile;
-  this->IFile = nullptr;
+  this->CloseFile();
 
   return 1;
 }
@@ -2156,6 +2199,7 @@ int vtkPEnSightGoldBinaryReader::ReadVectorsPerElement(const char* fileName,
   if (this->UseFileSets)
   {
     int realTimeStep = timeStep - 1;
+    this->LoadFileOffsetIndex(fileName);
     // Try to find the nearest time step for which we know the offset
     int j = 0;
     for (i = realTimeStep; i >= 0; i--)
@@ -2229,7 +2273,7 @@ int vtkPEnSightGoldBinaryReader::ReadVectorsPerElement(const char* fileName,
       }
       if (this->FileOffsets.find(fileName) == this->FileOffsets.end())
       {
-        std::map<int, long> tsMap;
+        std::map<int, vtkTypeInt64> tsMap;
         this->FileOffsets[fileName] = tsMap;
       }
       this->FileOffsets[fileName][j] = this->IFile->tellg();
@@ -2352,8 +2396,7 @@ int vtkPEnSightGoldBinaryReader::ReadVectorsPerElement(const char* fileName,
     }
   }
 
-  delete this->IFile;
-  this->IFile = nullptr;
+  this->CloseFile();
 
   return 1;
 }
@@ -2402,6 +2445,7 @@ int vtkPEnSightGoldBinaryReader::ReadTensorsPerElement(const char* fileName,
   if (this->UseFileSets)
   {
     int realTimeStep = timeStep - 1;
+    this->LoadFileOffsetIndex(fileName);
     // Try to find the nearest time step for which we know the offset
     int j = 0;
     for (i = realTimeStep; i >= 0; i--)
@@ -2475,7 +2519,7 @@ int vtkPEnSightGoldBinaryReader::ReadTensorsPerElement(const char* fileName,
       }
       if (this->FileOffsets.find(fileName) == this->FileOffsets.end())
       {
-        std::map<int, long> tsMap;
+        std::map<int, vtkTypeInt64> tsMap;
         this->FileOffsets[fileName] = tsMap;
       }
       this->FileOffsets[fileName][j] = this->IFile->tellg();
@@ -2619,8 +2663,7 @@ int vtkPEnSightGoldBinaryReader::ReadTensorsPerElement(const char* fileName,
     }
   }
 
-  delete this->IFile;
-  this->IFile = nullptr;
+  this->CloseFile();
 
   return 1;
 }
@@ -2659,7 +2702,9 @@ int vtkPEnSightGoldBinaryReader::CreateUnstructuredGridOutput(
     this->GetPointIds(idx)->Reset();
   }
 
-  output->Allocate(1000);
+  // Allocate the cells read by this process when the part layout is indexed.
+  const vtkIdType numberOfLocalCells = this->GetNumberOfLocalCells();
+  output->Allocate(numberOfLocalCells > 0 ? numberOfLocalCells : 1000);
 
   long coordinatesOffset = -1;
   this->CoordinatesAtEnd = false;
@@ -2669,6 +2714,19 @@ int vtkPEnSightGoldBinaryReader::CreateUnstructuredGridOutput(
 
   while (lineRead && strncmp(line, "part", 4) != 0)
   {
+    if (this->RecordingPartLayout && this->GetElementType(line) >= 0)
+    {
+      // The number of elements follows the element type.
+      const vtkTypeInt64 sectionOffset = this->IFile->tellg();
+      int numElementsInSection;
+      if (this->ReadInt(&numElementsInSection))
+      {
+        this->AddElementSection(
+          this->GetElementType(line), numElementsInSection, sectionOffset);
+      }
+      this->IFile->clear();
+      this->IFile->seekg(sectionOffset, ios::beg);
+    }
     if (strncmp(line, "coordinates", 11) == 0)
     {
       // keep coordinates offset in mind
@@ -4199,21 +4257,12 @@ int vtkPEnSightGoldBinaryReader::ReadIntArray(int* result, int numInts)
     }
   }
 
-  if (!this->IFile->read((char*)result, sizeof(int) * numInts).good())
+  if (!this->ReadWordArray(result, numInts))
   {
     vtkErrorMacro("Read failed.");
     return 0;
   }
 
-  if (this->ByteOrder == FILE_LITTLE_ENDIAN)
-  {
-    vtkByteSwap::Swap4LERange(result, numInts);
-  }
-  else
-  {
-    vtkByteSwap::Swap4BERange(result, numInts);
-  }
-
   if (this->Fortran)
   {
     if (!this->IFile->read(dummy, 4).good())
@@ -4245,28 +4294,63 @@ int vtkPEnSightGoldBinaryReader::ReadFloatArray(float* result, int numFloats)
     }
   }
 
-  if (!this->IFile->read((char*)result, sizeof(float) * numFloats).good())
+  if (!this->ReadWordArray(result, numFloats))
   {
     vtkErrorMacro("Read failed");
     return 0;
   }
 
-  if (this->ByteOrder == FILE_LITTLE_ENDIAN)
+  if (this->Fortran)
   {
-    vtkByteSwap::Swap4LERange(result, numFloats);
+    if (!this->IFile->read(dummy, 4).good())
+    {
+      vtkErrorMacro("Read (fortran) failed.");
+      return 0;
+    }
   }
-  else
+  return 1;
+}
+
+// Internal function to read an array of 4-byte words in the file byte order.
+// Returns zero if there was an error.
+int vtkPEnSightGoldBinaryReader::ReadWordArray(void* result, vtkIdType numWords)
+{
+  if (numWords <= 0)
   {
-    vtkByteSwap::Swap4BERange(result, numFloats);
+    return 1;
   }
 
-  if (this->Fortran)
+  const std::streamoff numBytes = numWords * static_cast<std::streamoff>(sizeof(vtkTypeUInt32));
+  if (this->MappedFile->GetData())
   {
-    if (!this->IFile->read(dummy, 4).good())
+    // Decode straight from the mapped file.
+    const std::streamoff position = this->IFile->tellg();
+    const std::streamoff size = static_cast<std::streamoff>(this->MappedFile->GetSize());
+    if (position < 0 || position + numBytes > size)
     {
-      vtkErrorMacro("Read (fortran) failed.");
+      this->IFile->setstate(ios::failbit);
       return 0;
     }
+#ifdef VTK_WORDS_BIGENDIAN
+    const bool swap = (this->ByteOrder == FILE_LITTLE_ENDIAN);
+#else
+    const bool swap = (this->ByteOrder != FILE_LITTLE_ENDIAN);
+#endif
+    ::DecodeWords(this->MappedFile->GetData() + position, result, numWords, swap);
+    return this->IFile->seekg(position + numBytes).good() ? 1 : 0;
+  }
+
+  if (!this->IFile->read(static_cast<char*>(result), numBytes).good())
+  {
+    return 0;
+  }
+  if (this->ByteOrder == FILE_LITTLE_ENDIAN)
+  {
+    vtkByteSwap::Swap4LERange(result, numWords);
+  }
+  else
+  {
+    vtkByteSwap::Swap4BERange(result, numWords);
   }
   return 1;
 }
@@ -4465,19 +4549,10 @@ void vtkPEnSightGoldBinaryReader::UpdateFloatBuffer()
         vtkErrorMacro("File seek failed");
       }
     }
-    if (!this->IFile->read((char*)this->FloatBuffer[i], sizeof(float) * sizeToRead).good())
+    if (!this->ReadWordArray(this->FloatBuffer[i], sizeToRead))
     {
       vtkErrorMacro("Read failed");
     }
-
-    if (this->ByteOrder == FILE_LITTLE_ENDIAN)
-    {
-      vtkByteSwap::Swap4LERange(this->FloatBuffer[i], sizeToRead);
-    }
-    else
-    {
-      vtkByteSwap::Swap4BERange(this->FloatBuffer[i], sizeToRead);
-    }
   }
 
   this->IFile->seekg(currentPosition);
@@ -4487,4 +4562,5 @@ void vtkPEnSightGoldBinaryReader::UpdateFloatBuffer()
 void vtkPEnSightGoldBinaryReader::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "UseMemoryMapping: " << this->UseMemoryMapping << endl;
 }
@@ -25,6 +25,7 @@
 #include "vtkPVVTKExtensionsIOEnSightModule.h" //needed for exports
 
 class vtkMultiBlockDataSet;
+class vtkPVMemoryMappedFile;
 class vtkUnstructuredGrid;
 class vtkPoints;
 
@@ -35,6 +36,18 @@ public:
   vtkTypeMacro(vtkPEnSightGoldBinaryReader, vtkPEnSightReader);
   void PrintSelf(ostream& os, vtkIndent indent) override;
 
+  ///@{
+  /**
+   * When on (default), files are memory mapped instead of being read through
+   * a file stream, and large coordinate, connectivity and variable arrays are
+   * decoded from the mapped memory using multiple threads. The reader falls
+   * back to a file stream when a file cannot be mapped.
+   */
+  vtkSetMacro(UseMemoryMapping, bool);
+  vtkGetMacro(UseMemoryMapping, bool);
+  vtkBooleanMacro(UseMemoryMapping, bool);
+  ///@}
+
 protected:
   vtkPEnSightGoldBinaryReader();
   ~vtkPEnSightGoldBinaryReader() override;
@@ -42,6 +55,9 @@ protected:
   // Returns 1 if successful.  Sets file size as a side action.
   int OpenFile(const char* filename);
 
+  // Closes the current file, if any.
+  void CloseFile();
+
   // Returns 1 if successful.  Handles constructing the filename, opening the file and checking
   // if it's binary
   int InitializeFile(const char* filename);
@@ -159,6 +175,13 @@ protected:
    */
   int ReadFloatArray(float* result, int numFloats);
 
+  /**
+   * Internal function to read in an array of 4-byte words, without the
+   * Fortran record markers, converting them to the host byte order.
+   * Returns zero if there was an error.
+   */
+  int ReadWordArray(void* result, vtkIdType numWords);
+
   /**
    * Read Coordinates, or just skip the part in the file.
    */
@@ -194,6 +217,9 @@ protected:
   int Fortran;
 
   istream* IFile;
+
+  bool UseMemoryMapping;
+  vtkPVMemoryMappedFile* MappedFile;
   // The size of the file could be used to choose byte order.
   long FileSize;
 
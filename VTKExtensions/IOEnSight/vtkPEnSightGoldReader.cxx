@@ -147,6 +147,7 @@ int vtkPEnSightGoldReader::ReadGeometryFile(
   if (this->UseFileSets)
   {
     int realTimeStep = timeStep - 1;
+    this->LoadFileOffsetIndex(fileName);
     // Try to find the nearest time step for which we know the offset
     int j = 0;
     for (i = realTimeStep; i >= 0; i--)
@@ -171,7 +172,7 @@ int vtkPEnSightGoldReader::ReadGeometryFile(
       this->ReadLine(line);
       if (this->FileOffsets.find(fileName) == this->FileOffsets.end())
       {
-        std::map<int, long> tsMap;
+        std::map<int, vtkTypeInt64> tsMap;
         this->FileOffsets[fileName] = tsMap;
       }
       this->FileOffsets[fileName][j] = this->IS->tellg();
@@ -239,6 +240,8 @@ int vtkPEnSightGoldReader::ReadGeometryFile(
     this->ReadNextDataLine(line);
     partId = vtk::scan_int<int>(std::string_view(line))->value() - 1; // EnSight starts #ing at 1.
     realId = this->InsertNewPartId(partId);
+    this->BeginPartLayout(
+      fileName, this->UseFileSets ? timeStep - 1 : 0, partId, this->IS->tellg());
 
     this->ReadNextDataLine(line); // part description line
     if (strncmp(line, "interface", 9) == 0)
@@ -360,6 +363,7 @@ int vtkPEnSightGoldReader::ReadMeasuredGeometryFile(
   if (this->UseFileSets)
   {
     int realTimeStep = timeStep - 1;
+    this->LoadFileOffsetIndex(fileName);
     // Try to find the nearest time step for which we know the offset
     int j = 0;
     for (i = realTimeStep; i >= 0; i--)
@@ -384,7 +388,7 @@ int vtkPEnSightGoldReader::ReadMeasuredGeometryFile(
       this->ReadLine(line);
       if (this->FileOffsets.find(fileName) == this->FileOffsets.end())
       {
-        std::map<int, long> tsMap;
+        std::map<int, vtkTypeInt64> tsMap;
         this->FileOffsets[fileName] = tsMap;
       }
       this->FileOffsets[fileName][j] = this->IS->tellg();
@@ -510,6 +514,7 @@ int vtkPEnSightGoldReader::ReadScalarsPerNode(const char* fileName, const char*
   if (this->UseFileSets)
   {
     int realTimeStep = timeStep - 1;
+    this->LoadFileOffsetIndex(fileName);
     // Try to find the nearest time step for which we know the offset
     j = 0;
     for (i = realTimeStep; i >= 0; i--)
@@ -534,7 +539,7 @@ int vtkPEnSightGoldReader::ReadScalarsPerNode(const char* fileName, const char*
       }
       if (this->FileOffsets.find(fileName) == this->FileOffsets.end())
       {
-        std::map<int, long> tsMap;
+        std::map<int, vtkTypeInt64> tsMap;
         this->FileOffsets[fileName] = tsMap;
       }
       this->FileOffsets[fileName][j] = this->IS->tellg();
@@ -722,6 +727,7 @@ int vtkPEnSightGoldReader::ReadVectorsPerNode(const char* fileName, const char*
   if (this->UseFileSets)
   {
     int realTimeStep = timeStep - 1;
+    this->LoadFileOffsetIndex(fileName);
     // Try to find the nearest time step for which we know the offset
     j = 0;
     for (i = realTimeStep; i >= 0; i--)
@@ -746,7 +752,7 @@ int vtkPEnSightGoldReader::ReadVectorsPerNode(const char* fileName, const char*
       }
       if (this->FileOffsets.find(fileName) == this->FileOffsets.end())
       {
-        std::map<int, long> tsMap;
+        std::map<int, vtkTypeInt64> tsMap;
         this->FileOffsets[fileName] = tsMap;
       }
       this->FileOffsets[fileName][j] = this->IS->tellg();
@@ -895,6 +901,7 @@ int vtkPEnSightGoldReader::ReadTensorsPerNode(const char* fileName, const char*
   if (this->UseFileSets)
   {
     int realTimeStep = timeStep - 1;
+    this->LoadFileOffsetIndex(fileName);
     // Try to find the nearest time step for which we know the offset
     j = 0;
     for (i = realTimeStep; i >= 0; i--)
@@ -919,7 +926,7 @@ int vtkPEnSightGoldReader::ReadTensorsPerNode(const char* fileName, const char*
       }
       if (this->FileOffsets.find(fileName) == this->FileOffsets.end())
       {
-        std::map<int, long> tsMap;
+        std::map<int, vtkTypeInt64> tsMap;
         this->FileOffsets[fileName] = tsMap;
       }
       this->FileOffsets[fileName][j] = this->IS->tellg();
@@ -1020,6 +1027,7 @@ int vtkPEnSightGoldReader::ReadScalarsPerElement(const char* fileName, const cha
   if (this->UseFileSets)
   {
     int realTimeStep = timeStep - 1;
+    this->LoadFileOffsetIndex(fileName);
     // Try to find the nearest time step for which we know the offset
     int j = 0;
     for (i = realTimeStep; i >= 0; i--)
@@ -1044,7 +1052,7 @@ int vtkPEnSightGoldReader::ReadScalarsPerElement(const char* fileName, const cha
       }
       if (this->FileOffsets.find(fileName) == this->FileOffsets.end())
       {
-        std::map<int, long> tsMap;
+        std::map<int, vtkTypeInt64> tsMap;
         this->FileOffsets[fileName] = tsMap;
       }
       this->FileOffsets[fileName][j] = this->IS->tellg();
@@ -1224,6 +1232,7 @@ int vtkPEnSightGoldReader::ReadVectorsPerElement(const char* fileName, const cha
   if (this->UseFileSets)
   {
     int realTimeStep = timeStep - 1;
+    this->LoadFileOffsetIndex(fileName);
     // Try to find the nearest time step for which we know the offset
     j = 0;
     for (i = realTimeStep; i >= 0; i--)
@@ -1248,7 +1257,7 @@ int vtkPEnSightGoldReader::ReadVectorsPerElement(const char* fileName, const cha
       }
       if (this->FileOffsets.find(fileName) == this->FileOffsets.end())
       {
-        std::map<int, long> tsMap;
+        std::map<int, vtkTypeInt64> tsMap;
         this->FileOffsets[fileName] = tsMap;
       }
       this->FileOffsets[fileName][j] = this->IS->tellg();
@@ -1390,6 +1399,7 @@ int vtkPEnSightGoldReader::ReadTensorsPerElement(const char* fileName, const cha
   if (this->UseFileSets)
   {
     int realTimeStep = timeStep - 1;
+    this->LoadFileOffsetIndex(fileName);
     // Try to find the nearest time step for which we know the offset
     j = 0;
     for (i = realTimeStep; i >= 0; i--)
@@ -1414,7 +1424,7 @@ int vtkPEnSightGoldReader::ReadTensorsPerElement(const char* fileName, const cha
       }
       if (this->FileOffsets.find(fileName) == this->FileOffsets.end())
       {
-        std::map<int, long> tsMap;
+        std::map<int, vtkTypeInt64> tsMap;
         this->FileOffsets[fileName] = tsMap;
       }
       this->FileOffsets[fileName][j] = this->IS->tellg();
@@ -1540,7 +1550,9 @@ int vtkPEnSightGoldReader::CreateUnstructuredGridOutput(
     this->GetCellIds(idx, i)->Reset();
   }
 
-  output->Allocate(1000);
+  // Allocate the cells read by this process when the part layout is indexed.
+  const vtkIdType numberOfLocalCells = this->GetNumberOfLocalCells();
+  output->Allocate(numberOfLocalCells > 0 ? numberOfLocalCells : 1000);
 
   long coordinatesOffset = -1;
   this->CoordinatesAtEnd = false;
@@ -1550,6 +1562,23 @@ int vtkPEnSightGoldReader::CreateUnstructuredGridOutput(
 
   while (lineRead && strncmp(line, "part", 4) != 0)
   {
+    if (this->RecordingPartLayout && this->GetElementType(line) >= 0)
+    {
+      // The number of elements follows the element type.
+      const vtkTypeInt64 sectionOffset = this->IS->tellg();
+      char countLine[256];
+      if (this->ReadNextDataLine(countLine))
+      {
+        auto numElementsInSection = vtk::scan_int<vtkTypeInt64>(std::string_view(countLine));
+        if (numElementsInSection)
+        {
+          this->AddElementSection(
+            this->GetElementType(line), numElementsInSection->value(), sectionOffset);
+        }
+      }
+      this->IS->clear();
+      this->IS->seekg(sectionOffset, ios::beg);
+    }
     if (strncmp(line, "coordinates", 11) == 0)
     {
       vtkDebugMacro("coordinates");
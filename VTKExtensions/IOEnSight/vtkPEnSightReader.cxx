@@ -28,6 +28,9 @@
 #include "vtkUnstructuredGrid.h"
 
 #include "vtksys/FStream.hxx"
+#include "vtksys/SystemTools.hxx"
+
+#include <random>
 
 typedef std::vector<vtkPEnSightReader::vtkPEnSightReaderCellIds*> vtkPEnSightReaderCellIdsTypeBase;
 class vtkPEnSightReaderCellIdsType : public vtkPEnSightReaderCellIdsTypeBase
@@ -47,6 +50,37 @@ void cleanup(vtkPEnSightReaderCellIdsType* foo)
     delete *iter;
   }
 }
+
+// Offset index files are stored next to the data file, with this suffix.
+constexpr const char* OffsetIndexExtension = ".pvoffsets";
+constexpr const char* OffsetIndexHeader = "ParaView EnSight offsets 2";
+
+std::string GetDataFilePath(const char* filePath, const char* fileName)
+{
+  std::string path;
+  if (filePath && *filePath)
+  {
+    path = filePath;
+    if (path.back() != '/')
+    {
+      path += "/";
+    }
+  }
+  return path + fileName;
+}
+
+// Size and modification time used to detect outdated offset indices.
+bool GetFileSignature(const std::string& path, vtkTypeInt64& size, vtkTypeInt64& mtime)
+{
+  vtksys::SystemTools::Stat_t fs;
+  if (vtksys::SystemTools::Stat(path, &fs) != 0)
+  {
+    return false;
+  }
+  size = static_cast<vtkTypeInt64>(fs.st_size);
+  mtime = static_cast<vtkTypeInt64>(fs.st_mtime);
+  return true;
+}
 }
 
 //----------------------------------------------------------------------------
@@ -109,6 +143,9 @@ vtkPEnSightReader::vtkPEnSightReader()
   this->MultiProcessNumberOfProcesses = -2;
 
   this->GhostLevels = 0;
+
+  this->CurrentPartLayout = nullptr;
+  this->RecordingPartLayout = false;
 }
 
 //----------------------------------------------------------------------------
@@ -424,6 +461,7 @@ int vtkPEnSightReader::RequestData(vtkInformation* vtkNotUsed(request),
     }
   }
 
+  this->SaveFileOffsetIndices();
   return 1;
 }
 
@@ -2744,6 +2782,192 @@ void vtkPEnSightReader::SetBlockName(
   output->GetMetaData(blockNo)->Set(vtkCompositeDataSet::NAME(), name);
 }
 
+//----------------------------------------------------------------------------
+void vtkPEnSightReader::BeginPartLayout(
+  const char* fileName, int timeStep, int partId, vtkTypeInt64 offset)
+{
+  this->CurrentPartLayout = nullptr;
+  this->RecordingPartLayout = false;
+  if (!this->UseOffsetIndexFiles)
+  {
+    return;
+  }
+  this->LoadFileOffsetIndex(fileName);
+
+  auto& layouts = this->PartLayouts[fileName][timeStep];
+  auto iter = layouts.find(partId);
+  if (iter == layouts.end() || iter->second.Offset != offset)
+  {
+    vtkPEnSightPartLayout& layout = layouts[partId];
+    layout.Offset = offset;
+    layout.Sections.clear();
+    this->RecordingPartLayout = true;
+    this->ModifiedPartLayouts.insert(fileName);
+    iter = layouts.find(partId);
+  }
+  this->CurrentPartLayout = &iter->second;
+}
+
+//----------------------------------------------------------------------------
+void vtkPEnSightReader::AddElementSection(
+  int elementType, vtkTypeInt64 numberOfElements, vtkTypeInt64 offset)
+{
+  if (this->RecordingPartLayout && elementType >= 0)
+  {
+    this->CurrentPartLayout->Sections.push_back({ elementType, numberOfElements, offset });
+  }
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkPEnSightReader::GetNumberOfLocalCells()
+{
+  if (!this->CurrentPartLayout || this->RecordingPartLayout)
+  {
+    return -1;
+  }
+
+  // Same distribution of the elements of each section as InsertNextCellAndId.
+  const vtkIdType numberOfProcesses = std::max(this->GetMultiProcessNumberOfProcesses(), 1);
+  const vtkIdType localProcessId = std::max(this->GetMultiProcessLocalProcessId(), 0);
+  vtkIdType numberOfCells = 0;
+  for (const auto& section : this->CurrentPartLayout->Sections)
+  {
+    const vtkIdType numElements = static_cast<vtkIdType>(section.NumberOfElements);
+    const vtkIdType numLocal = numElements / numberOfProcesses + 1;
+    const vtkIdType begin = localProcessId * numLocal;
+    numberOfCells += std::max<vtkIdType>(0, std::min(numLocal, numElements - begin));
+  }
+  return numberOfCells;
+}
+
+//----------------------------------------------------------------------------
+void vtkPEnSightReader::LoadFileOffsetIndex(const char* fileName)
+{
+  if (!this->UseOffsetIndexFiles || this->IndexedFileOffsets.count(fileName))
+  {
+    return;
+  }
+  this->IndexedFileOffsets[fileName] = 0;
+
+  const std::string path = ::GetDataFilePath(this->FilePath, fileName);
+  vtkTypeInt64 size, mtime;
+  if (!::GetFileSignature(path, size, mtime))
+  {
+    return;
+  }
+  vtksys::ifstream index((path + OffsetIndexExtension).c_str());
+  std::string header;
+  vtkTypeInt64 indexSize, indexMTime;
+  if (!std::getline(index, header) || header != OffsetIndexHeader ||
+    !(index >> indexSize >> indexMTime) || indexSize != size || indexMTime != mtime)
+  {
+    vtkDebugMacro("No valid offset index for " << path);
+    return;
+  }
+
+  // Offsets and layouts already known take precedence.
+  std::map<int, vtkTypeInt64>& offsets = this->FileOffsets[fileName];
+  auto& layouts = this->PartLayouts[fileName];
+  std::string kind;
+  int timeStep, partId, elementType;
+  vtkTypeInt64 offset, numberOfElements;
+  while (index >> kind >> timeStep)
+  {
+    if (kind == "t" && index >> offset && timeStep >= 0 && offset >= 0 && offset < size)
+    {
+      offsets.insert(std::make_pair(timeStep, offset));
+    }
+    else if (kind == "p" && index >> partId >> offset && offset >= 0 && offset < size)
+    {
+      layouts[timeStep].insert(std::make_pair(partId, vtkPEnSightPartLayout{ offset, {} }));
+    }
+    else if (kind == "e" && index >> partId >> elementType >> numberOfElements >> offset &&
+      elementType >= 0 && elementType < vtkPEnSightReader::NUMBER_OF_ELEMENT_TYPES &&
+      numberOfElements >= 0 && numberOfElements < size && offset >= 0 && offset < size)
+    {
+      auto iter = layouts[timeStep].find(partId);
+      if (iter != layouts[timeStep].end())
+      {
+        iter->second.Sections.push_back({ elementType, numberOfElements, offset });
+      }
+    }
+    else
+    {
+      vtkDebugMacro("Ignoring the rest of the offset index for " << path);
+      break;
+    }
+  }
+  this->IndexedFileOffsets[fileName] = offsets.size();
+}
+
+//----------------------------------------------------------------------------
+void vtkPEnSightReader::SaveFileOffsetIndices()
+{
+  // All ranks read the same files, the first one writes the indices.
+  if (!this->UseOffsetIndexFiles || this->GetMultiProcessLocalProcessId() > 0)
+  {
+    return;
+  }
+
+  std::set<std::string> fileNames;
+  std::swap(fileNames, this->ModifiedPartLayouts);
+  for (const auto& fileOffsets : this->FileOffsets)
+  {
+    size_t& indexed = this->IndexedFileOffsets[fileOffsets.first];
+    if (fileOffsets.second.size() > indexed)
+    {
+      // Do not try again until more offsets are found, even on failure.
+      indexed = fileOffsets.second.size();
+      fileNames.insert(fileOffsets.first);
+    }
+  }
+
+  for (const std::string& fileName : fileNames)
+  {
+    const std::string path = ::GetDataFilePath(this->FilePath, fileName.c_str());
+    vtkTypeInt64 size, mtime;
+    if (!::GetFileSignature(path, size, mtime))
+    {
+      continue;
+    }
+
+    // Write to a temporary file first so that readers never see a partial
+    // index. Processes reading the same files must not share it.
+    const std::string indexPath = path + OffsetIndexExtension;
+    const std::string temporaryPath =
+      indexPath + "." + std::to_string(std::random_device{}()) + ".tmp";
+    bool written;
+    {
+      vtksys::ofstream index(temporaryPath.c_str());
+      index << OffsetIndexHeader << "\n" << size << " " << mtime << "\n";
+      for (const auto& offset : this->FileOffsets[fileName])
+      {
+        index << "t " << offset.first << " " << offset.second << "\n";
+      }
+      for (const auto& timeStepLayouts : this->PartLayouts[fileName])
+      {
+        for (const auto& layout : timeStepLayouts.second)
+        {
+          index << "p " << timeStepLayouts.first << " " << layout.first << " "
+                << layout.second.Offset << "\n";
+          for (const auto& section : layout.second.Sections)
+          {
+            index << "e " << timeStepLayouts.first << " " << layout.first << " "
+                  << section.ElementType << " " << section.NumberOfElements << " "
+                  << section.Offset << "\n";
+          }
+        }
+      }
+      written = static_cast<bool>(index);
+    }
+    if (!written || !vtksys::SystemTools::RenameFile(temporaryPath, indexPath))
+    {
+      vtkDebugMacro("Could not write offset index " << indexPath);
+      vtksys::SystemTools::RemoveFile(temporaryPath);
+    }
+  }
+}
+
 //----------------------------------------------------------------------------
 void vtkPEnSightReader::PrintSelf(ostream& os, vtkIndent indent)
 {
@@ -27,6 +27,7 @@
 #include "vtkIdTypeArray.h" // For ivars
 #include <algorithm>        // For ivars
 #include <map>              // For ivars
+#include <set>              // For ivars
 #include <string>           // For ivars
 #include <vector>           // For ivars
 
@@ -804,7 +805,62 @@ protected:
 
   int GhostLevels;
 
-  std::map<std::string, std::map<int, long>> FileOffsets;
+  std::map<std::string, std::map<int, vtkTypeInt64>> FileOffsets;
+
+  /**
+   * Layout of a geometry part: the offset just past its part id and, for
+   * unstructured parts, the type, number of elements and offset of each
+   * element section. Offsets are absolute positions in the file.
+   */
+  struct vtkPEnSightElementSection
+  {
+    int ElementType;
+    vtkTypeInt64 NumberOfElements;
+    vtkTypeInt64 Offset;
+  };
+  struct vtkPEnSightPartLayout
+  {
+    vtkTypeInt64 Offset;
+    std::vector<vtkPEnSightElementSection> Sections;
+  };
+
+  // Part layouts per file, time step (0 without file sets) and part id.
+  std::map<std::string, std::map<int, std::map<int, vtkPEnSightPartLayout>>> PartLayouts;
+
+  ///@{
+  /**
+   * Record the layout of the geometry parts being read when
+   * UseOffsetIndexFiles is on. `BeginPartLayout` makes the layout of a part
+   * current. Sections are only added by `AddElementSection` when the layout
+   * of that part was not known yet, either from an index or a previous read.
+   * `GetNumberOfLocalCells` returns the number of cells of the current part
+   * read by this process, or -1 when its layout is unknown.
+   */
+  void BeginPartLayout(const char* fileName, int timeStep, int partId, vtkTypeInt64 offset);
+  void AddElementSection(int elementType, vtkTypeInt64 numberOfElements, vtkTypeInt64 offset);
+  vtkIdType GetNumberOfLocalCells();
+  ///@}
+
+  vtkPEnSightPartLayout* CurrentPartLayout;
+  bool RecordingPartLayout;
+
+  ///@{
+  /**
+   * Persist FileOffsets and PartLayouts next to each data file when
+   * UseOffsetIndexFiles is on. `LoadFileOffsetIndex` merges the offsets and
+   * layouts stored for a file the first time it is called for that file,
+   * provided the file size and modification time still match.
+   * `SaveFileOffsetIndices` writes the index of the files for which new
+   * offsets or layouts were found.
+   */
+  void LoadFileOffsetIndex(const char* fileName);
+  void SaveFileOffsetIndices();
+  ///@}
+
+  // Number of time step offsets known to be stored in the index of each file.
+  std::map<std::string, size_t> IndexedFileOffsets;
+  // Files for which part layouts were recorded since their index was saved.
+  std::set<std::string> ModifiedPartLayouts;
 
 private:
   vtkPEnSightReader(const vtkPEnSightReader&) = delete;
@@ -27,6 +27,21 @@ public:
   vtkTypeMacro(vtkPGenericEnSightReader, vtkGenericEnSightReader);
   void PrintSelf(ostream& os, vtkIndent indent) override;
 
+  ///@{
+  /**
+   * When on, the offsets of the time steps found in files containing several
+   * time steps, and the offset, element types and element counts of the
+   * geometry parts, are saved to an index file next to each data file (with a
+   * `.pvoffsets` extension). Later reads reuse it to seek to a time step
+   * directly instead of scanning the file, and to size the parts up front.
+   * Index files are ignored when the size or modification time of the data
+   * file changed. Only used when reading in parallel. Default is off.
+   */
+  vtkSetMacro(UseOffsetIndexFiles, bool);
+  vtkGetMacro(UseOffsetIndexFiles, bool);
+  vtkBooleanMacro(UseOffsetIndexFiles, bool);
+  ///@}
+
 protected:
   vtkPGenericEnSightReader();
   ~vtkPGenericEnSightReader() override;
@@ -45,6 +60,8 @@ protected:
   int MultiProcessLocalProcessId;
   int MultiProcessNumberOfProcesses;
 
+  bool UseOffsetIndexFiles;
+
 private:
   vtkPGenericEnSightReader(const vtkPGenericEnSightReader&) = delete;
   void operator=(const vtkPGenericEnSightReader&) = delete;
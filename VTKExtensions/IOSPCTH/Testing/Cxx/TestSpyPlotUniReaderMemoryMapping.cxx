@@ -0,0 +1,85 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkDataArray.h"
+#include "vtkDataArraySelection.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkSpyPlotUniReader.h"
+#include "vtkTestUtilities.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+
+#define VERIFY(x, y)                                                                               \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    vtkLogF(ERROR, y);                                                                             \
+    return EXIT_FAILURE;                                                                           \
+  }
+
+namespace
+{
+bool SameArrays(vtkDataArray* first, vtkDataArray* second)
+{
+  if (!first || !second)
+  {
+    return first == second;
+  }
+  if (first->GetDataType() != second->GetDataType() ||
+    first->GetNumberOfTuples() != second->GetNumberOfTuples() ||
+    first->GetNumberOfComponents() != second->GetNumberOfComponents())
+  {
+    return false;
+  }
+  const size_t size = static_cast<size_t>(first->GetNumberOfValues()) * first->GetDataTypeSize();
+  return std::memcmp(first->GetVoidPointer(0), second->GetVoidPointer(0), size) == 0;
+}
+}
+
+// Decoding the cell fields from a file stream, when the file cannot be memory
+// mapped, must give the same result as decoding them from the mapped memory.
+extern int TestSpyPlotUniReaderMemoryMapping(int argc, char* argv[])
+{
+  std::unique_ptr<char[]> fname(
+    vtkTestUtilities::ExpandDataFileName(argc, argv, "Data/SPCTH/Dave_Karelitz_Small/spcth_a.0"));
+
+  vtkNew<vtkDataArraySelection> mappedSelection;
+  vtkNew<vtkSpyPlotUniReader> mappedReader;
+  mappedReader->SetFileName(fname.get());
+  mappedReader->SetCellArraySelection(mappedSelection);
+  mappedReader->UseMemoryMappingOn();
+
+  vtkNew<vtkDataArraySelection> streamSelection;
+  vtkNew<vtkSpyPlotUniReader> streamReader;
+  streamReader->SetFileName(fname.get());
+  streamReader->SetCellArraySelection(streamSelection);
+  streamReader->UseMemoryMappingOff();
+
+  VERIFY(mappedReader->ReadInformation() && streamReader->ReadInformation(),
+    "Failed to read the file information.");
+  mappedSelection->EnableAllArrays();
+  streamSelection->EnableAllArrays();
+  VERIFY(mappedReader->MakeCurrent() && streamReader->MakeCurrent(), "Failed to read the data.");
+
+  const int numberOfBlocks = mappedReader->GetNumberOfDataBlocks();
+  VERIFY(numberOfBlocks > 0 && numberOfBlocks == streamReader->GetNumberOfDataBlocks(),
+    "Readers do not agree on the number of blocks.");
+  int field = 0;
+  for (; mappedReader->GetCellFieldName(field) != nullptr; ++field)
+  {
+    const char* name = streamReader->GetCellFieldName(field);
+    VERIFY(name != nullptr && std::strcmp(mappedReader->GetCellFieldName(field), name) == 0,
+      "Readers do not agree on the field names.");
+    for (int block = 0; block < numberOfBlocks; ++block)
+    {
+      int mappedFixed;
+      int streamFixed;
+      VERIFY(::SameArrays(mappedReader->GetCellFieldData(block, field, &mappedFixed),
+               streamReader->GetCellFieldData(block, field, &streamFixed)),
+        "Decoded fields differ between the mapped and the streamed file.");
+    }
+  }
+  VERIFY(field > 0, "No cell field read.");
+  return EXIT_SUCCESS;
+}
@@ -7,6 +7,8 @@
 #include "vtkFloatArray.h"
 #include "vtkIntArray.h"
 #include "vtkObjectFactory.h"
+#include "vtkPVMemoryMappedFile.h"
+#include "vtkSMPTools.h"
 #include "vtkSpyPlotBlock.h"
 #include "vtkSpyPlotIStream.h"
 #include "vtkUnsignedCharArray.h"
@@ -14,6 +16,8 @@
 #include "vtksys/FStream.hxx"
 #include "vtksys/RegularExpression.hxx"
 
+#include <algorithm>
+#include <atomic>
 #include <iostream>
 #include <sstream>
 #include <vector>
@@ -45,6 +49,28 @@ inline ostream& operator<<(ostream& os, const vtkSpyPlotWriteString& c)
   os.flush();
   return os;
 }
+
+//-----------------------------------------------------------------------------
+// Location of the run-length encoded planes of one field of one block, and
+// the array they decode to. Blocks and fields are independent, hence they are
+// decoded concurrently once all of them are located.
+struct vtkSpyPlotFieldBlock
+{
+  vtkFloatArray* FloatArray = nullptr;
+  vtkUnsignedCharArray* UnsignedCharArray = nullptr;
+  int PlaneSize = 0;
+  std::vector<std::pair<vtkTypeInt64, int>> Planes;
+};
+
+// When the file cannot be mapped, compressed planes are read into memory and
+// decoded whenever they exceed this size, rather than all at once.
+constexpr size_t vtkSpyPlotMaximumBufferedBytes = 64 * 1024 * 1024;
+
+// Run-length decodes `in` into `out`, see the definition below. Errors are
+// reported through `self` unless it is null, e.g. on worker threads.
+template <class t>
+int vtkSpyPlotUniReaderRunLengthDataDecode(
+  vtkSpyPlotUniReader* self, const unsigned char* in, int inSize, t* out, int outSize, t scale = 1);
 }
 
 //-----------------------------------------------------------------------------
@@ -87,6 +113,7 @@ vtkSpyPlotUniReader::vtkSpyPlotUniReader()
   this->NumberOfCellFields = 0;
   this->HaveInformation = 0;
   this->DownConvertVolumeFraction = 1;
+  this->UseMemoryMapping = true;
   this->DataTypeChanged = 0;
   this->GeomTimeStep = -1; // Indicate that geometry will have to be loaded
   this->NeedToCheck = 1;   // Indicates non-geometric data needs to be checked
@@ -221,9 +248,69 @@ int vtkSpyPlotUniReader::MakeCurrent()
   }
 
   std::vector<unsigned char> arrayBuffer;
-  vtksys::ifstream ifs(this->FileName, ios::binary | ios::in);
+
+  // Map the file when possible so that the fields are decoded straight from
+  // the mapping. Otherwise, their compressed bytes are read into a buffer.
+  vtkPVMemoryMappedFile mappedFile;
+  std::istream mappedStream(&mappedFile);
+  vtksys::ifstream ifs;
   vtkSpyPlotIStream spis;
-  spis.SetStream(&ifs);
+  const bool mapped = this->UseMemoryMapping && mappedFile.Open(this->FileName);
+  if (mapped)
+  {
+    spis.SetStream(&mappedStream);
+  }
+  else
+  {
+    ifs.open(this->FileName, ios::binary | ios::in);
+    spis.SetStream(&ifs);
+  }
+  std::vector<unsigned char> compressedBuffer;
+  std::vector<::vtkSpyPlotFieldBlock> fieldBlocks;
+
+  // Decode the located fields of all blocks concurrently. Errors cannot be
+  // reported from the worker threads, so the size of the plane that failed
+  // to decode is recorded and reported afterwards.
+  auto decodeFieldBlocks = [&]()
+  {
+    const unsigned char* compressed = mapped ? mappedFile.GetData() : compressedBuffer.data();
+    std::atomic<int> failedPlaneSize(-1);
+    vtkSMPTools::For(0, static_cast<vtkIdType>(fieldBlocks.size()), 1,
+      [&](vtkIdType begin, vtkIdType end)
+      {
+        for (vtkIdType cc = begin; cc < end && failedPlaneSize < 0; ++cc)
+        {
+          const ::vtkSpyPlotFieldBlock& fieldBlock = fieldBlocks[cc];
+          const int planeSize = fieldBlock.PlaneSize;
+          for (vtkIdType zax = 0; zax < static_cast<vtkIdType>(fieldBlock.Planes.size()); ++zax)
+          {
+            const unsigned char* in = compressed + fieldBlock.Planes[zax].first;
+            const int inSize = fieldBlock.Planes[zax].second;
+            const int status = fieldBlock.FloatArray
+              ? ::vtkSpyPlotUniReaderRunLengthDataDecode<float>(nullptr, in, inSize,
+                  fieldBlock.FloatArray->GetPointer(zax * planeSize), planeSize)
+              : ::vtkSpyPlotUniReaderRunLengthDataDecode<unsigned char>(nullptr, in, inSize,
+                  fieldBlock.UnsignedCharArray->GetPointer(zax * planeSize), planeSize,
+                  static_cast<unsigned char>(255));
+            if (!status)
+            {
+              failedPlaneSize = planeSize;
+              break;
+            }
+          }
+        }
+      });
+    fieldBlocks.clear();
+    compressedBuffer.clear();
+    if (failedPlaneSize >= 0)
+    {
+      vtkErrorMacro(
+        "Problem doing RLD decode. Too much data generated. Expected: " << failedPlaneSize);
+      vtkErrorMacro("Problem RLD decoding cell data array");
+      return false;
+    }
+    return true;
+  };
   int dump;
   vtkSpyPlotUniReader::DataDump* dp;
   int blocksUpdated = 0;
@@ -426,44 +513,45 @@ int vtkSpyPlotUniReader::MakeCurrent()
           // vtkDebugMacro( "*** Create data array: "
           // << dataArray->GetNumberOfTuples() );
         }
+        ::vtkSpyPlotFieldBlock fieldBlock;
+        fieldBlock.FloatArray = floatArray;
+        fieldBlock.UnsignedCharArray = unsignedCharArray;
         int zax;
         int bdims[3];
         bk->GetDimensions(bdims);
+        fieldBlock.PlaneSize = bdims[0] * bdims[1];
         for (zax = 0; zax < bdims[2]; ++zax)
         {
-          int planeSize = bdims[0] * bdims[1];
-          if (!spis.ReadInt32s(&numBytes, 1))
+          if (!spis.ReadInt32s(&numBytes, 1) || numBytes < 0)
           {
             vtkErrorMacro("Problem reading the number of bytes");
             return 0;
           }
-          if (static_cast<int>(arrayBuffer.size()) < numBytes)
+          const vtkTypeInt64 position = spis.Tell();
+          if (!dataArray || mapped)
           {
-            arrayBuffer.resize(numBytes);
-          }
-          if (!spis.ReadString(&*arrayBuffer.begin(), numBytes))
-          {
-            vtkErrorMacro("Problem reading the bytes");
-            return 0;
-          }
-          if (floatArray)
-          {
-            float* ptr = floatArray->GetPointer(zax * planeSize);
-            if (!this->RunLengthDataDecode(&*arrayBuffer.begin(), numBytes, ptr, planeSize))
+            // skip the bytes, they are decoded from the mapping if needed.
+            if (mapped && position + numBytes > static_cast<vtkTypeInt64>(mappedFile.GetSize()))
             {
-              vtkErrorMacro("Problem RLD decoding float data array");
+              vtkErrorMacro("Problem reading the bytes");
               return 0;
             }
-          }
-          if (unsignedCharArray)
-          {
-            unsigned char* ptr = unsignedCharArray->GetPointer(zax * planeSize);
-            if (!this->RunLengthDataDecode(&*arrayBuffer.begin(), numBytes, ptr, planeSize))
+            spis.Seek(numBytes, true);
+            if (dataArray)
             {
-              vtkErrorMacro("Problem RLD decoding unsigned char data array");
-              return 0;
+              fieldBlock.Planes.emplace_back(position, numBytes);
             }
+            continue;
+          }
+
+          const vtkTypeInt64 offset = static_cast<vtkTypeInt64>(compressedBuffer.size());
+          compressedBuffer.resize(compressedBuffer.size() + numBytes);
+          if (!spis.ReadString(compressedBuffer.data() + offset, numBytes))
+          {
+            vtkErrorMacro("Problem reading the bytes");
+            return 0;
           }
+          fieldBlock.Planes.emplace_back(offset, numBytes);
         }
         if (dataArray)
         {
@@ -471,11 +559,24 @@ int vtkSpyPlotUniReader::MakeCurrent()
           var->GhostCellsFixed[actualBlockId] = 0;
           vtkDebugMacro(" " << dataArray << " initialized: " << dataArray->GetName());
           actualBlockId++;
+          fieldBlocks.push_back(std::move(fieldBlock));
+          // Without a mapping, bound the compressed bytes held in memory by
+          // decoding as soon as enough of them were read.
+          if (!mapped && compressedBuffer.size() >= ::vtkSpyPlotMaximumBufferedBytes &&
+            !decodeFieldBlocks())
+          {
+            return 0;
+          }
         }
       }
     }
   }
 
+  if (!decodeFieldBlocks())
+  {
+    return 0;
+  }
+
   if (blocksUpdated && needMarkers)
   {
     if (this->ReadMarkerDumps(&spis) == 0)
@@ -675,7 +776,7 @@ namespace
 {
 template <class t>
 int vtkSpyPlotUniReaderRunLengthDataDecode(
-  vtkSpyPlotUniReader* self, const unsigned char* in, int inSize, t* out, int outSize, t scale = 1)
+  vtkSpyPlotUniReader* self, const unsigned char* in, int inSize, t* out, int outSize, t scale)
 {
   int outIndex = 0, inIndex = 0;
 
@@ -694,18 +795,17 @@ int vtkSpyPlotUniReaderRunLengthDataDecode(
       vtkByteSwap::SwapBE(&val);
       ptmp += 4;
       // Now populate the out data
-      int k;
-      for (k = 0; k < runLength; ++k)
+      if (outIndex + runLength > outSize)
       {
-        if (outIndex >= outSize)
+        if (self)
         {
           vtkErrorWithObjectMacro(
             self, "Problem doing RLD decode. Too much data generated. Expected: " << outSize);
-          return 0;
         }
-        out[outIndex] = static_cast<t>(val * scale);
-        outIndex++;
+        return 0;
       }
+      std::fill_n(out + outIndex, runLength, static_cast<t>(val * scale));
+      outIndex += runLength;
       inIndex += 5;
     }
     else // runLength >= 128
@@ -715,8 +815,11 @@ int vtkSpyPlotUniReaderRunLengthDataDecode(
       {
         if (outIndex >= outSize)
         {
-          vtkErrorWithObjectMacro(
-            self, "Problem doing RLD decode. Too much data generated. Expected: " << outSize);
+          if (self)
+          {
+            vtkErrorWithObjectMacro(
+              self, "Problem doing RLD decode. Too much data generated. Expected: " << outSize);
+          }
           return 0;
         }
         float val;
@@ -1349,6 +1452,7 @@ void vtkSpyPlotUniReader::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "DataTypeChanged: " << this->DataTypeChanged << endl;
   os << indent << "NumberOfCellFields: " << this->NumberOfCellFields << endl;
   os << indent << "NeedToCheck: " << this->NeedToCheck << endl;
+  os << indent << "UseMemoryMapping: " << this->UseMemoryMapping << endl;
 }
 
 //-----------------------------------------------------------------------------
@@ -223,6 +223,18 @@ public:
   vtkSetMacro(DataTypeChanged, int);
   void SetDownConvertVolumeFraction(int vf);
 
+  ///@{
+  /**
+   * When on (default), the file is memory mapped and the cell fields are
+   * decoded from the mapped memory using multiple threads. Otherwise, or when
+   * the file cannot be mapped, the compressed fields are read through a file
+   * stream in bounded batches before being decoded.
+   */
+  vtkSetMacro(UseMemoryMapping, bool);
+  vtkGetMacro(UseMemoryMapping, bool);
+  vtkBooleanMacro(UseMemoryMapping, bool);
+  ///@}
+
 protected:
   vtkSpyPlotUniReader();
   ~vtkSpyPlotUniReader() override;
@@ -298,6 +310,7 @@ private:
 
   int DataTypeChanged;
   int DownConvertVolumeFraction;
+  bool UseMemoryMapping;
 
   int NumberOfCellFields;
 
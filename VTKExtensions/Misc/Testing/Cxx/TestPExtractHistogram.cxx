@@ -0,0 +1,97 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "vtkDataArray.h"
+#include "vtkDataSet.h"
+#include "vtkElevationFilter.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPExtractHistogram.h"
+#include "vtkPointData.h"
+#include "vtkSphereSource.h"
+#include "vtkTable.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#define VERIFY(x, y)                                                                               \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    vtkLogF(ERROR, y);                                                                             \
+    return false;                                                                                  \
+  }
+
+namespace
+{
+constexpr int BinCount = 16;
+
+// Reference implementation: bins the given component of an array over its range.
+std::vector<int> ComputeReference(vtkDataArray* array, int component)
+{
+  double range[2];
+  array->GetRange(range, component);
+  const double delta = (range[1] - range[0]) / BinCount;
+  std::vector<int> bins(BinCount, 0);
+  for (vtkIdType cc = 0; cc < array->GetNumberOfTuples(); ++cc)
+  {
+    const double value = array->GetComponent(cc, component);
+    ++bins[std::min(static_cast<int>((value - range[0]) / delta), BinCount - 1)];
+  }
+  return bins;
+}
+
+bool CheckBins(vtkTable* table, const std::string& name, const std::vector<int>& expected)
+{
+  vtkDataArray* values = vtkDataArray::SafeDownCast(table->GetColumnByName(name.c_str()));
+  VERIFY(values != nullptr, "Missing bin values.");
+  VERIFY(values->GetNumberOfTuples() == BinCount, "Unexpected number of bins.");
+  for (int cc = 0; cc < BinCount; ++cc)
+  {
+    VERIFY(static_cast<int>(values->GetComponent(cc, 0)) == expected[cc], "Unexpected bin value.");
+  }
+  return true;
+}
+}
+
+extern int TestPExtractHistogram(int, char*[])
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(100);
+  sphere->SetPhiResolution(100);
+
+  vtkNew<vtkElevationFilter> elevation;
+  elevation->SetInputConnection(sphere->GetOutputPort());
+  elevation->SetLowPoint(0, 0, -1);
+  elevation->SetHighPoint(0, 0, 1);
+  elevation->Update();
+  vtkPointData* pointData = vtkDataSet::SafeDownCast(elevation->GetOutput())->GetPointData();
+
+  // Histograms of the selected array and of an additional array are computed
+  // in the same pass.
+  vtkNew<vtkPExtractHistogram> histogram;
+  histogram->SetInputConnection(elevation->GetOutputPort());
+  histogram->SetInputArrayToProcess(0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_POINTS, "Elevation");
+  histogram->SetBinCount(BinCount);
+  histogram->SetComponent(0);
+  histogram->AddAdditionalArray("Normals");
+  histogram->Update();
+
+  vtkTable* output = histogram->GetOutput();
+  if (!::CheckBins(output, "bin_values", ::ComputeReference(pointData->GetArray("Elevation"), 0)) ||
+    !::CheckBins(
+      output, "bin_values_Normals", ::ComputeReference(pointData->GetArray("Normals"), 0)))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // Clearing the additional arrays removes their columns.
+  histogram->ClearAdditionalArrays();
+  histogram->Update();
+  if (histogram->GetOutput()->GetColumnByName("bin_values_Normals") != nullptr)
+  {
+    vtkLogF(ERROR, "Additional array histogram was not removed.");
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -3,24 +3,185 @@
 // SPDX-License-Identifier: BSD-3-Clause
 #include "vtkPExtractHistogram.h"
 
+#include "vtkArrayDispatch.h"
 #include "vtkAttributeDataReductionFilter.h"
 #include "vtkCellData.h"
 #include "vtkCommunicator.h"
+#include "vtkCompositeDataSet.h"
+#include "vtkCompositeDataSetRange.h"
 #include "vtkDataArrayRange.h"
 #include "vtkDataSet.h"
 #include "vtkDoubleArray.h"
+#include "vtkFieldData.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
-#include "vtkIntArray.h"
 #include "vtkMultiProcessController.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkReductionFilter.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkTable.h"
+#include "vtkUnsignedCharArray.h"
 
+#include <algorithm>
+#include <cmath>
 #include <string>
+#include <vector>
 #include <vtksys/RegularExpression.hxx>
 
+namespace
+{
+// An array of a block to bin, along with the bins it contributes to.
+struct BlockArray
+{
+  vtkDataArray* Array;
+  int Component; // -1 for the magnitude
+  int Histogram; // index of the histogram in BinArraysFunctor::Bins
+};
+
+// Bins the values of a single array for a range of tuples.
+struct BinValuesWorker
+{
+  template <typename ArrayT>
+  void operator()(ArrayT* array, vtkIdType begin, vtkIdType end, int component,
+    const unsigned char* ghosts, unsigned char ghostsToSkip, double min, double max, int binCount,
+    vtkIdType* bins) const
+  {
+    const double binDelta = (max - min) / binCount;
+    const auto tuples = vtk::DataArrayTupleRange(array, begin, end);
+    const int numComps = static_cast<int>(tuples.GetTupleSize());
+    vtkIdType tupleId = begin;
+    for (const auto tuple : tuples)
+    {
+      const vtkIdType current = tupleId++;
+      if (ghosts && (ghosts[current] & ghostsToSkip))
+      {
+        continue;
+      }
+
+      double value;
+      if (component < 0)
+      {
+        value = 0.0;
+        for (int cc = 0; cc < numComps; ++cc)
+        {
+          const double compValue = static_cast<double>(tuple[cc]);
+          value += compValue * compValue;
+        }
+        value = std::sqrt(value);
+      }
+      else
+      {
+        value = static_cast<double>(tuple[component]);
+      }
+
+      // this also skips NaN values.
+      if (!(value >= min && value <= max))
+      {
+        continue;
+      }
+      // values equal to max go in the last bin.
+      const int index = std::min(static_cast<int>((value - min) / binDelta), binCount - 1);
+      ++bins[index];
+    }
+  }
+};
+
+// Bins several arrays of a block in a single pass, using per-thread bins.
+struct BinArraysFunctor
+{
+  const std::vector<BlockArray>& Arrays;
+  const std::vector<double>& Ranges; // min and max of each histogram
+  const unsigned char* Ghosts;
+  unsigned char GhostsToSkip;
+  int BinCount;
+  int NumberOfHistograms;
+  std::vector<vtkIdType>& Bins;
+  vtkSMPThreadLocal<std::vector<vtkIdType>> LocalBins;
+
+  BinArraysFunctor(const std::vector<BlockArray>& arrays, const std::vector<double>& ranges,
+    const unsigned char* ghosts, unsigned char ghostsToSkip, int binCount, int numberOfHistograms,
+    std::vector<vtkIdType>& bins)
+    : Arrays(arrays)
+    , Ranges(ranges)
+    , Ghosts(ghosts)
+    , GhostsToSkip(ghostsToSkip)
+    , BinCount(binCount)
+    , NumberOfHistograms(numberOfHistograms)
+    , Bins(bins)
+  {
+  }
+
+  void Initialize()
+  {
+    this->LocalBins.Local().assign(
+      static_cast<size_t>(this->NumberOfHistograms) * this->BinCount, 0);
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    auto& localBins = this->LocalBins.Local();
+    BinValuesWorker worker;
+    for (const auto& item : this->Arrays)
+    {
+      const double min = this->Ranges[2 * item.Histogram];
+      const double max = this->Ranges[2 * item.Histogram + 1];
+      vtkIdType* bins = localBins.data() + static_cast<size_t>(item.Histogram) * this->BinCount;
+      if (!vtkArrayDispatch::Dispatch::Execute(item.Array, worker, begin, end, item.Component,
+            this->Ghosts, this->GhostsToSkip, min, max, this->BinCount, bins))
+      {
+        worker(item.Array, begin, end, item.Component, this->Ghosts, this->GhostsToSkip, min, max,
+          this->BinCount, bins);
+      }
+    }
+  }
+
+  void Reduce()
+  {
+    for (const auto& localBins : this->LocalBins)
+    {
+      for (size_t cc = 0; cc < localBins.size(); ++cc)
+      {
+        this->Bins[cc] += localBins[cc];
+      }
+    }
+  }
+};
+
+// Returns the component to bin for an array, -1 being the magnitude. Single
+// component arrays always bin their signed value, never its absolute value.
+int GetComponentToBin(vtkDataArray* array, int component)
+{
+  const int numComps = array->GetNumberOfComponents();
+  if (component >= 0 && component < numComps)
+  {
+    return component;
+  }
+  return numComps > 1 ? -1 : 0;
+}
+
+// Returns the finite range of an array, using the range cached by the field
+// data when the array belongs to it since that cache also accounts for ghosts.
+void GetFiniteRange(vtkFieldData* fieldData, vtkDataArray* array, int component, double range[2])
+{
+  if (fieldData)
+  {
+    for (int idx = 0; idx < fieldData->GetNumberOfArrays(); ++idx)
+    {
+      if (fieldData->GetAbstractArray(idx) == array &&
+        fieldData->GetFiniteRange(idx, range, component))
+      {
+        return;
+      }
+    }
+  }
+  array->GetFiniteRange(range, component);
+}
+}
+
 vtkStandardNewMacro(vtkPExtractHistogram);
 vtkCxxSetObjectMacro(vtkPExtractHistogram, Controller, vtkMultiProcessController);
 //-----------------------------------------------------------------------------
@@ -36,6 +197,202 @@ vtkPExtractHistogram::~vtkPExtractHistogram()
   this->SetController(nullptr);
 }
 
+//-----------------------------------------------------------------------------
+void vtkPExtractHistogram::AddAdditionalArray(const char* name)
+{
+  if (name)
+  {
+    this->AdditionalArrays.emplace_back(name);
+    this->Modified();
+  }
+}
+
+//-----------------------------------------------------------------------------
+void vtkPExtractHistogram::ClearAdditionalArrays()
+{
+  if (!this->AdditionalArrays.empty())
+  {
+    this->AdditionalArrays.clear();
+    this->Modified();
+  }
+}
+
+//-----------------------------------------------------------------------------
+bool vtkPExtractHistogram::ComputeHistograms(vtkDataObject* input, vtkTable* output)
+{
+  std::vector<vtkDataObject*> leaves;
+  if (auto cd = vtkCompositeDataSet::SafeDownCast(input))
+  {
+    using Opts = vtk::CompositeDataSetOptions;
+    for (vtkDataObject* leaf : vtk::Range(cd, Opts::SkipEmptyNodes))
+    {
+      leaves.push_back(leaf);
+    }
+  }
+  else if (input)
+  {
+    leaves.push_back(input);
+  }
+
+  // Histogram 0 is the array to process, followed by the additional arrays.
+  const int numberOfHistograms = 1 + static_cast<int>(this->AdditionalArrays.size());
+  struct LeafArrays
+  {
+    std::vector<BlockArray> Arrays;
+    vtkUnsignedCharArray* Ghosts = nullptr;
+    unsigned char GhostsToSkip = 0;
+    vtkIdType NumberOfTuples = 0;
+  };
+  std::vector<LeafArrays> leafArrays(leaves.size());
+  std::vector<double> localRanges(2 * numberOfHistograms);
+  for (int cc = 0; cc < numberOfHistograms; ++cc)
+  {
+    localRanges[2 * cc] = VTK_DOUBLE_MAX;
+    localRanges[2 * cc + 1] = -VTK_DOUBLE_MAX;
+  }
+
+  bool hasArray = false;
+  for (size_t leafIdx = 0; leafIdx < leaves.size(); ++leafIdx)
+  {
+    int association;
+    vtkDataArray* array = this->GetInputArrayToProcess(0, leaves[leafIdx], association);
+    if (!array)
+    {
+      continue;
+    }
+    hasArray = true;
+
+    auto& current = leafArrays[leafIdx];
+    current.NumberOfTuples = array->GetNumberOfTuples();
+    vtkFieldData* fieldData = leaves[leafIdx]->GetAttributesAsFieldData(association);
+    if (fieldData)
+    {
+      current.Ghosts = fieldData->GetGhostArray();
+      current.GhostsToSkip = fieldData->GetGhostsToSkip();
+    }
+
+    for (int cc = 0; cc < numberOfHistograms; ++cc)
+    {
+      vtkDataArray* cur = array;
+      if (cc > 0)
+      {
+        cur = fieldData ? fieldData->GetArray(this->AdditionalArrays[cc - 1].c_str()) : nullptr;
+        if (!cur || cur->GetNumberOfTuples() != current.NumberOfTuples)
+        {
+          continue;
+        }
+      }
+      const int component = ::GetComponentToBin(cur, this->Component);
+      current.Arrays.push_back(BlockArray{ cur, component, cc });
+
+      double range[2];
+      ::GetFiniteRange(fieldData, cur, component, range);
+      localRanges[2 * cc] = std::min(localRanges[2 * cc], range[0]);
+      localRanges[2 * cc + 1] = std::max(localRanges[2 * cc + 1], range[1]);
+    }
+  }
+
+  std::vector<double> ranges(localRanges);
+  int globalHasArray = hasArray ? 1 : 0;
+  if (this->Controller && this->Controller->GetNumberOfProcesses() > 1)
+  {
+    int localHasArray = globalHasArray;
+    std::vector<double> localMin(numberOfHistograms);
+    std::vector<double> localMax(numberOfHistograms);
+    for (int cc = 0; cc < numberOfHistograms; ++cc)
+    {
+      localMin[cc] = localRanges[2 * cc];
+      localMax[cc] = localRanges[2 * cc + 1];
+    }
+    std::vector<double> globalMin(numberOfHistograms);
+    std::vector<double> globalMax(numberOfHistograms);
+    if (!this->Controller->AllReduce(&localHasArray, &globalHasArray, 1, vtkCommunicator::MAX_OP) ||
+      !this->Controller->AllReduce(
+        localMin.data(), globalMin.data(), numberOfHistograms, vtkCommunicator::MIN_OP) ||
+      !this->Controller->AllReduce(
+        localMax.data(), globalMax.data(), numberOfHistograms, vtkCommunicator::MAX_OP))
+    {
+      vtkErrorMacro("Parallel communication error. Could not reduce ranges.");
+      return false;
+    }
+    for (int cc = 0; cc < numberOfHistograms; ++cc)
+    {
+      ranges[2 * cc] = globalMin[cc];
+      ranges[2 * cc + 1] = globalMax[cc];
+    }
+  }
+  if (!globalHasArray)
+  {
+    // nothing to do, as done by the superclass when there is no array.
+    return true;
+  }
+
+  if (this->UseCustomBinRanges)
+  {
+    ranges[0] = this->CustomBinRanges[0];
+    ranges[1] = this->CustomBinRanges[1];
+  }
+  for (int cc = 0; cc < numberOfHistograms; ++cc)
+  {
+    double& min = ranges[2 * cc];
+    double& max = ranges[2 * cc + 1];
+    if (min > max)
+    {
+      // no finite values.
+      min = 0.0;
+      max = 1.0;
+    }
+    else if (min == max)
+    {
+      max = min + 1.0;
+    }
+    const bool customRange = cc == 0 && this->UseCustomBinRanges;
+    if (this->CenterBinsAroundMinAndMax && !customRange && this->BinCount > 1)
+    {
+      const double halfDelta = 0.5 * (max - min) / (this->BinCount - 1);
+      min -= halfDelta;
+      max += halfDelta;
+    }
+  }
+
+  std::vector<vtkIdType> bins(static_cast<size_t>(numberOfHistograms) * this->BinCount, 0);
+  for (const auto& current : leafArrays)
+  {
+    if (current.Arrays.empty())
+    {
+      continue;
+    }
+    BinArraysFunctor functor(current.Arrays, ranges,
+      current.Ghosts ? current.Ghosts->GetPointer(0) : nullptr, current.GhostsToSkip,
+      this->BinCount, numberOfHistograms, bins);
+    vtkSMPTools::For(0, current.NumberOfTuples, functor);
+  }
+
+  for (int cc = 0; cc < numberOfHistograms; ++cc)
+  {
+    const std::string suffix = cc == 0 ? "" : "_" + this->AdditionalArrays[cc - 1];
+    const double min = ranges[2 * cc];
+    const double binDelta = (ranges[2 * cc + 1] - min) / this->BinCount;
+
+    // These are the mid-points of each bin.
+    vtkNew<vtkDoubleArray> binExtents;
+    binExtents->SetName((std::string(this->BinExtentsArrayName) + suffix).c_str());
+    binExtents->SetNumberOfTuples(this->BinCount);
+    // Counts are kept as vtkIdType so that large inputs cannot overflow them.
+    vtkNew<vtkIdTypeArray> binValues;
+    binValues->SetName((std::string(this->BinValuesArrayName) + suffix).c_str());
+    binValues->SetNumberOfTuples(this->BinCount);
+    for (int bin = 0; bin < this->BinCount; ++bin)
+    {
+      binExtents->SetValue(bin, min + (bin + 0.5) * binDelta);
+      binValues->SetValue(bin, bins[static_cast<size_t>(cc) * this->BinCount + bin]);
+    }
+    output->GetRowData()->AddArray(binExtents);
+    output->GetRowData()->AddArray(binValues);
+  }
+  return true;
+}
+
 //-----------------------------------------------------------------------------
 bool vtkPExtractHistogram::GetInputArrayRange(vtkInformationVector** inputVector, double range[2])
 {
@@ -72,7 +429,18 @@ int vtkPExtractHistogram::RequestData(
   bool tempAccumulation = this->Accumulation;
   this->Accumulation = false;
 
-  int superRequestData = this->Superclass::RequestData(request, inputVector, outputVector);
+  // The averages are only computed by the superclass, otherwise all the
+  // histograms are computed in a single threaded pass over the input.
+  int superRequestData = 0;
+  if (this->CalculateAverages)
+  {
+    superRequestData = this->Superclass::RequestData(request, inputVector, outputVector);
+  }
+  else if (this->ComputeHistograms(
+             vtkDataObject::GetData(inputVector[0], 0), vtkTable::GetData(outputVector, 0)))
+  {
+    superRequestData = 1;
+  }
 
   this->Normalize = tempNormalize;
   this->Accumulation = tempAccumulation;
@@ -95,6 +463,15 @@ int vtkPExtractHistogram::RequestData(
       // Nothing to do if there is no data
       return 1;
     }
+    std::vector<vtkSmartPointer<vtkDataArray>> oldAdditionalExtents;
+    for (const auto& name : this->AdditionalArrays)
+    {
+      const std::string extentsName = std::string(this->BinExtentsArrayName) + "_" + name;
+      if (auto extents = output->GetRowData()->GetArray(extentsName.c_str()))
+      {
+        oldAdditionalExtents.emplace_back(extents);
+      }
+    }
     // Now we need to collect and reduce data from all nodes on the root.
     vtkSmartPointer<vtkReductionFilter> reduceFilter = vtkSmartPointer<vtkReductionFilter>::New();
     reduceFilter->SetController(this->Controller);
@@ -124,6 +501,13 @@ int vtkPExtractHistogram::RequestData(
         return 0;
       }
       output->GetRowData()->GetArray(this->BinExtentsArrayName)->DeepCopy(oldExtents);
+      for (const auto& extents : oldAdditionalExtents)
+      {
+        if (auto reduced = output->GetRowData()->GetArray(extents->GetName()))
+        {
+          reduced->DeepCopy(extents);
+        }
+      }
       if (this->CalculateAverages)
       {
         vtkDataArray* bin_values = output->GetRowData()->GetArray(this->BinValuesArrayName);
@@ -175,4 +559,10 @@ void vtkPExtractHistogram::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
   os << indent << "Controller: " << this->Controller << endl;
+  os << indent << "AdditionalArrays:";
+  for (const auto& name : this->AdditionalArrays)
+  {
+    os << " " << name;
+  }
+  os << endl;
 }
@@ -7,6 +7,14 @@
  *
  * vtkPExtractHistogram is vtkExtractHistogram subclass for parallel datasets.
  * It gathers the histogram data on the root node.
+ *
+ * Unless CalculateAverages is enabled, the histogram is computed in a single
+ * pass over each block using vtkSMPTools, with per-thread histograms that are
+ * summed afterwards. The range of each array is the finite range cached by the
+ * field data (the same one vtkPVArrayInformation reports), so no extra pass
+ * over the data is needed to compute it once the data information has been
+ * gathered. Histograms of additional arrays can be computed in the same pass,
+ * see AddAdditionalArray().
  */
 
 #ifndef vtkPExtractHistogram_h
@@ -15,7 +23,12 @@
 #include "vtkExtractHistogram.h"
 #include "vtkPVVTKExtensionsMiscModule.h" //needed for exports
 
+#include <string> // for std::string
+#include <vector> // for std::vector
+
+class vtkDataObject;
 class vtkMultiProcessController;
+class vtkTable;
 
 class VTKPVVTKEXTENSIONSMISC_EXPORT vtkPExtractHistogram : public vtkExtractHistogram
 {
@@ -33,6 +46,23 @@ public:
   vtkGetObjectMacro(Controller, vtkMultiProcessController);
   ///@}
 
+  ///@{
+  /**
+   * Add/clear additional arrays to compute histograms for, in the same pass
+   * over the data as the array to process. Additional arrays are looked up
+   * with the association of the array to process and use their full range,
+   * BinCount and Component, or their magnitude if Component is not valid for
+   * them. Single component arrays are always binned by their signed value,
+   * never by its absolute value, whatever Component is. Their bins are added
+   * to the output as `<BinExtentsArrayName>_<name>` and
+   * `<BinValuesArrayName>_<name>` columns, the latter being a vtkIdTypeArray
+   * so that counts of large inputs do not overflow. Ignored when
+   * CalculateAverages is true.
+   */
+  void AddAdditionalArray(const char* name);
+  void ClearAdditionalArrays();
+  ///@}
+
 protected:
   vtkPExtractHistogram();
   ~vtkPExtractHistogram() override;
@@ -46,7 +76,15 @@ protected:
   int RequestData(vtkInformation* request, vtkInformationVector** inputVector,
     vtkInformationVector* outputVector) override;
 
+  /**
+   * Fills `output` with the bins of the array to process and of the additional
+   * arrays for the local data, computed in a single threaded pass over each
+   * block. Ranges are reduced across processes.
+   */
+  bool ComputeHistograms(vtkDataObject* input, vtkTable* output);
+
   vtkMultiProcessController* Controller;
+  std::vector<std::string> AdditionalArrays;
 
 private:
   vtkPExtractHistogram(const vtkPExtractHistogram&) = delete;
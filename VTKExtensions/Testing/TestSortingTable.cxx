@@ -13,6 +13,7 @@
 #include "vtkTestUtilities.h"
 #include "vtkUnsignedCharArray.h"
 
+#include <algorithm>
 #include <cfloat>
 #include <iostream>
 
@@ -155,6 +156,76 @@ int sortMagnitudeOnUnsignedCharVector()
   return EXIT_SUCCESS;
 }
 
+// ----------------------------------------------------------------------------
+// Page through a table sorted on alternating columns, modifying the data in
+// between, to check that the sort indices kept by the filter stay up to date.
+int sortPagesReusingIndices(bool debug)
+{
+  const int size = 20;
+  const int blockSize = 6;
+  double aValues[size];
+  double bValues[size];
+  double aSorted[size];
+  double bSorted[size];
+  for (int i = 0; i < size; i++)
+  {
+    aValues[i] = size - i;
+    bValues[i] = (i * 7) % size;
+    aSorted[i] = i + 1;
+    bSorted[i] = i;
+  }
+
+  vtkSmartPointer<vtkDoubleArray> a = vtkSmartPointer<vtkDoubleArray>::New();
+  fillArray(a.GetPointer(), aValues, size, "a");
+  vtkSmartPointer<vtkDoubleArray> b = vtkSmartPointer<vtkDoubleArray>::New();
+  fillArray(b.GetPointer(), bValues, size, "b");
+
+  vtkSmartPointer<vtkTable> input = vtkSmartPointer<vtkTable>::New();
+  input->AddColumn(a);
+  input->AddColumn(b);
+
+  vtkSmartPointer<vtkSortedTableStreamer> sortingfilter =
+    vtkSmartPointer<vtkSortedTableStreamer>::New();
+  sortingfilter->SetInputData(input.GetPointer());
+  sortingfilter->SetSelectedComponent(0);
+  sortingfilter->SetBlockSize(blockSize);
+
+  auto checkPages = [&](const char* name, double* expected) {
+    sortingfilter->SetColumnNameToSort(name);
+    for (int block = 0; block * blockSize < size; block++)
+    {
+      sortingfilter->SetBlock(block);
+      sortingfilter->Update();
+      const int count = std::min(blockSize, size - block * blockSize);
+      if (!compareArray(
+            sortingfilter->GetOutput(), name, expected + block * blockSize, count, debug))
+      {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  if (!checkPages("a", aSorted) || !checkPages("b", bSorted) || !checkPages("a", aSorted))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // Modifying the sorted array must not reuse the previous index.
+  for (int i = 0; i < size; i++)
+  {
+    a->SetValue(i, -aValues[i]);
+    aSorted[i] = -size + i;
+  }
+  a->Modified();
+  if (!checkPages("a", aSorted) || !checkPages("b", bSorted))
+  {
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
 // ----------------------------------------------------------------------------
 int TestSortingTable(int vtkNotUsed(argc), char** vtkNotUsed(argv))
 {
@@ -174,6 +245,9 @@ int TestSortingTable(int vtkNotUsed(argc), char** vtkNotUsed(argv))
   std::cout << "Testing sorting with magnitude on unsigned char: "
             << ((result += sortMagnitudeOnUnsignedCharVector()) ? "FAILED" : "SUCCESS") << endl;
   // --------------------------------------------------------------------------
+  std::cout << "Testing paging with sort index reuse: "
+            << ((result += sortPagesReusingIndices(debug)) ? "FAILED" : "SUCCESS") << endl;
+  // --------------------------------------------------------------------------
   // --------------------------------------------------------------------------
 
   // Delete Fake MPI controller
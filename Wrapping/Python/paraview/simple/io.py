@@ -309,7 +309,12 @@ def SaveData(filename, proxy=None, **extraArgs):
     :param proxy: Proxy to save. Optional, defaults to saving the active source.
     :type proxy: Source proxy.
     :param extraArgs: A variadic list of `key=value` pairs giving values of
-        specific named properties in the writer."""
+        specific named properties in the writer.
+
+    When `pvbatch` splits the ranks into independent groups with `--rank-groups`,
+    every group runs the script, hence only the first group saves the data."""
+    if servermanager.vtkProcessModule.GetRankGroupId() != 0:
+        return
     writer = CreateWriter(filename, proxy, **extraArgs)
     if not writer:
         raise RuntimeError("Could not create writer for specified file or data type")